@@ -0,0 +1,1252 @@
+#ifndef MOPER_STL_BTREE_H
+#define MOPER_STL_BTREE_H
+
+// B btree_set / btree_map ĵײ
+// ÿڵŶԪأʱÿֻһڵ㣬ȺٵöĻδУ
+// ҲҪΪÿԪرָɫ
+// ڵСģ NodeBytes ָȱʡΪ BTREE_NODE_BYTESɰҪȡ 256 ֽڡ4 KB 
+// ֵΪͻָұȽϷʽΪ less / greater ʱڵڵļֵţ
+// ڵڲʹ޷֧ļɨ裬ɱ
+// ע⣺ɾƶͬһڵ㼰ڽڵڵԪأеʧЧ
+
+#include <initializer_list>
+#include <cstdint>
+
+#include "iterator.h"
+#include "memory.h"
+#include "utility.h"
+#include "type_traits.h"
+#include "functional.h"
+#include "exceptdef.h"
+#include "__rb_tree.h"
+
+namespace MoperSTL {
+
+// ȱʡĽڵСֽڣ
+#ifndef BTREE_NODE_BYTES
+#define BTREE_NODE_BYTES 256
+#endif
+
+template <class Traits> struct btree_node;
+template <class Traits> struct btree_internal_node;
+
+// btree traits
+
+template <class T, class Compare, std::size_t NodeBytes>
+struct btree_traits {
+    typedef rb_tree_value_traits<T>            value_traits;
+    typedef typename value_traits::key_type    key_type;
+    typedef typename value_traits::mapped_type mapped_type;
+    typedef typename value_traits::value_type  value_type;
+    typedef Compare                            key_compare;
+
+    static constexpr bool is_map = value_traits::is_map;
+
+    static constexpr bool small_key =
+        std::is_arithmetic<key_type>::value || std::is_pointer<key_type>::value;
+
+    // map ļֵСʱڽڵһļֵ鹩ʹ
+    static constexpr bool separate_keys = is_map && small_key;
+
+    // ڵǷʹüʽԲ
+    static constexpr bool linear_search = small_key &&
+        (std::is_same<Compare, MoperSTL::less<key_type>>::value ||
+         std::is_same<Compare, MoperSTL::greater<key_type>>::value);
+
+    // ÿԪڽڵռֽ
+    static constexpr std::size_t slot_size =
+        sizeof(value_type) + (separate_keys ? sizeof(key_type) : 0);
+
+    // ڵͷָ롢ԪظڸڵеλáǷΪҶڵ㣩ռֽ
+    static constexpr std::size_t header_size = sizeof(void*) + 2 * sizeof(std::uint32_t) + sizeof(void*);
+
+    // ÿڵŵԪظΪ 3
+    static constexpr std::size_t node_values =
+        NodeBytes > header_size + 3 * slot_size ? (NodeBytes - header_size) / slot_size : 3;
+
+    typedef btree_node<btree_traits>*          node_ptr;
+    typedef btree_internal_node<btree_traits>* internal_ptr;
+};
+
+// ڵļֵ飬ҪʱΪ
+template <class Key, std::size_t N, bool>
+struct btree_key_storage {
+};
+
+template <class Key, std::size_t N>
+struct btree_key_storage<Key, N, true> {
+    Key keys_[N];
+};
+
+// btree ĽڵƣҶڵֻԪأڲڵ׷ N + 1 ӽڵָ
+
+template <class Traits>
+struct btree_node : public btree_key_storage<typename Traits::key_type,
+                                             Traits::node_values, Traits::separate_keys> {
+    typedef typename Traits::key_type     key_type;
+    typedef typename Traits::value_type   value_type;
+    typedef typename Traits::value_traits value_traits;
+    typedef typename Traits::node_ptr     node_ptr;
+    typedef typename Traits::internal_ptr internal_ptr;
+
+    static constexpr std::size_t N = Traits::node_values;
+
+    internal_ptr  parent;    // ڵ㣬ڵΪ
+    std::uint32_t count;     // Ԫظ
+    std::uint32_t position;  // ڸڵеӽڵ±
+    bool          leaf;      // ǷΪҶڵ
+
+    alignas(value_type) unsigned char values_[sizeof(value_type) * N];
+
+    value_type* values() {
+        return reinterpret_cast<value_type*>(values_);
+    }
+    value_type& value(std::size_t i) {
+        return values()[i];
+    }
+
+    const key_type& key(std::size_t i) {
+        if constexpr (Traits::separate_keys)
+            return this->keys_[i];
+        else
+            return value_traits::get_key(values()[i]);
+    }
+
+    // ļֵ飬 linear_search ʱʹ
+    const key_type* keys() {
+        if constexpr (Traits::separate_keys)
+            return this->keys_;
+        else
+            return reinterpret_cast<const key_type*>(values_);
+    }
+
+    internal_ptr as_internal() {
+        return static_cast<internal_ptr>(this);
+    }
+    node_ptr child(std::size_t i) {
+        return as_internal()->children[i];
+    }
+};
+
+template <class Traits>
+struct btree_internal_node : public btree_node<Traits> {
+    typename Traits::node_ptr children[Traits::node_values + 1];
+};
+
+// btree ĵƣԣڵ㣬ڵ±꣩ʾλãend() ΪҶڵ㣬Ԫظ
+template <class Traits, class Ref, class Ptr>
+struct btree_iterator : public MoperSTL::iterator<MoperSTL::bidirectional_iterator_tag,
+                                                  typename Traits::value_type> {
+    typedef btree_iterator<Traits, typename Traits::value_type&, typename Traits::value_type*> iterator;
+    typedef btree_iterator                  self;
+
+    typedef typename Traits::value_type     value_type;
+    typedef Ptr                             pointer;
+    typedef Ref                             reference;
+    typedef typename Traits::node_ptr       node_ptr;
+    typedef std::size_t                     size_type;
+
+    node_ptr  node;      // ǰڵ
+    size_type position;  // ڵڵ±
+
+    btree_iterator() noexcept :node(nullptr), position(0) {}
+    btree_iterator(node_ptr n, size_type p) noexcept :node(n), position(p) {}
+    btree_iterator(const iterator& rhs) noexcept :node(rhs.node), position(rhs.position) {}
+
+    reference operator*()  const { return node->value(position); }
+    pointer   operator->() const { return &(operator*()); }
+
+    // ʹǰҶڵֱӺƣĩβϻݣڲڵҶڵ
+    void inc() {
+        if (node->leaf) {
+            if (++position < node->count)
+                return;
+            auto save_node = node;
+            auto save_pos = position;
+            while (position == node->count && node->parent != nullptr) {
+                position = node->position;
+                node = node->parent;
+            }
+            if (position == node->count) {  // һԪأͣ end()
+                node = save_node;
+                position = save_pos;
+            }
+        } else {
+            node = node->child(position + 1);
+            while (!node->leaf)
+                node = node->child(0);
+            position = 0;
+        }
+    }
+
+    // ʹ
+    void dec() {
+        if (node->leaf) {
+            if (position > 0) {
+                --position;
+                return;
+            }
+            while (position == 0 && node->parent != nullptr) {
+                position = node->position;
+                node = node->parent;
+            }
+            MYSTL_DEBUG(position != 0);
+            --position;
+        } else {
+            node = node->child(position);
+            while (!node->leaf)
+                node = node->child(node->count);
+            position = node->count - 1;
+        }
+    }
+
+    self& operator++() { inc(); return *this; }
+    self operator++(int) {
+        self tmp(*this);
+        inc();
+        return tmp;
+    }
+    self& operator--() { dec(); return *this; }
+    self operator--(int) {
+        self tmp(*this);
+        dec();
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node == rhs.node && position == rhs.position; }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+// ģ btree
+// һֵͣȽͣڵСֽڣ
+template <class T, class Compare, std::size_t NodeBytes = BTREE_NODE_BYTES>
+class btree {
+public:
+    // btree Ƕͱ
+
+    typedef btree_traits<T, Compare, NodeBytes>      tree_traits;
+    typedef typename tree_traits::value_traits       value_traits;
+
+    typedef btree_node<tree_traits>                  node_type;
+    typedef btree_internal_node<tree_traits>         internal_type;
+    typedef typename tree_traits::node_ptr           node_ptr;
+    typedef typename tree_traits::internal_ptr       internal_ptr;
+    typedef typename tree_traits::key_type           key_type;
+    typedef typename tree_traits::mapped_type        mapped_type;
+    typedef typename tree_traits::value_type         value_type;
+    typedef Compare                                  key_compare;
+
+    typedef MoperSTL::allocator<T>                   allocator_type;
+    typedef MoperSTL::allocator<T>                   data_allocator;
+    typedef MoperSTL::allocator<node_type>           leaf_allocator;
+    typedef MoperSTL::allocator<internal_type>       internal_allocator;
+
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::size_type       size_type;
+    typedef typename allocator_type::difference_type difference_type;
+
+    typedef btree_iterator<tree_traits, T&, T*>             iterator;
+    typedef btree_iterator<tree_traits, const T&, const T*> const_iterator;
+    typedef MoperSTL::reverse_iterator<iterator>            reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>      const_reverse_iterator;
+
+    static constexpr size_type node_values = tree_traits::node_values;  // ÿڵԪظ
+    static constexpr size_type min_values  = node_values / 2;           // ǸڵɾٱԪظ
+
+    allocator_type get_allocator() const { return allocator_type(); }
+    key_compare    key_comp()      const { return key_comp_; }
+
+private:
+    node_ptr    root_;        // ڵ㣬ʱΪ
+    node_ptr    leftmost_;    // Ҷڵ
+    node_ptr    rightmost_;   // Ҷڵ
+    size_type   size_;        // Ԫظ
+    key_compare key_comp_;    // ڵֵȽϵ׼
+
+public:
+    // 졢ơ
+    btree() :root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), key_comp_() {}
+
+    btree(const btree& rhs);
+    btree(btree&& rhs) noexcept;
+
+    btree& operator=(const btree& rhs);
+    btree& operator=(btree&& rhs);
+
+    ~btree() { clear(); }
+
+public:
+    // ز
+
+    iterator               begin()         noexcept {
+        return iterator(leftmost_, 0);
+    }
+    const_iterator         begin()   const noexcept {
+        return const_iterator(leftmost_, 0);
+    }
+    iterator               end()           noexcept {
+        return iterator(rightmost_, rightmost_ == nullptr ? 0 : rightmost_->count);
+    }
+    const_iterator         end()     const noexcept {
+        return const_iterator(rightmost_, rightmost_ == nullptr ? 0 : rightmost_->count);
+    }
+
+    reverse_iterator       rbegin()        noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin()  const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator       rend()          noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend()    const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator         cbegin()  const noexcept {
+        return begin();
+    }
+    const_iterator         cend()    const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend()   const noexcept {
+        return rend();
+    }
+
+    // ز
+
+    bool      empty()    const noexcept { return size_ == 0; }
+    size_type size()     const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+    // ɾز
+
+    // emplace
+
+    template <class ...Args>
+    iterator  emplace_multi(Args&& ...args) {
+        return insert_multi(value_type(MoperSTL::forward<Args>(args)...));
+    }
+
+    template <class ...Args>
+    MoperSTL::pair<iterator, bool> emplace_unique(Args&& ...args) {
+        return insert_unique(value_type(MoperSTL::forward<Args>(args)...));
+    }
+
+    template <class ...Args>
+    iterator  emplace_multi_use_hint(const_iterator hint, Args&& ...args) {
+        return insert_multi(hint, value_type(MoperSTL::forward<Args>(args)...));
+    }
+
+    template <class ...Args>
+    iterator  emplace_unique_use_hint(const_iterator hint, Args&& ...args) {
+        return insert_unique(hint, value_type(MoperSTL::forward<Args>(args)...));
+    }
+
+    // insert
+
+    iterator  insert_multi(const value_type& value) {
+        return insert_multi_value(value);
+    }
+    iterator  insert_multi(value_type&& value) {
+        return insert_multi_value(MoperSTL::move(value));
+    }
+
+    iterator  insert_multi(const_iterator hint, const value_type& value) {
+        return insert_multi_hint_value(hint, value);
+    }
+    iterator  insert_multi(const_iterator hint, value_type&& value) {
+        return insert_multi_hint_value(hint, MoperSTL::move(value));
+    }
+
+    template <class InputIterator>
+    void      insert_multi(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_multi(end(), *first);
+    }
+
+    MoperSTL::pair<iterator, bool> insert_unique(const value_type& value) {
+        return insert_unique_value(value);
+    }
+    MoperSTL::pair<iterator, bool> insert_unique(value_type&& value) {
+        return insert_unique_value(MoperSTL::move(value));
+    }
+
+    iterator  insert_unique(const_iterator hint, const value_type& value) {
+        return insert_unique_hint_value(hint, value);
+    }
+    iterator  insert_unique(const_iterator hint, value_type&& value) {
+        return insert_unique_hint_value(hint, MoperSTL::move(value));
+    }
+
+    template <class InputIterator>
+    void      insert_unique(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_unique(end(), *first);
+    }
+
+    // erase
+
+    iterator  erase(const_iterator pos);
+
+    size_type erase_multi(const key_type& key);
+    size_type erase_unique(const key_type& key);
+
+    iterator  erase(const_iterator first, const_iterator last);
+
+    void      clear();
+
+    // btree ز
+
+    iterator       find(const key_type& key) {
+        iterator it = lower_bound(key);
+        return (it == end() || key_comp_(key, key_of(it))) ? end() : it;
+    }
+    const_iterator find(const key_type& key) const {
+        const_iterator it = lower_bound(key);
+        return (it == end() || key_comp_(key, key_of(it))) ? end() : it;
+    }
+
+    size_type      count_multi(const key_type& key) const {
+        auto p = equal_range_multi(key);
+        return static_cast<size_type>(MoperSTL::distance(p.first, p.second));
+    }
+    size_type      count_unique(const key_type& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    iterator       lower_bound(const key_type& key) {
+        return bound_since(key, false);
+    }
+    const_iterator lower_bound(const key_type& key) const {
+        return const_cast<btree*>(this)->bound_since(key, false);
+    }
+
+    iterator       upper_bound(const key_type& key) {
+        return bound_since(key, true);
+    }
+    const_iterator upper_bound(const key_type& key) const {
+        return const_cast<btree*>(this)->bound_since(key, true);
+    }
+
+    MoperSTL::pair<iterator, iterator>
+        equal_range_multi(const key_type& key) {
+        return MoperSTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+    MoperSTL::pair<const_iterator, const_iterator>
+        equal_range_multi(const key_type& key) const {
+        return MoperSTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    MoperSTL::pair<iterator, iterator>
+        equal_range_unique(const key_type& key) {
+        iterator it = find(key);
+        auto next = it;
+        return it == end() ? MoperSTL::make_pair(it, it) : MoperSTL::make_pair(it, ++next);
+    }
+    MoperSTL::pair<const_iterator, const_iterator>
+        equal_range_unique(const key_type& key) const {
+        const_iterator it = find(key);
+        auto next = it;
+        return it == end() ? MoperSTL::make_pair(it, it) : MoperSTL::make_pair(it, ++next);
+    }
+
+    void swap(btree& rhs) noexcept;
+
+private:
+    // helper functions
+
+    template <class Iter>
+    static const key_type& key_of(const Iter& it) {
+        return it.node->key(it.position);
+    }
+
+    // node related
+    node_ptr create_leaf();
+    node_ptr create_internal();
+    void     destroy_node(node_ptr x) noexcept;
+    void     erase_since(node_ptr x) noexcept;
+    node_ptr copy_from(node_ptr x, internal_ptr p);
+    void     update_edges() noexcept;
+
+    // slot related
+    template <class V>
+    static void construct_slot(node_ptr x, size_type i, V&& value);
+    static void relocate_slot(node_ptr dst, size_type i, node_ptr src, size_type j);
+    static void destroy_slot(node_ptr x, size_type i) noexcept;
+    static void set_child(node_ptr x, size_type i, node_ptr c) noexcept;
+
+    // search
+    size_type lower_in_node(node_ptr x, const key_type& key) const;
+    size_type upper_in_node(node_ptr x, const key_type& key) const;
+    iterator  bound_since(const key_type& key, bool upper);
+
+    // insert
+    template <class V>
+    MoperSTL::pair<iterator, bool> insert_unique_value(V&& value);
+    template <class V>
+    iterator  insert_multi_value(V&& value);
+    template <class V>
+    iterator  insert_unique_hint_value(const_iterator hint, V&& value);
+    template <class V>
+    iterator  insert_multi_hint_value(const_iterator hint, V&& value);
+    template <class V>
+    iterator  insert_before(const_iterator pos, V&& value);
+    template <class V>
+    iterator  insert_at_leaf(node_ptr x, size_type pos, V&& value);
+    template <class V>
+    void      insert_in_node(node_ptr x, size_type pos, V&& value);
+    size_type split(node_ptr x, size_type pos);
+
+    // erase
+    iterator  rebalance_after_erase(iterator res);
+    void      merge_nodes(node_ptr left, node_ptr right, iterator& res);
+    void      rotate_left(node_ptr left, node_ptr right, size_type k, iterator& res);
+    void      rotate_right(node_ptr left, node_ptr right, size_type k, iterator& res);
+};
+
+/*****************************************************************************************/
+
+// ƹ캯
+template <class T, class Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>::
+btree(const btree& rhs)
+    :root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), key_comp_(rhs.key_comp_) {
+    if (rhs.root_ != nullptr) {
+        root_ = copy_from(rhs.root_, nullptr);
+        size_ = rhs.size_;
+        update_edges();
+    }
+}
+
+// ƶ캯
+template <class T, class Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>::
+btree(btree&& rhs) noexcept
+    :root_(rhs.root_), leftmost_(rhs.leftmost_), rightmost_(rhs.rightmost_),
+    size_(rhs.size_), key_comp_(rhs.key_comp_) {
+    rhs.root_ = rhs.leftmost_ = rhs.rightmost_ = nullptr;
+    rhs.size_ = 0;
+}
+
+// Ƹֵ
+template <class T, class Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>&
+btree<T, Compare, NodeBytes>::
+operator=(const btree& rhs) {
+    if (this != &rhs) {
+        btree tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+// ƶֵ
+template <class T, class Compare, std::size_t NodeBytes>
+btree<T, Compare, NodeBytes>&
+btree<T, Compare, NodeBytes>::
+operator=(btree&& rhs) {
+    if (this != &rhs) {
+        clear();
+        swap(rhs);
+    }
+    return *this;
+}
+
+// ɾ pos ԪأһԪصλ
+// ڲڵеԪǰҶڵĩβ滻ٴҶڵɾǰڵλ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+erase(const_iterator pos) {
+    MYSTL_DEBUG(pos != end());
+    node_ptr x = pos.node;
+    size_type i = pos.position;
+    const bool internal_delete = !x->leaf;
+    if (internal_delete) {
+        iterator pred(pos.node, pos.position);
+        --pred;
+        destroy_slot(x, i);
+        relocate_slot(x, i, pred.node, pred.position);
+        x = pred.node;
+        i = pred.position;
+    } else {
+        destroy_slot(x, i);
+        for (size_type j = i + 1; j < x->count; ++j)
+            relocate_slot(x, j - 1, x, j);
+    }
+    --x->count;
+    --size_;
+    iterator res = rebalance_after_erase(iterator(x, i));
+    if (internal_delete)
+        ++res;
+    return res;
+}
+
+// ɾֵΪ key Ԫأɾĸ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::size_type
+btree<T, Compare, NodeBytes>::
+erase_multi(const key_type& key) {
+    auto p = equal_range_multi(key);
+    size_type n = MoperSTL::distance(p.first, p.second);
+    erase(p.first, p.second);
+    return n;
+}
+
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::size_type
+btree<T, Compare, NodeBytes>::
+erase_unique(const key_type& key) {
+    auto it = find(key);
+    if (it != end()) {
+        erase(it);
+        return 1;
+    }
+    return 0;
+}
+
+// ɾ [first, last) ڵԪأÿɾƶԪأ˰ɾ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+erase(const_iterator first, const_iterator last) {
+    if (first == begin() && last == end()) {
+        clear();
+        return end();
+    }
+    iterator it(first.node, first.position);
+    for (size_type n = MoperSTL::distance(first, last); n > 0; --n)
+        it = erase(it);
+    return it;
+}
+
+//  btree
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+clear() {
+    if (root_ != nullptr) {
+        erase_since(root_);
+        root_ = leftmost_ = rightmost_ = nullptr;
+        size_ = 0;
+    }
+}
+
+//  btree
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+swap(btree& rhs) noexcept {
+    if (this != &rhs) {
+        MoperSTL::swap(root_, rhs.root_);
+        MoperSTL::swap(leftmost_, rhs.leftmost_);
+        MoperSTL::swap(rightmost_, rhs.rightmost_);
+        MoperSTL::swap(size_, rhs.size_);
+        MoperSTL::swap(key_comp_, rhs.key_comp_);
+    }
+}
+
+/*****************************************************************************************/
+// helper function
+
+// һյҶڵ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::node_ptr
+btree<T, Compare, NodeBytes>::
+create_leaf() {
+    node_ptr x = leaf_allocator().allocate(1);
+    x->parent = nullptr;
+    x->count = 0;
+    x->position = 0;
+    x->leaf = true;
+    return x;
+}
+
+// һյڲڵ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::node_ptr
+btree<T, Compare, NodeBytes>::
+create_internal() {
+    internal_ptr x = internal_allocator().allocate(1);
+    x->parent = nullptr;
+    x->count = 0;
+    x->position = 0;
+    x->leaf = false;
+    for (size_type i = 0; i <= node_values; ++i)
+        x->children[i] = nullptr;
+    return x;
+}
+
+// ͷŽڵ㣬ڵеԪѱ
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+destroy_node(node_ptr x) noexcept {
+    if (x->leaf)
+        leaf_allocator().deallocate(x, 1);
+    else
+        internal_allocator().deallocate(x->as_internal(), 1);
+}
+
+//  x 
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+erase_since(node_ptr x) noexcept {
+    if (!x->leaf) {
+        for (size_type i = 0; i <= x->count; ++i) {
+            if (x->child(i) != nullptr)
+                erase_since(x->child(i));
+        }
+    }
+    for (size_type i = 0; i < x->count; ++i)
+        destroy_slot(x, i);
+    destroy_node(x);
+}
+
+// ݹ鸴 x Ϊp Ϊĸڵ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::node_ptr
+btree<T, Compare, NodeBytes>::
+copy_from(node_ptr x, internal_ptr p) {
+    node_ptr top = x->leaf ? create_leaf() : create_internal();
+    top->parent = p;
+    top->position = x->position;
+    try {
+        for (size_type i = 0; i < x->count; ++i) {
+            construct_slot(top, i, static_cast<const value_type&>(x->value(i)));
+            ++top->count;
+        }
+        if (!x->leaf) {
+            for (size_type i = 0; i <= x->count; ++i)
+                top->as_internal()->children[i] = copy_from(x->child(i), top->as_internal());
+        }
+    } catch (...) {
+        erase_since(top);
+        throw;
+    }
+    return top;
+}
+
+// ȡҶڵ
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+update_edges() noexcept {
+    if (root_ == nullptr) {
+        leftmost_ = rightmost_ = nullptr;
+        return;
+    }
+    leftmost_ = root_;
+    while (!leftmost_->leaf)
+        leftmost_ = leftmost_->child(0);
+    rightmost_ = root_;
+    while (!rightmost_->leaf)
+        rightmost_ = rightmost_->child(rightmost_->count);
+}
+
+//  x ĵ i λùԪ
+template <class T, class Compare, std::size_t NodeBytes>
+template <class V>
+void btree<T, Compare, NodeBytes>::
+construct_slot(node_ptr x, size_type i, V&& value) {
+    data_allocator().construct(MoperSTL::addressof(x->value(i)), MoperSTL::forward<V>(value));
+    if constexpr (tree_traits::separate_keys)
+        x->keys_[i] = value_traits::get_key(x->value(i));
+}
+
+//  src ĵ j ԪƵ dst ĵ i λãδʼԭԪ
+// map  value_type  const ֵƶֵһƶķʽ
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+relocate_slot(node_ptr dst, size_type i, node_ptr src, size_type j) {
+    data_allocator().construct(MoperSTL::addressof(dst->value(i)), MoperSTL::move(src->value(j)));
+    data_allocator().destroy(MoperSTL::addressof(src->value(j)));
+    if constexpr (tree_traits::separate_keys)
+        dst->keys_[i] = src->keys_[j];
+}
+
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+destroy_slot(node_ptr x, size_type i) noexcept {
+    data_allocator().destroy(MoperSTL::addressof(x->value(i)));
+}
+
+//  x ĵ i ӽڵ
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+set_child(node_ptr x, size_type i, node_ptr c) noexcept {
+    x->as_internal()->children[i] = c;
+    c->parent = x->as_internal();
+    c->position = static_cast<std::uint32_t>(i);
+}
+
+// ڵڵһֵС key λ
+// ֵұȽϷʽΪ less / greater ʱͳС key ļֵѭ޷֧ɱ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::size_type
+btree<T, Compare, NodeBytes>::
+lower_in_node(node_ptr x, const key_type& key) const {
+    const size_type n = x->count;
+    if constexpr (tree_traits::linear_search) {
+        const key_type* keys = x->keys();
+        const key_type k = key;
+        size_type r = 0;
+        for (size_type i = 0; i < n; ++i)
+            r += static_cast<size_type>(key_comp_(keys[i], k));
+        return r;
+    } else {
+        size_type lo = 0, hi = n;
+        while (lo < hi) {
+            const size_type mid = (lo + hi) / 2;
+            if (key_comp_(x->key(mid), key))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+}
+
+// ڵڵһֵ key λ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::size_type
+btree<T, Compare, NodeBytes>::
+upper_in_node(node_ptr x, const key_type& key) const {
+    const size_type n = x->count;
+    if constexpr (tree_traits::linear_search) {
+        const key_type* keys = x->keys();
+        const key_type k = key;
+        size_type r = 0;
+        for (size_type i = 0; i < n; ++i)
+            r += static_cast<size_type>(!key_comp_(k, keys[i]));
+        return r;
+    } else {
+        size_type lo = 0, hi = n;
+        while (lo < hi) {
+            const size_type mid = (lo + hi) / 2;
+            if (!key_comp_(key, x->key(mid)))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+}
+
+// Ը² lower_boundupper Ϊ false upper_boundupper Ϊ true
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+bound_since(const key_type& key, bool upper) {
+    iterator res = end();
+    node_ptr x = root_;
+    while (x != nullptr) {
+        const size_type pos = upper ? upper_in_node(x, key) : lower_in_node(x, key);
+        if (pos < x->count)
+            res = iterator(x, pos);
+        if (x->leaf)
+            break;
+        x = x->child(pos);
+    }
+    return res;
+}
+
+// Ԫأֵظ
+template <class T, class Compare, std::size_t NodeBytes>
+template <class V>
+MoperSTL::pair<typename btree<T, Compare, NodeBytes>::iterator, bool>
+btree<T, Compare, NodeBytes>::
+insert_unique_value(V&& value) {
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+    if (root_ == nullptr) {
+        root_ = leftmost_ = rightmost_ = create_leaf();
+    }
+    const key_type& key = value_traits::get_key(value);
+    node_ptr x = root_;
+    size_type pos = 0;
+    while (true) {
+        pos = lower_in_node(x, key);
+        if (pos < x->count && !key_comp_(key, x->key(pos)))
+            return MoperSTL::make_pair(iterator(x, pos), false);
+        if (x->leaf)
+            break;
+        x = x->child(pos);
+    }
+    return MoperSTL::make_pair(insert_at_leaf(x, pos, MoperSTL::forward<V>(value)), true);
+}
+
+// ԪأֵظԪλڵֵԪ֮
+template <class T, class Compare, std::size_t NodeBytes>
+template <class V>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+insert_multi_value(V&& value) {
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+    if (root_ == nullptr) {
+        root_ = leftmost_ = rightmost_ = create_leaf();
+    }
+    const key_type& key = value_traits::get_key(value);
+    node_ptr x = root_;
+    size_type pos = 0;
+    while (true) {
+        pos = upper_in_node(x, key);
+        if (x->leaf)
+            break;
+        x = x->child(pos);
+    }
+    return insert_at_leaf(x, pos, MoperSTL::forward<V>(value));
+}
+
+// ʹ hint ԪأԪǡӦλ hint ֮ǰ֮󣩣򲻱Ը
+template <class T, class Compare, std::size_t NodeBytes>
+template <class V>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+insert_unique_hint_value(const_iterator hint, V&& value) {
+    if (size_ == 0)
+        return insert_unique_value(MoperSTL::forward<V>(value)).first;
+    const key_type& key = value_traits::get_key(value);
+    if (hint == end() || key_comp_(key, key_of(hint))) {
+        if (hint == begin())
+            return insert_before(hint, MoperSTL::forward<V>(value));
+        auto prev = hint;
+        --prev;
+        if (key_comp_(key_of(prev), key))
+            return insert_before(hint, MoperSTL::forward<V>(value));
+    } else if (key_comp_(key_of(hint), key)) {
+        auto next = hint;
+        ++next;
+        if (next == end() || key_comp_(key, key_of(next)))
+            return insert_before(next, MoperSTL::forward<V>(value));
+    } else {
+        return iterator(hint.node, hint.position);  // ֵѴ
+    }
+    return insert_unique_value(MoperSTL::forward<V>(value)).first;
+}
+
+template <class T, class Compare, std::size_t NodeBytes>
+template <class V>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+insert_multi_hint_value(const_iterator hint, V&& value) {
+    if (size_ == 0)
+        return insert_multi_value(MoperSTL::forward<V>(value));
+    const key_type& key = value_traits::get_key(value);
+    if (hint == end() || !key_comp_(key_of(hint), key)) {
+        if (hint == begin())
+            return insert_before(hint, MoperSTL::forward<V>(value));
+        auto prev = hint;
+        --prev;
+        if (!key_comp_(key, key_of(prev)))
+            return insert_before(hint, MoperSTL::forward<V>(value));
+    }
+    return insert_multi_value(MoperSTL::forward<V>(value));
+}
+
+//  pos ֮ǰԪأ֤߱ȷ
+// pos λڲڵʱǰΪĳҶڵһԪأԪ׷ڸҶڵĩβ
+template <class T, class Compare, std::size_t NodeBytes>
+template <class V>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+insert_before(const_iterator pos, V&& value) {
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+    if (pos.node->leaf)
+        return insert_at_leaf(pos.node, pos.position, MoperSTL::forward<V>(value));
+    --pos;
+    return insert_at_leaf(pos.node, pos.position + 1, MoperSTL::forward<V>(value));
+}
+
+// Ҷڵ x  pos Ԫأڵʱȷ
+template <class T, class Compare, std::size_t NodeBytes>
+template <class V>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+insert_at_leaf(node_ptr x, size_type pos, V&& value) {
+    if (x->count == node_values) {
+        // ȹԪأ֮пʧܵĹ
+        value_type tmp(MoperSTL::forward<V>(value));
+        const size_type left = split(x, pos);
+        if (pos > left) {
+            x = x->parent->children[x->position + 1];
+            pos -= left + 1;
+        }
+        insert_in_node(x, pos, MoperSTL::move(tmp));
+        update_edges();
+    } else {
+        insert_in_node(x, pos, MoperSTL::forward<V>(value));
+    }
+    ++size_;
+    return iterator(x, pos);
+}
+
+// пλĽڵ x  pos Ԫ
+template <class T, class Compare, std::size_t NodeBytes>
+template <class V>
+void btree<T, Compare, NodeBytes>::
+insert_in_node(node_ptr x, size_type pos, V&& value) {
+    for (size_type j = x->count; j > pos; --j)
+        relocate_slot(x, j, x, j - 1);
+    try {
+        construct_slot(x, pos, MoperSTL::forward<V>(value));
+    } catch (...) {
+        for (size_type j = pos; j < x->count; ++j)
+            relocate_slot(x, j, x, j + 1);
+        throw;
+    }
+    ++x->count;
+}
+
+// Ľڵ xpos ΪҪλãڲڵΪѵӽڵ±꣩
+// x ǰ left Ԫأ left ԪƵڵ㣬µֵܽڵ㣬 left
+// ڽڵĩβʱ x ȫڽڵײʱֵܱȫ˳ʱڵ㼸ȫ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::size_type
+btree<T, Compare, NodeBytes>::
+split(node_ptr x, size_type pos) {
+    const size_type n = x->count;
+    const size_type left = pos == n ? n - 1 : (pos == 0 ? 0 : n / 2);
+
+    node_ptr parent = x->parent;
+    if (parent == nullptr) {  // Ѹڵ㣬һ
+        parent = create_internal();
+        set_child(parent, 0, x);
+        root_ = parent;
+    } else if (parent->count == node_values) {
+        split(parent, x->position);
+        parent = x->parent;
+    }
+
+    node_ptr sibling = x->leaf ? create_leaf() : create_internal();
+    for (size_type j = left + 1; j < n; ++j)
+        relocate_slot(sibling, j - left - 1, x, j);
+    if (!x->leaf) {
+        for (size_type j = left + 1; j <= n; ++j)
+            set_child(sibling, j - left - 1, x->child(j));
+    }
+    sibling->count = static_cast<std::uint32_t>(n - left - 1);
+
+    // мԪƵڵ i ֵܳΪڵĵ i + 1 ӽڵ
+    const size_type i = x->position;
+    for (size_type j = parent->count; j > i; --j) {
+        relocate_slot(parent, j, parent, j - 1);
+        set_child(parent, j + 1, parent->child(j));
+    }
+    relocate_slot(parent, i, x, left);
+    set_child(parent, i + 1, sibling);
+    ++parent->count;
+    x->count = static_cast<std::uint32_t>(left);
+    return left;
+}
+
+// ɾҶڵ޸ԪزĽڵ㣺ֵܺϲϲֵܴԪ
+// res Ϊɾλ֮Ԫأϲʱ֮շ
+template <class T, class Compare, std::size_t NodeBytes>
+typename btree<T, Compare, NodeBytes>::iterator
+btree<T, Compare, NodeBytes>::
+rebalance_after_erase(iterator res) {
+    node_ptr x = res.node;
+    while (true) {
+        if (x == root_) {
+            if (x->count == 0) {
+                if (x->leaf) {
+                    destroy_node(x);
+                    root_ = nullptr;
+                } else {
+                    root_ = x->child(0);
+                    root_->parent = nullptr;
+                    root_->position = 0;
+                    destroy_node(x);
+                }
+            }
+            break;
+        }
+        if (x->count >= min_values)
+            break;
+        node_ptr parent = x->parent;
+        const size_type i = x->position;
+        if (i < parent->count) {
+            node_ptr right = parent->child(i + 1);
+            if (x->count + 1 + right->count <= node_values) {
+                merge_nodes(x, right, res);
+            } else {
+                rotate_left(x, right, (right->count - x->count) / 2, res);
+                break;
+            }
+        } else {
+            node_ptr left = parent->child(i - 1);
+            if (left->count + 1 + x->count <= node_values) {
+                merge_nodes(left, x, res);
+            } else {
+                rotate_right(left, x, (left->count - x->count) / 2, res);
+                break;
+            }
+        }
+        x = parent;
+    }
+    update_edges();
+    if (root_ == nullptr)
+        return end();
+    // res ΪҶڵĩβʱԪȽڵ
+    while (res.position == res.node->count && res.node->parent != nullptr) {
+        res.position = res.node->position;
+        res.node = res.node->parent;
+    }
+    if (res.position == res.node->count)
+        return end();
+    return res;
+}
+
+// ֵ right ֮ĸڵԪز leftͷ right
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+merge_nodes(node_ptr left, node_ptr right, iterator& res) {
+    node_ptr parent = left->parent;
+    const size_type i = left->position;
+    const size_type lc = left->count;
+    const size_type rc = right->count;
+
+    relocate_slot(left, lc, parent, i);
+    for (size_type j = 0; j < rc; ++j)
+        relocate_slot(left, lc + 1 + j, right, j);
+    if (!left->leaf) {
+        for (size_type j = 0; j <= rc; ++j)
+            set_child(left, lc + 1 + j, right->child(j));
+    }
+    left->count = static_cast<std::uint32_t>(lc + 1 + rc);
+
+    // ڵɾ i Ԫ i + 1 ӽڵ
+    for (size_type j = i + 1; j < parent->count; ++j) {
+        relocate_slot(parent, j - 1, parent, j);
+        set_child(parent, j, parent->child(j + 1));
+    }
+    --parent->count;
+
+    if (res.node == right) {
+        res = iterator(left, lc + 1 + res.position);
+    } else if (res.node == parent) {
+        if (res.position == i)
+            res = iterator(left, lc);
+        else if (res.position > i)
+            --res.position;
+    }
+    right->count = 0;
+    destroy_node(right);
+}
+
+// ֵ right  k Ԫص left ĩβ
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+rotate_left(node_ptr left, node_ptr right, size_type k, iterator& res) {
+    node_ptr parent = left->parent;
+    const size_type i = left->position;
+    const size_type lc = left->count;
+    const size_type rc = right->count;
+
+    relocate_slot(left, lc, parent, i);
+    for (size_type j = 0; j + 1 < k; ++j)
+        relocate_slot(left, lc + 1 + j, right, j);
+    relocate_slot(parent, i, right, k - 1);
+    for (size_type j = k; j < rc; ++j)
+        relocate_slot(right, j - k, right, j);
+    if (!left->leaf) {
+        for (size_type j = 0; j < k; ++j)
+            set_child(left, lc + 1 + j, right->child(j));
+        for (size_type j = k; j <= rc; ++j)
+            set_child(right, j - k, right->child(j));
+    }
+    left->count = static_cast<std::uint32_t>(lc + k);
+    right->count = static_cast<std::uint32_t>(rc - k);
+
+    if (res.node == right) {
+        if (res.position + 1 < k)
+            res = iterator(left, lc + 1 + res.position);
+        else if (res.position + 1 == k)
+            res = iterator(parent, i);
+        else
+            res.position -= k;
+    } else if (res.node == parent && res.position == i) {
+        res = iterator(left, lc);
+    }
+}
+
+// ֵ left  k Ԫص right ײ
+template <class T, class Compare, std::size_t NodeBytes>
+void btree<T, Compare, NodeBytes>::
+rotate_right(node_ptr left, node_ptr right, size_type k, iterator& res) {
+    node_ptr parent = left->parent;
+    const size_type i = left->position;
+    const size_type lc = left->count;
+    const size_type rc = right->count;
+
+    for (size_type j = rc; j > 0; --j)
+        relocate_slot(right, j - 1 + k, right, j - 1);
+    relocate_slot(right, k - 1, parent, i);
+    for (size_type j = 0; j + 1 < k; ++j)
+        relocate_slot(right, j, left, lc - k + 1 + j);
+    relocate_slot(parent, i, left, lc - k);
+    if (!right->leaf) {
+        for (size_type j = rc + 1; j > 0; --j)
+            set_child(right, j - 1 + k, right->child(j - 1));
+        for (size_type j = 0; j < k; ++j)
+            set_child(right, j, left->child(lc - k + 1 + j));
+    }
+    left->count = static_cast<std::uint32_t>(lc - k);
+    right->count = static_cast<std::uint32_t>(rc + k);
+
+    if (res.node == right) {
+        res.position += k;
+    } else if (res.node == left && res.position >= lc - k) {
+        if (res.position == lc - k)
+            res = iterator(parent, i);
+        else
+            res = iterator(right, res.position - (lc - k + 1));
+    } else if (res.node == parent && res.position == i) {
+        res = iterator(right, k - 1);
+    }
+}
+
+// رȽϲ
+template <class T, class Compare, std::size_t NodeBytes>
+bool operator==(const btree<T, Compare, NodeBytes>& lhs, const btree<T, Compare, NodeBytes>& rhs) {
+    return lhs.size() == rhs.size() && MoperSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Compare, std::size_t NodeBytes>
+bool operator!=(const btree<T, Compare, NodeBytes>& lhs, const btree<T, Compare, NodeBytes>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Compare, std::size_t NodeBytes>
+bool operator<(const btree<T, Compare, NodeBytes>& lhs, const btree<T, Compare, NodeBytes>& rhs) {
+    return MoperSTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Compare, std::size_t NodeBytes>
+bool operator>(const btree<T, Compare, NodeBytes>& lhs, const btree<T, Compare, NodeBytes>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Compare, std::size_t NodeBytes>
+bool operator<=(const btree<T, Compare, NodeBytes>& lhs, const btree<T, Compare, NodeBytes>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Compare, std::size_t NodeBytes>
+bool operator>=(const btree<T, Compare, NodeBytes>& lhs, const btree<T, Compare, NodeBytes>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  MoperSTL  swap
+template <class T, class Compare, std::size_t NodeBytes>
+void swap(btree<T, Compare, NodeBytes>& lhs, btree<T, Compare, NodeBytes>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_BTREE_H */
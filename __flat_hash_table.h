@@ -0,0 +1,732 @@
+#ifndef MOPER_STL_FLAT_HASH_TABLE_H
+#define MOPER_STL_FLAT_HASH_TABLE_H
+
+// ͷļ flat_hash_set  flat_hash_map ĵײƣѰַĹϣ flat_hash_tableSwiss table
+// ԪֱӴһĲλУΪÿԪصڵ㣻ÿλ 1 ֽڵĿֽڣ
+//   λΪ 1 ʾգfh_emptyɾfh_deletedΪ 0 ʱ 7 λԪعϣֵĵ 7 λh2
+// λ 16 һ飬ʱùϣֵλh1ѡʼ飬 SSE2 һαȽһ 16 ֽڣ
+// ֻ h2 ͬĲλŵ key_equalпղλʱҽ̽һ飬ɱ
+// ɾʱпղλ˵δ̽Խ飬ֱΪգΪɾĹ
+// ĹԪһ븺أشﵽʱԪزһԭؽĹӱĹϽ
+// ע⣺ؽؽɾĲ붼ʹʧЧؽʹеʧЧ
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MOPER_STL_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "__hash_table.h"
+
+namespace MoperSTL {
+
+// ֽ
+typedef signed char flat_hash_ctrl;
+
+constexpr flat_hash_ctrl fh_empty    = -128;  // 0b10000000
+constexpr flat_hash_ctrl fh_deleted  = -2;    // 0b11111110
+constexpr flat_hash_ctrl fh_sentinel = -1;    // 0b11111111λһλ֮󣬱˽
+
+// λ 1 λãx Ϊ 0
+inline unsigned __fh_ctz(std::uint32_t x) noexcept {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(__builtin_ctz(x));
+#endif
+}
+
+// һ 16 ֽڣ match  16 λ룬 i λӦڵ i λ
+struct flat_hash_group {
+    static constexpr std::size_t width = 16;
+
+#ifdef MOPER_STL_FLAT_HASH_SSE2
+    __m128i ctrl;
+
+    explicit flat_hash_group(const flat_hash_ctrl* p) noexcept
+        :ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+    std::uint32_t match(flat_hash_ctrl h2) const noexcept {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))));
+    }
+    std::uint32_t match_empty() const noexcept {
+        return match(fh_empty);
+    }
+    // ջɾֽС fh_sentinel
+    std::uint32_t match_empty_or_deleted() const noexcept {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(fh_sentinel), ctrl)));
+    }
+    // ԪػΪڱֽڴ fh_deleted
+    std::uint32_t match_full_or_sentinel() const noexcept {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(ctrl, _mm_set1_epi8(fh_deleted))));
+    }
+#else
+    // û SSE2 ʱֽڱȽϣͬ
+    flat_hash_ctrl ctrl[width];
+
+    explicit flat_hash_group(const flat_hash_ctrl* p) noexcept {
+        std::memcpy(ctrl, p, width);
+    }
+
+    std::uint32_t match(flat_hash_ctrl h2) const noexcept {
+        std::uint32_t m = 0;
+        for (std::size_t i = 0; i < width; ++i)
+            m |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+        return m;
+    }
+    std::uint32_t match_empty() const noexcept {
+        return match(fh_empty);
+    }
+    std::uint32_t match_empty_or_deleted() const noexcept {
+        std::uint32_t m = 0;
+        for (std::size_t i = 0; i < width; ++i)
+            m |= static_cast<std::uint32_t>(ctrl[i] < fh_sentinel) << i;
+        return m;
+    }
+    std::uint32_t match_full_or_sentinel() const noexcept {
+        std::uint32_t m = 0;
+        for (std::size_t i = 0; i < width; ++i)
+            m |= static_cast<std::uint32_t>(ctrl[i] > fh_deleted) << i;
+        return m;
+    }
+#endif
+};
+
+// flat_hash_table ĵV Ϊ const T ʱΪ const_iterator
+// ָֽӦĲλǰʱɾĲλڱͣ
+template <class T, class V>
+struct flat_hash_iterator {
+    typedef MoperSTL::forward_iterator_tag iterator_category;
+    typedef T                              value_type;
+    typedef std::ptrdiff_t                 difference_type;
+    typedef V*                             pointer;
+    typedef V&                             reference;
+
+    typedef flat_hash_iterator<T, V>       self;
+
+    const flat_hash_ctrl* ctrl;
+    T*                    slot;
+
+    flat_hash_iterator() :ctrl(nullptr), slot(nullptr) {}
+    flat_hash_iterator(const flat_hash_ctrl* c, T* s) :ctrl(c), slot(s) {}
+
+    //  iterator תΪ const_iterator
+    template <class U, typename std::enable_if<
+        std::is_same<const U, V>::value && !std::is_same<U, V>::value, int>::type = 0>
+    flat_hash_iterator(const flat_hash_iterator<T, U>& rhs) :ctrl(rhs.ctrl), slot(rhs.slot) {}
+
+    reference operator*()  const { return *slot; }
+    pointer   operator->() const { return slot; }
+
+    self& operator++() {
+        ++ctrl;
+        ++slot;
+        skip_empty_or_deleted();
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return ctrl == rhs.ctrl; }
+    bool operator!=(const self& rhs) const { return ctrl != rhs.ctrl; }
+
+    void skip_empty_or_deleted() noexcept {
+        while (*ctrl < fh_sentinel) {
+            const std::uint32_t m = flat_hash_group(ctrl).match_full_or_sentinel();
+            const std::size_t n = m != 0 ? __fh_ctz(m) : flat_hash_group::width;
+            ctrl += n;
+            slot += n;
+        }
+    }
+};
+
+// ģ flat_hash_tableֵظ
+// һԪͣϣֵȵıȽϺ
+// Ϊ 0 С 16  2 ݣΪ max_load_factorΪ 7/8֤ÿ̽鶼ղλ
+template <class T, class Hash, class KeyEqual>
+class flat_hash_table {
+public:
+  // flat_hash_table ͱ
+    typedef ht_value_traits<T>                          value_traits;
+    typedef typename value_traits::key_type             key_type;
+    typedef typename value_traits::mapped_type          mapped_type;
+    typedef typename value_traits::value_type           value_type;
+    typedef Hash                                        hasher;
+    typedef KeyEqual                                    key_equal;
+
+    typedef MoperSTL::allocator<T>                      allocator_type;
+    typedef MoperSTL::allocator<T>                      data_allocator;
+    typedef MoperSTL::allocator<flat_hash_ctrl>         ctrl_allocator;
+
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef T&                                          reference;
+    typedef const T&                                    const_reference;
+    typedef std::size_t                                 size_type;
+    typedef std::ptrdiff_t                              difference_type;
+
+    typedef flat_hash_iterator<T, T>                    iterator;
+    typedef flat_hash_iterator<T, const T>              const_iterator;
+
+    static constexpr size_type width = flat_hash_group::width;
+
+    allocator_type get_allocator() const { return allocator_type(); }
+
+private:
+    flat_hash_ctrl* ctrl_;         // capacity_ + width ֽڣctrl_[capacity_] Ϊڱ
+    T*              slots_;
+    size_type       capacity_;
+    size_type       size_;
+    size_type       growth_left_;  // ҪؽռõĿղλ
+    float           mlf_;
+    hasher          hash_;
+    key_equal       equal_;
+
+public:
+  // 졢ơƶ
+
+    explicit flat_hash_table(size_type bucket_count = 0,
+                             const Hash& hash = Hash(),
+                             const KeyEqual& equal = KeyEqual())
+        :ctrl_(empty_group()), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+         mlf_(0.875f), hash_(hash), equal_(equal) {
+        if (bucket_count != 0)
+            rehash(bucket_count);
+    }
+
+    flat_hash_table(const flat_hash_table& rhs);
+    flat_hash_table(flat_hash_table&& rhs) noexcept
+        :ctrl_(rhs.ctrl_), slots_(rhs.slots_), capacity_(rhs.capacity_), size_(rhs.size_),
+         growth_left_(rhs.growth_left_), mlf_(rhs.mlf_), hash_(rhs.hash_), equal_(rhs.equal_) {
+        rhs.ctrl_ = empty_group();
+        rhs.slots_ = nullptr;
+        rhs.capacity_ = 0;
+        rhs.size_ = 0;
+        rhs.growth_left_ = 0;
+    }
+
+    flat_hash_table& operator=(const flat_hash_table& rhs) {
+        if (this != &rhs) {
+            flat_hash_table tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+    flat_hash_table& operator=(flat_hash_table&& rhs) noexcept {
+        flat_hash_table tmp(MoperSTL::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    ~flat_hash_table() { destroy_table(); }
+
+    // ز
+
+    iterator       begin()        noexcept {
+        iterator it(ctrl_, slots_);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+    const_iterator begin()  const noexcept {
+        const_iterator it(ctrl_, slots_);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+    iterator       end()          noexcept { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator end()    const noexcept { return const_iterator(ctrl_ + capacity_, slots_ + capacity_); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+
+    // ز
+
+    bool      empty()    const noexcept { return size_ == 0; }
+    size_type size()     const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / (sizeof(T) + 1); }
+
+    // ޸ز
+
+    // ȹԪֵٰ룬ֵѴʱٸԪ
+    template <class ...Args>
+    pair<iterator, bool> emplace_unique(Args&& ...args) {
+        T tmp(MoperSTL::forward<Args>(args)...);
+        return insert_unique(MoperSTL::move(tmp));
+    }
+
+    // ֵѴʱԪ
+    pair<iterator, bool> insert_unique(const value_type& value) {
+        return emplace_key(value_traits::get_key(value), value);
+    }
+    pair<iterator, bool> insert_unique(value_type&& value) {
+        return emplace_key(value_traits::get_key(value), MoperSTL::move(value));
+    }
+
+    //  key ңʱ args Ԫأargs 빹ֵ key ȵԪ
+    template <class ...Args>
+    pair<iterator, bool> emplace_key(const key_type& key, Args&& ...args);
+    //  key ңʱ k ֵʼʵֵԪأʵֵֻȷʵʱŹ
+    template <class K>
+    pair<iterator, bool> emplace_key_default(const key_type& key, K&& k);
+
+    template <class InputIter>
+    void insert_unique(InputIter first, InputIter last) {
+        for (; first != last; ++first)
+            insert_unique(*first);
+    }
+
+    void      erase(const_iterator position) {
+        erase_slot(static_cast<size_type>(position.ctrl - ctrl_));
+    }
+    void      erase(const_iterator first, const_iterator last) {
+        for (; first != last; ++first)
+            erase(first);
+    }
+    size_type erase_unique(const key_type& key) {
+        const size_type i = find_index(key);
+        if (i == capacity_)
+            return 0;
+        erase_slot(i);
+        return 1;
+    }
+
+    void      clear() noexcept;
+
+    void      swap(flat_hash_table& rhs) noexcept {
+        MoperSTL::swap(ctrl_, rhs.ctrl_);
+        MoperSTL::swap(slots_, rhs.slots_);
+        MoperSTL::swap(capacity_, rhs.capacity_);
+        MoperSTL::swap(size_, rhs.size_);
+        MoperSTL::swap(growth_left_, rhs.growth_left_);
+        MoperSTL::swap(mlf_, rhs.mlf_);
+        MoperSTL::swap(hash_, rhs.hash_);
+        MoperSTL::swap(equal_, rhs.equal_);
+    }
+
+    // ز
+
+    size_type      count(const key_type& key) const { return find_index(key) == capacity_ ? 0 : 1; }
+    iterator       find(const key_type& key)        { return make_iter(find_index(key)); }
+    const_iterator find(const key_type& key)  const { return make_citer(find_index(key)); }
+
+    pair<iterator, iterator> equal_range_unique(const key_type& key) {
+        return range_of(find(key));
+    }
+    pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const {
+        return range_of(find(key));
+    }
+
+    // 칹ң Hash  KeyEqual  is_transparent ʱ
+
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    size_type      count(const K& key) const { return find_index(key) == capacity_ ? 0 : 1; }
+
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    iterator       find(const K& key)       { return make_iter(find_index(key)); }
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    const_iterator find(const K& key) const { return make_citer(find_index(key)); }
+
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<iterator, iterator> equal_range_unique(const K& key) {
+        return range_of(find(key));
+    }
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<const_iterator, const_iterator> equal_range_unique(const K& key) const {
+        return range_of(find(key));
+    }
+
+    // bucket interfacebucket λ
+
+    size_type bucket_count()     const noexcept { return capacity_; }
+    size_type max_bucket_count() const noexcept { return max_size(); }
+
+    // hash policy
+
+    float     load_factor() const noexcept {
+        return capacity_ != 0 ? static_cast<float>(size_) / capacity_ : 0.0f;
+    }
+    float     max_load_factor() const noexcept { return mlf_; }
+    //  [1/8, 7/8] ֮
+    void      max_load_factor(float ml) {
+        THROW_OUT_OF_RANGE_IF(ml != ml || ml < 0, "invalid hash load factor");
+        // ռõĲλԪĹٰ¼ʣ
+        const size_type used = growth_limit(capacity_) - growth_left_;
+        mlf_ = ml < 0.125f ? 0.125f : (ml > 0.875f ? 0.875f : ml);
+        if (capacity_ == 0)
+            return;
+        const size_type limit = growth_limit(capacity_);
+        if (size_ > limit)
+            rehash(0);
+        else
+            growth_left_ = limit > used ? limit - used : 0;
+    }
+
+    // Ϊ count λڸԪصС 2 ݣͬʱĹ
+    void      rehash(size_type count);
+    // ֤ count Ԫ֮ǰؽ
+    void      reserve(size_type count) {
+        rehash(static_cast<size_type>(static_cast<float>(count) / mlf_ + 1.0f));
+    }
+
+    hasher    hash_fcn() const { return hash_; }
+    key_equal key_eq()   const { return equal_; }
+
+    // Ԫظͬ this еÿԪض other ҵȵԪ
+    bool      equal_unique(const flat_hash_table& other) const;
+
+private:
+    // helper functions
+
+    // Ϊ 0 ʱʹõֻֽڣڱ֮ȫΪ
+    static flat_hash_ctrl* empty_group() noexcept {
+        alignas(16) static const flat_hash_ctrl group[width] = {
+            fh_sentinel, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty,
+            fh_empty,    fh_empty, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty
+        };
+        return const_cast<flat_hash_ctrl*>(group);
+    }
+
+    // Թϣֵһλϣʹ 7 λλֵĸλأϣȵϣҲܾȷֲ
+    static size_type mix(size_type h) noexcept {
+        if (sizeof(size_type) == 8) {
+            const std::uint64_t x = (static_cast<std::uint64_t>(h) ^ (static_cast<std::uint64_t>(h) >> 33))
+                                    * 0xff51afd7ed558ccdULL;
+            return static_cast<size_type>(x ^ (x >> 33));
+        }
+        const std::uint32_t x = (static_cast<std::uint32_t>(h) ^ (static_cast<std::uint32_t>(h) >> 16))
+                                * 0x85ebca6bU;
+        return static_cast<size_type>(x ^ (x >> 13));
+    }
+
+    template <class K>
+    size_type hash_of(const K& key) const { return mix(hash_(key)); }
+
+    static flat_hash_ctrl h2(size_type h) noexcept { return static_cast<flat_hash_ctrl>(h & 0x7f); }
+
+    // ʼ׸λ
+    static size_type probe_start(size_type h, size_type capacity) noexcept {
+        return ((h >> 7) * width) & (capacity - 1);
+    }
+
+    size_type growth_limit(size_type capacity) const noexcept {
+        const size_type limit = static_cast<size_type>(static_cast<float>(capacity) * mlf_);
+        return limit < capacity - capacity / 8 ? limit : capacity - capacity / 8;
+    }
+
+    iterator make_iter(size_type i) noexcept {
+        return iterator(ctrl_ + i, slots_ + i);
+    }
+    const_iterator make_citer(size_type i) const noexcept {
+        return const_iterator(ctrl_ + i, slots_ + i);
+    }
+    template <class Iter>
+    pair<Iter, Iter> range_of(Iter it) const {
+        Iter last = it;
+        if (it.ctrl != ctrl_ + capacity_)
+            ++last;
+        return pair<Iter, Iter>(it, last);
+    }
+
+    template <class K>
+    size_type find_index(const K& key) const;
+    static size_type find_first_non_full(const flat_hash_ctrl* ctrl, size_type capacity, size_type h) noexcept;
+    pair<size_type, bool> find_or_prepare_insert(const key_type& key, size_type h);
+    //  find_or_prepare_insert صĲλϹԪ֮ǼǸòλ
+    void finish_insert(size_type i, size_type h) noexcept {
+        if (ctrl_[i] == fh_empty)
+            --growth_left_;
+        set_ctrl(i, h2(h));
+        ++size_;
+    }
+
+    void set_ctrl(size_type i, flat_hash_ctrl c) noexcept { ctrl_[i] = c; }
+    void erase_slot(size_type i) noexcept;
+    void grow_for_insert();
+    void resize(size_type new_capacity);
+    void destroy_table() noexcept;
+};
+
+/*****************************************************************************************/
+
+// ƹ캯ԭλ֣Ĺ¼ϣֵ
+template <class T, class Hash, class KeyEqual>
+flat_hash_table<T, Hash, KeyEqual>::
+flat_hash_table(const flat_hash_table& rhs)
+    :ctrl_(empty_group()), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+     mlf_(rhs.mlf_), hash_(rhs.hash_), equal_(rhs.equal_) {
+    if (rhs.capacity_ == 0)
+        return;
+    flat_hash_ctrl* ctrl = ctrl_allocator().allocate(rhs.capacity_ + width);
+    T* slots = nullptr;
+    size_type i = 0;
+    try {
+        slots = data_allocator().allocate(rhs.capacity_);
+        for (; i < rhs.capacity_; ++i) {
+            if (rhs.ctrl_[i] >= 0)
+                data_allocator().construct(slots + i, rhs.slots_[i]);
+        }
+    } catch (...) {
+        while (i-- > 0) {
+            if (rhs.ctrl_[i] >= 0)
+                data_allocator().destroy(slots + i);
+        }
+        if (slots != nullptr)
+            data_allocator().deallocate(slots, rhs.capacity_);
+        ctrl_allocator().deallocate(ctrl, rhs.capacity_ + width);
+        throw;
+    }
+    std::memcpy(ctrl, rhs.ctrl_, rhs.capacity_ + width);
+    ctrl_ = ctrl;
+    slots_ = slots;
+    capacity_ = rhs.capacity_;
+    size_ = rhs.size_;
+    growth_left_ = rhs.growth_left_;
+}
+
+//  key ңʱ̽ϵһջɾĲλ args Ԫ
+template <class T, class Hash, class KeyEqual>
+template <class ...Args>
+pair<typename flat_hash_table<T, Hash, KeyEqual>::iterator, bool>
+flat_hash_table<T, Hash, KeyEqual>::
+emplace_key(const key_type& key, Args&& ...args) {
+    const size_type h = hash_of(key);
+    const pair<size_type, bool> r = find_or_prepare_insert(key, h);
+    if (r.second) {
+        data_allocator().construct(slots_ + r.first, MoperSTL::forward<Args>(args)...);
+        finish_insert(r.first, h);
+    }
+    return pair<iterator, bool>(make_iter(r.first), r.second);
+}
+
+// ͬ emplace_keyʵֵȷҪֵ֮ʼֵѴʱκζ
+template <class T, class Hash, class KeyEqual>
+template <class K>
+pair<typename flat_hash_table<T, Hash, KeyEqual>::iterator, bool>
+flat_hash_table<T, Hash, KeyEqual>::
+emplace_key_default(const key_type& key, K&& k) {
+    const size_type h = hash_of(key);
+    const pair<size_type, bool> r = find_or_prepare_insert(key, h);
+    if (r.second) {
+        data_allocator().construct(slots_ + r.first, MoperSTL::forward<K>(k), mapped_type{});
+        finish_insert(r.first, h);
+    }
+    return pair<iterator, bool>(make_iter(r.first), r.second);
+}
+
+//  key ңʱλ false򷵻̽ϵһջɾĲλ true
+// ûвʱݡصĲλδǼǣԪʧʱֲ
+template <class T, class Hash, class KeyEqual>
+pair<typename flat_hash_table<T, Hash, KeyEqual>::size_type, bool>
+flat_hash_table<T, Hash, KeyEqual>::
+find_or_prepare_insert(const key_type& key, size_type h) {
+    if (capacity_ != 0) {
+        const size_type mask = capacity_ - 1;
+        size_type pos = probe_start(h, capacity_);
+        for (size_type step = width; ; step += width) {
+            const flat_hash_group g(ctrl_ + pos);
+            for (std::uint32_t m = g.match(h2(h)); m != 0; m &= m - 1) {
+                const size_type i = pos + __fh_ctz(m);
+                if (equal_(key, value_traits::get_key(slots_[i])))
+                    return pair<size_type, bool>(i, false);
+            }
+            if (g.match_empty() != 0)
+                break;
+            pos = (pos + step) & mask;
+        }
+    }
+    size_type i = capacity_ != 0 ? find_first_non_full(ctrl_, capacity_, h) : 0;
+    if (capacity_ == 0 || (growth_left_ == 0 && ctrl_[i] != fh_deleted)) {
+        THROW_LENGTH_ERROR_IF(size_ == max_size(), "flat_hash_table<T>'s size too big");
+        grow_for_insert();
+        i = find_first_non_full(ctrl_, capacity_, h);
+    }
+    return pair<size_type, bool>(i, true);
+}
+
+// ҼֵΪ key ԪڵĲλʱ capacity_
+template <class T, class Hash, class KeyEqual>
+template <class K>
+typename flat_hash_table<T, Hash, KeyEqual>::size_type
+flat_hash_table<T, Hash, KeyEqual>::
+find_index(const K& key) const {
+    if (size_ == 0)
+        return capacity_;
+    const size_type h = hash_of(key);
+    const size_type mask = capacity_ - 1;
+    size_type pos = probe_start(h, capacity_);
+    for (size_type step = width; ; step += width) {
+        const flat_hash_group g(ctrl_ + pos);
+        for (std::uint32_t m = g.match(h2(h)); m != 0; m &= m - 1) {
+            const size_type i = pos + __fh_ctz(m);
+            if (equal_(key, value_traits::get_key(slots_[i])))
+                return i;
+        }
+        if (g.match_empty() != 0)
+            return capacity_;
+        pos = (pos + step) & mask;
+    }
+}
+
+// ̽ϵһջɾĲλ
+template <class T, class Hash, class KeyEqual>
+typename flat_hash_table<T, Hash, KeyEqual>::size_type
+flat_hash_table<T, Hash, KeyEqual>::
+find_first_non_full(const flat_hash_ctrl* ctrl, size_type capacity, size_type h) noexcept {
+    const size_type mask = capacity - 1;
+    size_type pos = probe_start(h, capacity);
+    for (size_type step = width; ; step += width) {
+        const std::uint32_t m = flat_hash_group(ctrl + pos).match_empty_or_deleted();
+        if (m != 0)
+            return pos + __fh_ctz(m);
+        pos = (pos + step) & mask;
+    }
+}
+
+// ɾλ i еԪ
+template <class T, class Hash, class KeyEqual>
+void flat_hash_table<T, Hash, KeyEqual>::
+erase_slot(size_type i) noexcept {
+    data_allocator().destroy(slots_ + i);
+    --size_;
+    // пղλʱδû̽ԽֱΪ
+    if (flat_hash_group(ctrl_ + (i & ~(width - 1))).match_empty() != 0) {
+        set_ctrl(i, fh_empty);
+        ++growth_left_;
+    } else {
+        set_ctrl(i, fh_deleted);
+    }
+}
+
+// Ԫأ
+template <class T, class Hash, class KeyEqual>
+void flat_hash_table<T, Hash, KeyEqual>::
+clear() noexcept {
+    if (capacity_ == 0)
+        return;
+    if (!std::is_trivially_destructible<T>::value) {
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0)
+                data_allocator().destroy(slots_ + i);
+        }
+    }
+    std::memset(ctrl_, static_cast<unsigned char>(fh_empty), capacity_);
+    size_ = 0;
+    growth_left_ = growth_limit(capacity_);
+}
+
+// شﵽޣĹ϶ʱԭؽӱ
+template <class T, class Hash, class KeyEqual>
+void flat_hash_table<T, Hash, KeyEqual>::
+grow_for_insert() {
+    if (capacity_ == 0)
+        resize(width);
+    else if (size_ < growth_limit(capacity_) / 2)
+        resize(capacity_);
+    else
+        resize(capacity_ * 2);
+}
+
+template <class T, class Hash, class KeyEqual>
+void flat_hash_table<T, Hash, KeyEqual>::
+rehash(size_type count) {
+    size_type need = width;
+    while (need < count || growth_limit(need) < size_) {
+        THROW_LENGTH_ERROR_IF(need > max_size() / 2, "flat_hash_table<T>'s size too big");
+        need *= 2;
+    }
+    if (count == 0 && size_ == 0) {  // ͷпռ
+        destroy_table();
+        ctrl_ = empty_group();
+        slots_ = nullptr;
+        capacity_ = 0;
+        growth_left_ = 0;
+        return;
+    }
+    if (need != capacity_ || growth_left_ != growth_limit(capacity_) - size_)
+        resize(need);
+}
+
+// ԪΪ new_capacity ±Ԫصƶ׳쳣ʱΪƣ֤ԭ
+template <class T, class Hash, class KeyEqual>
+void flat_hash_table<T, Hash, KeyEqual>::
+resize(size_type new_capacity) {
+    flat_hash_ctrl* ctrl = ctrl_allocator().allocate(new_capacity + width);
+    std::memset(ctrl, static_cast<unsigned char>(fh_empty), new_capacity + width);
+    ctrl[new_capacity] = fh_sentinel;
+    T* slots = nullptr;
+    try {
+        slots = data_allocator().allocate(new_capacity);
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] < 0)
+                continue;
+            const size_type h = hash_of(value_traits::get_key(slots_[i]));
+            const size_type j = find_first_non_full(ctrl, new_capacity, h);
+            data_allocator().construct(slots + j, MoperSTL::move_if_noexcept(slots_[i]));
+            ctrl[j] = h2(h);
+        }
+    } catch (...) {
+        if (slots != nullptr) {
+            for (size_type j = 0; j < new_capacity; ++j) {
+                if (ctrl[j] >= 0)
+                    data_allocator().destroy(slots + j);
+            }
+            data_allocator().deallocate(slots, new_capacity);
+        }
+        ctrl_allocator().deallocate(ctrl, new_capacity + width);
+        throw;
+    }
+    destroy_table();
+    ctrl_ = ctrl;
+    slots_ = slots;
+    capacity_ = new_capacity;
+    growth_left_ = growth_limit(new_capacity) - size_;
+}
+
+// Ԫزͷſռ䣬޸ĳԱ
+template <class T, class Hash, class KeyEqual>
+void flat_hash_table<T, Hash, KeyEqual>::
+destroy_table() noexcept {
+    if (capacity_ == 0)
+        return;
+    if (!std::is_trivially_destructible<T>::value) {
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0)
+                data_allocator().destroy(slots_ + i);
+        }
+    }
+    data_allocator().deallocate(slots_, capacity_);
+    ctrl_allocator().deallocate(ctrl_, capacity_ + width);
+}
+
+template <class T, class Hash, class KeyEqual>
+bool flat_hash_table<T, Hash, KeyEqual>::
+equal_unique(const flat_hash_table& other) const {
+    if (size_ != other.size_)
+        return false;
+    for (auto it = begin(), last = end(); it != last; ++it) {
+        const size_type i = other.find_index(value_traits::get_key(*it));
+        if (i == other.capacity_ || !(*it == other.slots_[i]))
+            return false;
+    }
+    return true;
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_FLAT_HASH_TABLE_H */
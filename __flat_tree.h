@@ -0,0 +1,227 @@
+#ifndef MOPER_STL_FLAT_TREE_H
+#define MOPER_STL_FLAT_TREE_H
+
+// flat_set / flat_map ȣĹ
+// Ԫذֵź vector УΪֲң
+// Ҷֻڴ棬ʺϹһΡѯεĳ
+// ɾҪƶԪأʱ临ӶΪ O(n)һʹеʧЧ
+
+#include <cstddef>
+
+#include "iterator.h"
+#include "vector.h"
+#include "algorithm.h"
+#include "utility.h"
+#include "type_traits.h"
+#include "functional.h"
+
+namespace MoperSTL {
+
+// ǩ sorted_unique_tʾѰֵϸ
+struct sorted_unique_t {};
+
+constexpr sorted_unique_t sorted_unique = sorted_unique_t();
+
+// ǩ sorted_equivalent_tʾѰֵǵݼֵظ
+struct sorted_equivalent_t {};
+
+constexpr sorted_equivalent_t sorted_equivalent = sorted_equivalent_t();
+
+// ޷֧Ķֲ
+// ÿһֶ䳤ȼ룬ֻݱȽϽѡһε㣬ָ
+// ѭֻȡ n֧Ԥʧܶͣ
+
+//  [first, first + n) еһС key λ
+template <class T, class K, class Compare>
+const T* flat_lower_bound(const T* first, std::size_t n, const K& key, const Compare& comp) {
+    if (n == 0)
+        return first;
+    while (n > 1) {
+        const std::size_t half = n / 2;
+        first = comp(first[half], key) ? first + half : first;
+        n -= half;
+    }
+    return first + (comp(*first, key) ? 1 : 0);
+}
+
+//  [first, first + n) еһ key λ
+template <class T, class K, class Compare>
+const T* flat_upper_bound(const T* first, std::size_t n, const K& key, const Compare& comp) {
+    if (n == 0)
+        return first;
+    while (n > 1) {
+        const std::size_t half = n / 2;
+        first = comp(key, first[half]) ? first : first + half;
+        n -= half;
+    }
+    return first + (comp(key, *first) ? 0 : 1);
+}
+
+// ȶǰԪأȵԪرԭ˳unique ݴ˱ȳֵԪأ
+// ȶÿ 16 ԪٽͬСĻԵ鲢ʱ临Ӷ O(n log n)
+
+//  [first1, last1)  [first2, last2) 鲢 resultʱȡǰ
+template <class T, class Compare>
+T* flat_merge_move(T* first1, T* last1, T* first2, T* last2, T* result, const Compare& comp) {
+    while (first1 != last1 && first2 != last2)
+        *result++ = comp(*first2, *first1) ? MoperSTL::move(*first2++) : MoperSTL::move(*first1++);
+    while (first1 != last1)
+        *result++ = MoperSTL::move(*first1++);
+    while (first2 != last2)
+        *result++ = MoperSTL::move(*first2++);
+    return result;
+}
+
+template <class T, class Compare>
+void flat_stable_sort(T* first, T* last, const Compare& comp) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const std::size_t run = 16;
+    for (std::size_t lo = 0; lo < n; lo += run) {
+        T* const head = first + lo;
+        T* const tail = first + MoperSTL::min(n, lo + run);
+        for (T* i = head + 1; i < tail; ++i) {
+            if (comp(*i, *(i - 1))) {
+                T tmp(MoperSTL::move(*i));
+                T* j = i;
+                do {
+                    *j = MoperSTL::move(*(j - 1));
+                    --j;
+                } while (j != head && comp(tmp, *(j - 1)));
+                *j = MoperSTL::move(tmp);
+            }
+        }
+    }
+    if (n <= run)
+        return;
+    MoperSTL::vector<T> buf;
+    buf.reserve(n);
+    for (T* it = first; it != last; ++it)
+        buf.emplace_back(MoperSTL::move(*it));
+    T* src = buf.data();
+    T* dst = first;
+    for (std::size_t width = run; width < n; width *= 2) {
+        for (std::size_t lo = 0; lo < n; lo += 2 * width) {
+            const std::size_t mid = MoperSTL::min(n, lo + width);
+            const std::size_t hi = MoperSTL::min(n, lo + 2 * width);
+            flat_merge_move(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+        }
+        MoperSTL::swap(src, dst);
+    }
+    if (src != first) { // ڻУƻԭ
+        for (std::size_t i = 0; i < n; ++i)
+            first[i] = MoperSTL::move(src[i]);
+    }
+}
+
+// ϲʱȡеԪأMove Ϊ true ʱڲʱ壬ƶֻܸ
+template <bool Move, class T>
+typename std::conditional<Move, T&&, T&>::type flat_take(T& x) {
+    return static_cast<typename std::conditional<Move, T&&, T&>::type>(x);
+}
+
+// ϲʱȡԭеԪأNoThrow Ϊ trueͱƶ׳쳣Ԫزɸʱƶ
+// ƣʹϲ;׳쳣ʱԭԪرֲ
+template <bool NoThrow, class T>
+typename std::conditional<NoThrow || !std::is_copy_constructible<T>::value, T&&, const T&>::type
+flat_take_old(T& x) noexcept {
+    return static_cast<typename std::conditional<
+        NoThrow || !std::is_copy_constructible<T>::value, T&&, const T&>::type>(x);
+}
+
+//  pos µλãadded[k]  old[pos[k]] ֮ǰԪԭԪغϲһµ vector
+// ֻһȡԭԪأԪȫɣٵñȽϺ
+template <bool NoThrow, class Vector, class PosVector>
+Vector flat_merge_at(Vector& old, Vector& added, const PosVector& pos) {
+    Vector result;
+    result.reserve(old.size() + added.size());
+    std::size_t i = 0;
+    for (std::size_t k = 0; k < added.size(); ++k) {
+        for (; i < pos[k]; ++i)
+            result.emplace_back(flat_take_old<NoThrow>(old[i]));
+        result.emplace_back(MoperSTL::move(added[k]));
+    }
+    for (; i < old.size(); ++i)
+        result.emplace_back(flat_take_old<NoThrow>(old[i]));
+    return result;
+}
+
+// 䳤ȣԤȷռ䣻ֻܱһΣ޷Ԥ֪ȣ 0
+template <class InputIterator>
+std::size_t flat_range_size(InputIterator, InputIterator, MoperSTL::input_iterator_tag) {
+    return 0;
+}
+
+template <class ForwardIterator>
+std::size_t flat_range_size(ForwardIterator first, ForwardIterator last, MoperSTL::forward_iterator_tag) {
+    return static_cast<std::size_t>(MoperSTL::distance(first, last));
+}
+
+// flat_map Ԫ
+// flat_map ļֵʵֱֵ vector Уڴв pair 
+// ʱͬʱߵĴȻд it->firstit->second
+
+template <class Key, class T>
+struct flat_map_reference {
+    const Key& first;
+    T&         second;
+
+    flat_map_reference(const Key& k, T& v) :first(k), second(v) {}
+
+    //  operator-> ʹ
+    const flat_map_reference* operator->() const { return this; }
+
+    operator MoperSTL::pair<Key, typename std::remove_const<T>::type>() const {
+        return MoperSTL::pair<Key, typename std::remove_const<T>::type>(first, second);
+    }
+};
+
+// flat_map ĵT Ϊ const mapped_type ʱΪ const_iterator
+
+template <class Key, class T>
+struct flat_map_iterator {
+    typedef MoperSTL::random_access_iterator_tag                     iterator_category;
+    typedef MoperSTL::pair<Key, typename std::remove_const<T>::type> value_type;
+    typedef std::ptrdiff_t                                           difference_type;
+    typedef flat_map_reference<Key, T>                               reference;
+    typedef flat_map_reference<Key, T>                               pointer;
+
+    typedef flat_map_iterator<Key, T>                                self;
+
+    const Key* key;   // ֵָ
+    T*         value; // ָӦʵֵ
+
+    flat_map_iterator() :key(nullptr), value(nullptr) {}
+    flat_map_iterator(const Key* k, T* v) :key(k), value(v) {}
+
+    //  iterator תΪ const_iterator
+    template <class U, typename std::enable_if<
+        std::is_same<const U, T>::value && !std::is_same<U, T>::value, int>::type = 0>
+    flat_map_iterator(const flat_map_iterator<Key, U>& rhs) :key(rhs.key), value(rhs.value) {}
+
+    reference operator*()  const { return reference(*key, *value); }
+    pointer   operator->() const { return operator*(); }
+    reference operator[](difference_type n) const { return reference(key[n], value[n]); }
+
+    self& operator++() { ++key, ++value; return *this; }
+    self  operator++(int) { self tmp = *this; ++*this; return tmp; }
+    self& operator--() { --key, --value; return *this; }
+    self  operator--(int) { self tmp = *this; --*this; return tmp; }
+
+    self& operator+=(difference_type n) { key += n, value += n; return *this; }
+    self& operator-=(difference_type n) { key -= n, value -= n; return *this; }
+    self  operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+    self  operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+
+    difference_type operator-(const self& rhs) const { return key - rhs.key; }
+
+    bool operator==(const self& rhs) const { return key == rhs.key; }
+    bool operator!=(const self& rhs) const { return key != rhs.key; }
+    bool operator< (const self& rhs) const { return key < rhs.key; }
+    bool operator> (const self& rhs) const { return key > rhs.key; }
+    bool operator<=(const self& rhs) const { return key <= rhs.key; }
+    bool operator>=(const self& rhs) const { return key >= rhs.key; }
+};
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_FLAT_TREE_H */
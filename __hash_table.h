@@ -1,30 +1,22 @@
 #ifndef MOPER_STL_HASH_TABLE_H
 #define MOPER_STL_HASH_TABLE_H
 
+#include <cstdint>
 #include <initializer_list>
+#include <utility>
 
 #include "algorithm.h"
 #include "memory.h"
 #include "vector.h"
 #include "utility.h"
 #include "exceptdef.h"
+#include "__node_handle.h"
 
-namespace MoperSTL {
-
-// hashtable Ľڵ㶨
-template <class T>
-struct hashtable_node {
-    hashtable_node* next;   // ָһڵ
-    T               value;  // ʵֵ
-
-    hashtable_node() = default;
-    hashtable_node(const T& n) :next(nullptr), value(n) {}
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>  // _mm_prefetch()
+#endif
 
-    hashtable_node(const hashtable_node& node) :next(node.next), value(node.value) {}
-    hashtable_node(hashtable_node&& node) :next(node.next), value(MoperSTL::move(node.value)) {
-        node.next = nullptr;
-    }
-};
+namespace MoperSTL {
 
 // value traits
 template <class T, bool>
@@ -83,6 +75,80 @@ struct ht_value_traits {
 };
 
 
+// ڵǷ񻺴ֵĹϣֵȱʡΪֵǱָͣ롢öٵȣʱ
+//  rehash ٵùϣʱȱȽϹϣֵٵ key_equalɶԶֵػ
+template <class Key>
+struct ht_cache_hash : public std::integral_constant<bool, !std::is_scalar<Key>::value> {};
+
+// hashtable Ľڵ㶨
+// ȫڵ㴮һͬһ bucket Ľڵ
+struct hashtable_node_base {
+    // һڵָ bucket βǹһ֣ڵָٰ룬ָλΪ 0
+    //  1 ʾڵ bucket һڵ㣬ҵΪֹٷ bucket һڵ
+    std::uintptr_t next_last;
+
+    hashtable_node_base* get_next() const noexcept {
+        return reinterpret_cast<hashtable_node_base*>(next_last & ~static_cast<std::uintptr_t>(1));
+    }
+
+    // ֻıһڵ㣬β
+    void set_next(hashtable_node_base* np) noexcept {
+        next_last = reinterpret_cast<std::uintptr_t>(np) | (next_last & 1);
+    }
+
+    bool is_last() const noexcept {
+        return (next_last & 1) != 0;
+    }
+
+    void set_last(bool last) noexcept {
+        next_last = (next_last & ~static_cast<std::uintptr_t>(1)) | static_cast<std::uintptr_t>(last);
+    }
+
+    void set_link(hashtable_node_base* np, bool last) noexcept {
+        next_last = reinterpret_cast<std::uintptr_t>(np) | static_cast<std::uintptr_t>(last);
+    }
+};
+
+// hashtable  bucket 
+// before Ϊ bucket һڵеǰ bucket ͷ롢ɾfirst  before->get_next()
+// ʱֱӴ first ʼȷǰڵ㡣bucket Ϊʱ߾Ϊ nullptr
+struct hashtable_bucket {
+    hashtable_node_base* before;
+    hashtable_node_base* first;
+};
+
+template <class T, bool = ht_cache_hash<typename ht_value_traits<T>::key_type>::value>
+struct hashtable_node :public hashtable_node_base {
+    static constexpr bool cache_hash = false;
+
+    T               value;  // ʵֵ
+
+    hashtable_node() = default;
+    hashtable_node(const T& n) :hashtable_node_base{ nullptr }, value(n) {}
+
+    hashtable_node(const hashtable_node& node) :hashtable_node_base{ node.next_last }, value(node.value) {}
+    hashtable_node(hashtable_node&& node) :hashtable_node_base{ node.next_last }, value(MoperSTL::move(node.value)) {
+        node.next_last = 0;
+    }
+};
+
+// ϣֵĽڵ
+template <class T>
+struct hashtable_node<T, true> :public hashtable_node_base {
+    static constexpr bool cache_hash = true;
+
+    size_t          hash;   // ֵĹϣֵڵ hashtable ڲʱд
+    T               value;  // ʵֵ
+
+    hashtable_node() = default;
+    hashtable_node(const T& n) :hashtable_node_base{ nullptr }, hash(0), value(n) {}
+
+    hashtable_node(const hashtable_node& node) :hashtable_node_base{ node.next_last }, hash(node.hash), value(node.value) {}
+    hashtable_node(hashtable_node&& node) :hashtable_node_base{ node.next_last }, hash(node.hash), value(MoperSTL::move(node.value)) {
+        node.next_last = 0;
+    }
+};
+
 // forward declaration
 
 template <class T, class HashFun, class KeyEqual>
@@ -176,13 +242,7 @@ struct ht_iterator :public ht_iterator_base<T, Hash, KeyEqual> {
 
     iterator& operator++() {
         MYSTL_DEBUG(node != nullptr);
-        const node_ptr old = node;
-        node = node->next;
-        if (node == nullptr) { // һλΪգһ bucket ʼ
-            auto index = ht->hash(value_traits::get_key(old->value));
-            while (!node && ++index < ht->bucket_size_)
-                node = ht->buckets_[index];
-        }
+        node = static_cast<node_ptr>(node->get_next());
         return *this;
     }
     iterator operator++(int) {
@@ -243,14 +303,7 @@ struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual> {
 
     const_iterator& operator++() {
         MYSTL_DEBUG(node != nullptr);
-        const node_ptr old = node;
-        node = node->next;
-        if (node == nullptr) { // һλΪգһ bucket ʼ
-            auto index = ht->hash(value_traits::get_key(old->value));
-            while (!node && ++index < ht->bucket_size_) {
-                node = ht->buckets_[index];
-            }
-        }
+        node = static_cast<node_ptr>(node->get_next());
         return *this;
     }
     const_iterator operator++(int) {
@@ -287,7 +340,7 @@ struct ht_local_iterator :public MoperSTL::iterator<MoperSTL::forward_iterator_t
 
     self& operator++() {
         MYSTL_DEBUG(node != nullptr);
-        node = node->next;
+        node = static_cast<node_ptr>(node->get_next());
         return *this;
     }
 
@@ -328,7 +381,7 @@ struct ht_const_local_iterator :public MoperSTL::iterator<MoperSTL::forward_iter
 
     self& operator++() {
         MYSTL_DEBUG(node != nullptr);
-        node = node->next;
+        node = static_cast<node_ptr>(node->get_next());
         return *this;
     }
 
@@ -400,6 +453,27 @@ static constexpr size_t ht_prime_list[] = {
 
 #endif
 
+// ʽ rehash ʱÿβǨƵ bucket 
+#ifndef HT_REHASH_STEP
+#define HT_REHASH_STEP 32
+#endif
+
+// ʱÿͬʱļֵ
+#ifndef HT_BATCH_SIZE
+#define HT_BATCH_SIZE 16
+#endif
+
+// Ԥȡ p ڵĻУֻʾӰ
+inline void ht_prefetch(const void* p) noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
 // ҳӽڵ n Ǹ
 inline size_t ht_next_prime(size_t n) {
     const size_t* first = ht_prime_list;
@@ -408,6 +482,86 @@ inline size_t ht_next_prime(size_t n) {
     return pos == last ? *(last - 1) : *pos;
 }
 
+//  ht_prime_list е I ȡģΪڳ仯Ϊ˷λָ
+typedef size_t (*ht_mod_function)(size_t);
+
+template <size_t I>
+size_t ht_prime_mod(size_t h) noexcept {
+    return h % ht_prime_list[I];
+}
+
+template <class Seq>
+struct ht_prime_mod_table;
+
+template <size_t ...I>
+struct ht_prime_mod_table<std::index_sequence<I...>> {
+    static constexpr ht_mod_function value[] = { &ht_prime_mod<I>... };
+};
+
+// bucket ԣ bucket ĸϣֵ bucket ӳ
+// next_size  n Ϊʵʹõ bucket ضӦ״̬commit ֮ index µ bucket 
+
+// ȱʡԣbucket ȡ ht_prime_list еͨԳȡģ
+class ht_prime_bucket_policy {
+public:
+    typedef ht_mod_function state_type;
+
+    static state_type next_size(size_t& n) noexcept {
+        const size_t* last = ht_prime_list + PRIME_NUM;
+        const size_t* pos = MoperSTL::lower_bound(ht_prime_list, last, n);
+        if (pos == last)
+            --pos;
+        n = *pos;
+        return ht_prime_mod_table<std::make_index_sequence<PRIME_NUM>>::value[pos - ht_prime_list];
+    }
+    static size_t max_bucket_count() noexcept { return ht_prime_list[PRIME_NUM - 1]; }
+
+    void   commit(state_type s) noexcept { mod_ = s; }
+    size_t index(size_t h) const noexcept { return mod_(h); }
+
+private:
+    state_type mod_ = &ht_prime_mod<0>;
+};
+
+// 2 ݲԣbucket ȡ 2 ݣȳ 2^64 /  ɢλȡλFibonacci hashing
+// λͬϣָ롢Ϊ 2 ݵҲܾȷֲ 8  bucket
+class ht_power2_bucket_policy {
+public:
+    typedef unsigned state_type;  // ȡλʱƵλ
+
+    static state_type next_size(size_t& n) noexcept {
+        size_t size = 8;
+        unsigned shift = sizeof(size_t) * 8 - 3;
+        while (size < n && size < max_bucket_count()) {
+            size <<= 1;
+            --shift;
+        }
+        n = size;
+        return shift;
+    }
+    static size_t max_bucket_count() noexcept { return (static_cast<size_t>(-1) >> 1) + 1; }
+
+    void   commit(state_type s) noexcept { shift_ = s; }
+    size_t index(size_t h) const noexcept {
+        return (h * static_cast<size_t>(sizeof(size_t) == 8 ? 0x9e3779b97f4a7c15ull : 0x9e3779b9u)) >> shift_;
+    }
+
+private:
+    state_type shift_ = sizeof(size_t) * 8 - 3;
+};
+
+// ϣж bucket_policy ʱʹøòԣʹ ht_prime_bucket_policy磺
+//   struct my_hash { typedef MoperSTL::ht_power2_bucket_policy bucket_policy; size_t operator()(int) const; };
+template <class Hash, class = void>
+struct ht_bucket_policy_of {
+    typedef ht_prime_bucket_policy type;
+};
+
+template <class Hash>
+struct ht_bucket_policy_of<Hash, std::void_t<typename Hash::bucket_policy>> {
+    typedef typename Hash::bucket_policy type;
+};
+
 // ģ hashtable
 // һͣϣֵȵıȽϺ
 template <class T, class Hash, class KeyEqual>
@@ -424,10 +578,12 @@ public:
     typedef typename value_traits::value_type           value_type;
     typedef Hash                                        hasher;
     typedef KeyEqual                                    key_equal;
+    typedef typename ht_bucket_policy_of<Hash>::type    bucket_policy;
 
     typedef hashtable_node<T>                           node_type;
     typedef node_type* node_ptr;
-    typedef MoperSTL::vector<node_ptr>                     bucket_type;
+    typedef hashtable_node_base* base_ptr;
+    typedef MoperSTL::vector<hashtable_bucket>             bucket_type;
 
     typedef MoperSTL::allocator<T>                         allocator_type;
     typedef MoperSTL::allocator<T>                         data_allocator;
@@ -445,24 +601,100 @@ public:
     typedef MoperSTL::ht_local_iterator<T>                 local_iterator;
     typedef MoperSTL::ht_const_local_iterator<T>           const_local_iterator;
 
+    typedef MoperSTL::node_handle<node_type, T>            node_handle_type;
+
     allocator_type get_allocator() const { return allocator_type(); }
 
+    // merge Ҫʹϣͬһű bucket
+    template <class, class, class> friend class hashtable;
+
 private:
-  //  hashtable
+  // ² hashtable
     bucket_type buckets_;
     size_type   bucket_size_;
     size_type   size_;
     float       mlf_;
     hasher      hash_;
     key_equal   equal_;
+    bucket_policy policy_;  // ϣֵ bucket ӳ䣬 bucket һ
+
+    // ȫڵɵĵͷ㣬before_begin_.get_next() Ϊһڵ㣬 bucket ǰΪ &before_begin_
+    hashtable_node_base before_begin_;
+
+    // ʽ rehashʱɱ˺ÿβǨƾɱе bucket
+    // ɱ [0, rehash_idx_)  bucket Ǩϣֵھɱе bucket δǨʱλھɱλ±
+    //  rehash ʱ old_buckets_ Ϊ
+    bucket_type old_buckets_;
+    bucket_policy old_policy_;
+    size_type   rehash_idx_;
+    bool        incremental_;
 
 private:
-    bool is_equal(const key_type& key1, const key_type& key2) {
+    template <class K>
+    bool is_equal(const key_type& key1, const K& key2) const {
         return equal_(key1, key2);
     }
 
-    bool is_equal(const key_type& key1, const key_type& key2) const {
-        return equal_(key1, key2);
+    static node_ptr next_node(const hashtable_node_base* np) noexcept {
+        return static_cast<node_ptr>(np->get_next());
+    }
+
+    // ڵֵĹϣֵڵ㻺˹ϣֵʱֱӶȡ
+    size_type node_code(node_ptr np) const {
+        if constexpr (node_type::cache_hash)
+            return np->hash;
+        else
+            return hash_(value_traits::get_key(np->value));
+    }
+
+    // ɱ± bucket ͳһţ[0, old_buckets_.size()) ΪɱΪ±
+    size_type slot_count() const noexcept {
+        return old_buckets_.size() + bucket_size_;
+    }
+    hashtable_bucket&       slot(size_type pos) noexcept {
+        return pos < old_buckets_.size() ? old_buckets_[pos] : buckets_[pos - old_buckets_.size()];
+    }
+    const hashtable_bucket& slot(size_type pos) const noexcept {
+        return pos < old_buckets_.size() ? old_buckets_[pos] : buckets_[pos - old_buckets_.size()];
+    }
+    // ϣֵΪ code ļֵ bucket ı
+    size_type code_pos(size_type code) const {
+        if (!old_buckets_.empty()) {
+            const size_type n = old_policy_.index(code);
+            if (n >= rehash_idx_)
+                return n;
+        }
+        return old_buckets_.size() + policy_.index(code);
+    }
+    size_type node_pos(node_ptr np) const {
+        return code_pos(node_code(np));
+    }
+    //  pos  bucket ĵһڵ㣬bucket Ϊʱ nullptr
+    node_ptr  bucket_begin(size_type pos) const noexcept {
+        return static_cast<node_ptr>(slot(pos).first);
+    }
+    //  pos  bucket ֮ĵһڵ㣬 bucket βλ
+    node_ptr  bucket_end(size_type pos) const noexcept {
+        node_ptr np = bucket_begin(pos);
+        if (np == nullptr)
+            return nullptr;
+        while (!np->is_last())
+            np = next_node(np);
+        return next_node(np);
+    }
+    void      set_code(node_ptr np, size_type code) const noexcept {
+        if constexpr (node_type::cache_hash)
+            np->hash = code;
+    }
+
+    // ڵļֵǷϣֵΪ code  key ȣڵ㻺˹ϣֵʱȱȽϹϣֵ
+    template <class K>
+    bool node_equal(node_ptr np, const K& key, size_type code) const {
+        if constexpr (node_type::cache_hash) {
+            if (np->hash != code)
+                return false;
+        }
+        return is_equal(value_traits::get_key(np->value), key);
     }
 
     const_iterator M_cit(node_ptr node) const noexcept {
@@ -470,19 +702,11 @@ private:
     }
 
     iterator M_begin() noexcept {
-        for (size_type n = 0; n < bucket_size_; ++n) {
-            if (buckets_[n])  // ҵһнڵλþͷ
-                return iterator(buckets_[n], this);
-        }
-        return iterator(nullptr, this);
+        return iterator(next_node(&before_begin_), this);
     }
 
     const_iterator M_begin() const noexcept {
-        for (size_type n = 0; n < bucket_size_; ++n) {
-            if (buckets_[n])  // ҵһнڵλþͷ
-                return M_cit(buckets_[n]);
-        }
-        return M_cit(nullptr);
+        return M_cit(next_node(&before_begin_));
     }
 
 public:
@@ -490,7 +714,8 @@ public:
     explicit hashtable(size_type bucket_count,
                        const Hash& hash = Hash(),
                        const KeyEqual& equal = KeyEqual())
-        :size_(0), mlf_(1.0f), hash_(hash), equal_(equal) {
+        :size_(0), mlf_(1.0f), hash_(hash), equal_(equal), before_begin_{ 0 },
+        rehash_idx_(0), incremental_(false) {
         init(bucket_count);
     }
 
@@ -501,12 +726,14 @@ public:
               size_type bucket_count,
               const Hash& hash = Hash(),
               const KeyEqual& equal = KeyEqual())
-        : size_(MoperSTL::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal) {
+        : size_(MoperSTL::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal),
+        before_begin_{ 0 }, rehash_idx_(0), incremental_(false) {
         init(MoperSTL::max(bucket_count, static_cast<size_type>(MoperSTL::distance(first, last))));
     }
 
     hashtable(const hashtable& rhs)
-        :hash_(rhs.hash_), equal_(rhs.equal_) {
+        :hash_(rhs.hash_), equal_(rhs.equal_), policy_(rhs.policy_), before_begin_{ 0 },
+        old_policy_(rhs.old_policy_), rehash_idx_(0), incremental_(rhs.incremental_) {
         copy_init(rhs);
     }
     hashtable(hashtable&& rhs) noexcept
@@ -514,9 +741,18 @@ public:
         size_(rhs.size_),
         mlf_(rhs.mlf_),
         hash_(rhs.hash_),
-        equal_(rhs.equal_) {
+        equal_(rhs.equal_),
+        policy_(rhs.policy_),
+        before_begin_{ rhs.before_begin_.next_last },
+        old_policy_(rhs.old_policy_),
+        rehash_idx_(rhs.rehash_idx_),
+        incremental_(rhs.incremental_) {
         buckets_ = MoperSTL::move(rhs.buckets_);
+        old_buckets_ = MoperSTL::move(rhs.old_buckets_);
+        fix_front_bucket();
+        rhs.before_begin_.next_last = 0;
         rhs.bucket_size_ = 0;
+        rhs.rehash_idx_ = 0;
         rhs.size_ = 0;
         rhs.mlf_ = 0.0f;
     }
@@ -621,6 +857,34 @@ public:
         copy_insert_unique(first, last, iterator_category(first));
     }
 
+    // ڵ
+
+    // ѽڵӱժ½ͷŽڵ㣻key ʱؿվ
+    node_handle_type extract(const_iterator position) {
+        return node_handle_type(unlink_node(position.node));
+    }
+    node_handle_type extract(const key_type& key) {
+        node_ptr np = find_node(key);
+        return np == nullptr ? node_handle_type() : node_handle_type(unlink_node(np));
+    }
+
+    // ѾеĽڵӽУֵѴڣΪգʱʧܣڵھ
+    pair<iterator, bool> insert_unique(node_handle_type&& nh);
+    iterator             insert_multi(node_handle_type&& nh);
+
+    iterator insert_unique_use_hint(const_iterator /*hint*/, node_handle_type&& nh) {
+        return insert_unique(MoperSTL::move(nh)).first;
+    }
+    iterator insert_multi_use_hint(const_iterator /*hint*/, node_handle_type&& nh) {
+        return insert_multi(MoperSTL::move(nh));
+    }
+
+    //  src ĽڵժӽԪأmerge_unique  src мֵѴڵĽڵ
+    template <class Hash2, class KeyEqual2>
+    void merge_unique(hashtable<T, Hash2, KeyEqual2>& src);
+    template <class Hash2, class KeyEqual2>
+    void merge_multi(hashtable<T, Hash2, KeyEqual2>& src);
+
 // erase / clear
 
     void      erase(const_iterator position);
@@ -635,10 +899,10 @@ public:
 
     // ز
 
-    size_type                            count(const key_type& key) const;
+    size_type      count(const key_type& key) const { return count_key(key); }
 
-    iterator                             find(const key_type& key);
-    const_iterator                       find(const key_type& key) const;
+    iterator       find(const key_type& key)       { return iterator(find_node(key), this); }
+    const_iterator find(const key_type& key) const { return M_cit(find_node(key)); }
 
     pair<iterator, iterator>             equal_range_multi(const key_type& key);
     pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const;
@@ -646,39 +910,98 @@ public:
     pair<iterator, iterator>             equal_range_unique(const key_type& key);
     pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const;
 
+    // 칹ң Hash  KeyEqual  is_transparent ʱ
+    // Եȼ۵ĲһµĽ hash<string>  equal_to<void>
+
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    size_type      count(const K& key) const { return count_key(key); }
+
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    iterator       find(const K& key)       { return iterator(find_node(key), this); }
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    const_iterator find(const K& key) const { return M_cit(find_node(key)); }
+
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<iterator, iterator> equal_range_multi(const K& key) {
+        auto p = equal_range_node(key);
+        return MoperSTL::make_pair(iterator(p.first, this), iterator(p.second, this));
+    }
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<const_iterator, const_iterator> equal_range_multi(const K& key) const {
+        auto p = equal_range_node(key);
+        return MoperSTL::make_pair(M_cit(p.first), M_cit(p.second));
+    }
+
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<iterator, iterator> equal_range_unique(const K& key) {
+        return equal_range_multi(key);
+    }
+    template <class K, class H = Hash, class E = KeyEqual, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<const_iterator, const_iterator> equal_range_unique(const K& key) const {
+        return equal_range_multi(key);
+    }
+
+    // ң[first, last) Ϊֵǰ䣬˳ out дÿֵĲҽ
+    // ÿ HT_BATCH_SIZE ֵΪһ飺ȼϣֵԤȡ bucketԤȡ bucket ĵһڵ㣬Ƚϣ
+    // βҵķô໥صεȴ
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) {
+        lookup_batch(first, last, [&](node_ptr np) { *out = iterator(np, this); ++out; });
+        return out;
+    }
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const {
+        lookup_batch(first, last, [&](node_ptr np) { *out = M_cit(np); ++out; });
+        return out;
+    }
+    template <class ForwardIter, class OutputIter>
+    OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const {
+        lookup_batch(first, last, [&](node_ptr np) { *out = np != nullptr; ++out; });
+        return out;
+    }
+
     // bucket interface
+    // ʽ rehash ʱbucket ɱ±еȫ bucket
 
+    // ͬһ bucket Ľڵڣend(n) Ϊ bucket ֮ĵһڵ㣬Ҫ bucket õ
     local_iterator       begin(size_type n)        noexcept {
-        MYSTL_DEBUG(n < size_);
-        return buckets_[n];
+        MYSTL_DEBUG(n < slot_count());
+        return bucket_begin(n);
     }
     const_local_iterator begin(size_type n)  const noexcept {
-        MYSTL_DEBUG(n < size_);
-        return buckets_[n];
+        MYSTL_DEBUG(n < slot_count());
+        return bucket_begin(n);
     }
     const_local_iterator cbegin(size_type n) const noexcept {
-        MYSTL_DEBUG(n < size_);
-        return buckets_[n];
+        MYSTL_DEBUG(n < slot_count());
+        return bucket_begin(n);
     }
 
     local_iterator       end(size_type n)          noexcept {
-        MYSTL_DEBUG(n < size_);
-        return nullptr;
+        MYSTL_DEBUG(n < slot_count());
+        return bucket_end(n);
     }
     const_local_iterator end(size_type n)    const noexcept {
-        MYSTL_DEBUG(n < size_);
-        return nullptr;
+        MYSTL_DEBUG(n < slot_count());
+        return bucket_end(n);
     }
     const_local_iterator cend(size_type n)   const noexcept {
-        MYSTL_DEBUG(n < size_);
-        return nullptr;
+        MYSTL_DEBUG(n < slot_count());
+        return bucket_end(n);
     }
 
     size_type bucket_count()                 const noexcept {
-        return bucket_size_;
+        return slot_count();
     }
     size_type max_bucket_count()             const noexcept {
-        return ht_prime_list[PRIME_NUM - 1];
+        return bucket_policy::max_bucket_count();
     }
 
     size_type bucket_size(size_type n)       const noexcept;
@@ -700,12 +1023,27 @@ public:
         mlf_ = ml;
     }
 
+    // rehash  reserve һɣɽеĽʽ rehash
     void rehash(size_type count);
 
     void reserve(size_type count) {
         rehash(static_cast<size_type>((float)count / max_load_factor() + 0.5f));
     }
 
+    // ʽ rehashȱʡر
+    // ֻ±֮ÿβǨƾɱе HT_REHASH_STEP  bucket
+    // һβƶȫԪأҰֵڵ bucket ǷǨƣֻʾɱ±֮һ
+    // رʱɽеǨƣrehashreserve  clear ͬǨƣ
+    // 뽻ͬǨƽһơǨ
+    bool incremental_rehash() const noexcept {
+        return incremental_;
+    }
+    void incremental_rehash(bool on) {
+        if (!on)
+            finish_rehash();
+        incremental_ = on;
+    }
+
     hasher    hash_fcn() const { return hash_; }
     key_equal key_eq()   const { return equal_; }
 
@@ -722,10 +1060,25 @@ private:
     void      destroy_node(node_ptr n);
 
     // hash
-    size_type next_size(size_type n) const;
-    size_type hash(const key_type& key, size_type n) const;
-    size_type hash(const key_type& key) const;
+    template <class K>
+    size_type hash(const K& key) const;
     void      rehash_if_need(size_type n);
+    void      start_rehash(size_type count);
+    void      rehash_step(size_type max_buckets);
+    void      finish_rehash() {
+        if (!old_buckets_.empty())
+            rehash_step(old_buckets_.size());
+    }
+
+    // lookupK Ϊ key_type ͸ϣɽܵ
+    template <class K>
+    node_ptr  find_node(const K& key) const;
+    template <class K>
+    size_type count_key(const K& key) const;
+    template <class K>
+    pair<node_ptr, node_ptr> equal_range_node(const K& key) const;
+    template <class ForwardIter, class Function>
+    void      lookup_batch(ForwardIter first, ForwardIter last, Function f) const;
 
     // insert
     template <class InputIter>
@@ -741,10 +1094,25 @@ private:
     pair<iterator, bool> insert_node_unique(node_ptr np);
     iterator             insert_node_multi(node_ptr np);
 
+    // ѽڵڵ bucket ժ£
+    node_ptr             unlink_node(node_ptr np);
+
+    // list operator
+    template <class K>
+    node_ptr find_in_bucket(size_type n, const K& key, size_type code, base_ptr* before = nullptr) const;
+    base_ptr node_before(node_ptr np, size_type n) const;
+    void     link_front(node_ptr np, size_type n);
+    void     link_after(node_ptr prev, node_ptr np, size_type n);
+    void     remove_node(base_ptr prev, node_ptr np, size_type n);
+    void     relink_chain(node_ptr first);
+    void     clear_buckets() noexcept;
+    void     fix_front_bucket() noexcept {
+        if (before_begin_.get_next())
+            slot(node_pos(next_node(&before_begin_))).before = &before_begin_;
+    }
+
     // bucket operator
-    void replace_bucket(size_type bucket_count);
-    void erase_bucket(size_type n, node_ptr first, node_ptr last);
-    void erase_bucket(size_type n, node_ptr last);
+    void replace_bucket(size_type bucket_count, typename bucket_policy::state_type state);
 
     // comparision
     bool equal_to_multi(const hashtable& other);
@@ -784,8 +1152,7 @@ hashtable<T, Hash, KeyEqual>::
 emplace_multi(Args&& ...args) {
     auto np = create_node(MoperSTL::forward<Args>(args)...);
     try {
-        if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
-            rehash(size_ + 1);
+        rehash_if_need(1);
     } catch (...) {
         destroy_node(np);
         throw;
@@ -802,8 +1169,7 @@ hashtable<T, Hash, KeyEqual>::
 emplace_unique(Args&& ...args) {
     auto np = create_node(MoperSTL::forward<Args>(args)...);
     try {
-        if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
-            rehash(size_ + 1);
+        rehash_if_need(1);
     } catch (...) {
         destroy_node(np);
         throw;
@@ -816,16 +1182,14 @@ template <class T, class Hash, class KeyEqual>
 pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
 hashtable<T, Hash, KeyEqual>::
 insert_unique_noresize(const value_type& value) {
-    const auto n = hash(value_traits::get_key(value));
-    auto first = buckets_[n];
-    for (auto cur = first; cur; cur = cur->next) {
-        if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(value)))
-            return MoperSTL::make_pair(iterator(cur, this), false);
-    }
-    // ½ڵΪĵһڵ
+    const size_type code = hash_(value_traits::get_key(value));
+    const auto n = code_pos(code);
+    if (node_ptr np = find_in_bucket(n, value_traits::get_key(value), code))
+        return MoperSTL::make_pair(iterator(np, this), false);
+    // ½ڵΪ bucket ĵһڵ
     auto tmp = create_node(value);
-    tmp->next = first;
-    buckets_[n] = tmp;
+    set_code(tmp, code);
+    link_front(tmp, n);
     ++size_;
     return MoperSTL::make_pair(iterator(tmp, this), true);
 }
@@ -835,20 +1199,14 @@ template <class T, class Hash, class KeyEqual>
 typename hashtable<T, Hash, KeyEqual>::iterator
 hashtable<T, Hash, KeyEqual>::
 insert_multi_noresize(const value_type& value) {
-    const auto n = hash(value_traits::get_key(value));
-    auto first = buckets_[n];
+    const size_type code = hash_(value_traits::get_key(value));
+    const auto n = code_pos(code);
     auto tmp = create_node(value);
-    for (auto cur = first; cur; cur = cur->next) {
-        if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(value))) { // дֵͬĽڵϲ룬Ȼ󷵻
-            tmp->next = cur->next;
-            cur->next = tmp;
-            ++size_;
-            return iterator(tmp, this);
-        }
-    }
-    // ͷ
-    tmp->next = first;
-    buckets_[n] = tmp;
+    set_code(tmp, code);
+    if (node_ptr np = find_in_bucket(n, value_traits::get_key(value), code)) // ֵͬĽڵͲ
+        link_after(np, tmp, n);
+    else //  bucket ͷ
+        link_front(tmp, n);
     ++size_;
     return iterator(tmp, this);
 }
@@ -859,52 +1217,31 @@ void hashtable<T, Hash, KeyEqual>::
 erase(const_iterator position) {
     auto p = position.node;
     if (p) {
-        const auto n = hash(value_traits::get_key(p->value));
-        auto cur = buckets_[n];
-        if (cur == p) { // p λͷ
-            buckets_[n] = cur->next;
-            destroy_node(cur);
-            --size_;
-        } else {
-            auto next = cur->next;
-            while (next) {
-                if (next == p) {
-                    cur->next = next->next;
-                    destroy_node(next);
-                    --size_;
-                    break;
-                } else {
-                    cur = next;
-                    next = cur->next;
-                }
-            }
-        }
+        const auto n = node_pos(p);
+        remove_node(node_before(p, n), p, n);
+        destroy_node(p);
+        --size_;
     }
 }
 
-// ɾ[first, last)ڵĽڵ
+// ɾ[first, last)ڵĽڵ㣬ڵĽڵǰʼղ
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 erase(const_iterator first, const_iterator last) {
     if (first.node == last.node)
         return;
-    auto first_bucket = first.node
-        ? hash(value_traits::get_key(first.node->value))
-        : bucket_size_;
-    auto last_bucket = last.node
-        ? hash(value_traits::get_key(last.node->value))
-        : bucket_size_;
-    if (first_bucket == last_bucket) { //  bucket ͬһλ
-        erase_bucket(first_bucket, first.node, last.node);
-    } else {
-        erase_bucket(first_bucket, first.node, nullptr);
-        for (auto n = first_bucket + 1; n < last_bucket; ++n) {
-            if (buckets_[n] != nullptr)
-                erase_bucket(n, nullptr);
-        }
-        if (last_bucket != bucket_size_) {
-            erase_bucket(last_bucket, last.node);
-        }
+    node_ptr np = first.node;
+    size_type n = node_pos(np);
+    const base_ptr prev = node_before(np, n);
+    while (true) {
+        const node_ptr next = next_node(np);
+        remove_node(prev, np, n);
+        destroy_node(np);
+        --size_;
+        if (next == last.node)
+            break;
+        np = next;
+        n = node_pos(np);
     }
 }
 
@@ -915,8 +1252,9 @@ hashtable<T, Hash, KeyEqual>::
 erase_multi(const key_type& key) {
     auto p = equal_range_multi(key);
     if (p.first.node != nullptr) {
+        size_type n = MoperSTL::distance(p.first, p.second);
         erase(p.first, p.second);
-        return MoperSTL::distance(p.first, p.second);
+        return n;
     }
     return 0;
 }
@@ -925,27 +1263,14 @@ template <class T, class Hash, class KeyEqual>
 typename hashtable<T, Hash, KeyEqual>::size_type
 hashtable<T, Hash, KeyEqual>::
 erase_unique(const key_type& key) {
-    const auto n = hash(key);
-    auto first = buckets_[n];
-    if (first) {
-        if (is_equal(value_traits::get_key(first->value), key)) {
-            buckets_[n] = first->next;
-            destroy_node(first);
-            --size_;
-            return 1;
-        } else {
-            auto next = first->next;
-            while (next) {
-                if (is_equal(value_traits::get_key(next->value), key)) {
-                    first->next = next->next;
-                    destroy_node(next);
-                    --size_;
-                    return 1;
-                }
-                first = next;
-                next = first->next;
-            }
-        }
+    const size_type code = hash_(key);
+    const auto n = code_pos(code);
+    base_ptr prev = nullptr;
+    if (node_ptr np = find_in_bucket(n, key, code, &prev)) {
+        remove_node(prev, np, n);
+        destroy_node(np);
+        --size_;
+        return 1;
     }
     return 0;
 }
@@ -955,16 +1280,15 @@ template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 clear() {
     if (size_ != 0) {
-        for (size_type i = 0; i < bucket_size_; ++i) {
-            node_ptr cur = buckets_[i];
-            while (cur != nullptr) {
-                node_ptr next = cur->next;
-                destroy_node(cur);
-                cur = next;
-            }
-            buckets_[i] = nullptr;
+        for (node_ptr cur = next_node(&before_begin_); cur != nullptr;) {
+            node_ptr next = next_node(cur);
+            destroy_node(cur);
+            cur = next;
         }
         size_ = 0;
+        clear_buckets();
+    } else if (!old_buckets_.empty()) {  // ɱѿգҪǨ
+        clear_buckets();
     }
 }
 
@@ -974,7 +1298,7 @@ typename hashtable<T, Hash, KeyEqual>::size_type
 hashtable<T, Hash, KeyEqual>::
 bucket_size(size_type n) const noexcept {
     size_type result = 0;
-    for (auto cur = buckets_[n]; cur; cur = cur->next) {
+    for (auto cur = bucket_begin(n); cur; cur = cur->is_last() ? nullptr : next_node(cur)) {
         ++result;
     }
     return result;
@@ -984,74 +1308,70 @@ bucket_size(size_type n) const noexcept {
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 rehash(size_type count) {
-    auto n = ht_next_prime(count);
+    finish_rehash();
+    size_type n = count;
+    const auto state = bucket_policy::next_size(n);
     if (n > bucket_size_) {
-        replace_bucket(n);
+        replace_bucket(n, state);
     } else {
         if ((float)size_ / (float)n < max_load_factor() - 0.25f &&
             (float)n < (float)bucket_size_ * 0.75)  // worth rehash
         {
-            replace_bucket(n);
+            replace_bucket(n, state);
         }
     }
 }
 
-// ҼֵΪ key Ľڵ㣬
+// ҼֵΪ key Ľڵ㣬Ҳʱ nullptr
 template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
+template <class K>
+typename hashtable<T, Hash, KeyEqual>::node_ptr
 hashtable<T, Hash, KeyEqual>::
-find(const key_type& key) {
-    const auto n = hash(key);
-    node_ptr first = buckets_[n];
-    for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
-    return iterator(first, this);
+find_node(const K& key) const {
+    const size_type code = hash_(key);
+    return find_in_bucket(code_pos(code), key, code);
 }
 
+// ҼֵΪ key ֵĴֵȵĽڵ
 template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::const_iterator
+template <class K>
+typename hashtable<T, Hash, KeyEqual>::size_type
 hashtable<T, Hash, KeyEqual>::
-find(const key_type& key) const {
-    const auto n = hash(key);
-    node_ptr first = buckets_[n];
-    for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
-    return M_cit(first);
+count_key(const K& key) const {
+    const size_type code = hash_(key);
+    node_ptr cur = find_in_bucket(code_pos(code), key, code);
+    if (cur == nullptr)
+        return 0;
+    size_type result = 1;
+    for (; !cur->is_last() && node_equal(next_node(cur), key, code); cur = next_node(cur))
+        ++result;
+    return result;
 }
 
-// ҼֵΪ key ֵĴ
+// ֵ key ȵ䣬һ pairָβڵ
 template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
-count(const key_type& key) const {
-    const auto n = hash(key);
-    size_type result = 0;
-    for (node_ptr cur = buckets_[n]; cur; cur = cur->next) {
-        if (is_equal(value_traits::get_key(cur->value), key))
-            ++result;
-    }
-    return result;
+template <class K>
+pair<typename hashtable<T, Hash, KeyEqual>::node_ptr,
+    typename hashtable<T, Hash, KeyEqual>::node_ptr>
+    hashtable<T, Hash, KeyEqual>::
+    equal_range_node(const K& key) const {
+    const size_type code = hash_(key);
+    const node_ptr first = find_in_bucket(code_pos(code), key, code);
+    if (first == nullptr)
+        return MoperSTL::make_pair(node_ptr(nullptr), node_ptr(nullptr));
+    node_ptr second = first;
+    while (!second->is_last() && node_equal(next_node(second), key, code))
+        second = next_node(second);
+    return MoperSTL::make_pair(first, next_node(second));
 }
 
-// ֵ key ȵ䣬һ pairָβ
 template <class T, class Hash, class KeyEqual>
 pair<typename hashtable<T, Hash, KeyEqual>::iterator,
     typename hashtable<T, Hash, KeyEqual>::iterator>
     hashtable<T, Hash, KeyEqual>::
     equal_range_multi(const key_type& key) {
-    const auto n = hash(key);
-    for (node_ptr first = buckets_[n]; first; first = first->next) {
-        if (is_equal(value_traits::get_key(first->value), key)) { // ȵļֵ
-            for (node_ptr second = first->next; second; second = second->next) {
-                if (!is_equal(value_traits::get_key(second->value), key))
-                    return MoperSTL::make_pair(iterator(first, this), iterator(second, this));
-            }
-            for (auto m = n + 1; m < bucket_size_; ++m) { // ȣһֵλ
-                if (buckets_[m])
-                    return MoperSTL::make_pair(iterator(first, this), iterator(buckets_[m], this));
-            }
-            return MoperSTL::make_pair(iterator(first, this), end());
-        }
-    }
-    return MoperSTL::make_pair(end(), end());
+    auto p = equal_range_node(key);
+    return MoperSTL::make_pair(iterator(p.first, this), iterator(p.second, this));
 }
 
 template <class T, class Hash, class KeyEqual>
@@ -1059,21 +1379,8 @@ pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
     typename hashtable<T, Hash, KeyEqual>::const_iterator>
     hashtable<T, Hash, KeyEqual>::
     equal_range_multi(const key_type& key) const {
-    const auto n = hash(key);
-    for (node_ptr first = buckets_[n]; first; first = first->next) {
-        if (is_equal(value_traits::get_key(first->value), key)) {
-            for (node_ptr second = first->next; second; second = second->next) {
-                if (!is_equal(value_traits::get_key(second->value), key))
-                    return MoperSTL::make_pair(M_cit(first), M_cit(second));
-            }
-            for (auto m = n + 1; m < bucket_size_; ++m) { // ȣһֵλ
-                if (buckets_[m])
-                    return MoperSTL::make_pair(M_cit(first), M_cit(buckets_[m]));
-            }
-            return MoperSTL::make_pair(M_cit(first), cend());
-        }
-    }
-    return MoperSTL::make_pair(cend(), cend());
+    auto p = equal_range_node(key);
+    return MoperSTL::make_pair(M_cit(p.first), M_cit(p.second));
 }
 
 template <class T, class Hash, class KeyEqual>
@@ -1081,18 +1388,8 @@ pair<typename hashtable<T, Hash, KeyEqual>::iterator,
     typename hashtable<T, Hash, KeyEqual>::iterator>
     hashtable<T, Hash, KeyEqual>::
     equal_range_unique(const key_type& key) {
-    const auto n = hash(key);
-    for (node_ptr first = buckets_[n]; first; first = first->next) {
-        if (is_equal(value_traits::get_key(first->value), key)) {
-            if (first->next)
-                return MoperSTL::make_pair(iterator(first, this), iterator(first->next, this));
-            for (auto m = n + 1; m < bucket_size_; ++m) { // ȣһֵλ
-                if (buckets_[m])
-                    return MoperSTL::make_pair(iterator(first, this), iterator(buckets_[m], this));
-            }
-            return MoperSTL::make_pair(iterator(first, this), end());
-        }
-    }
+    if (node_ptr np = find_node(key))
+        return MoperSTL::make_pair(iterator(np, this), iterator(next_node(np), this));
     return MoperSTL::make_pair(end(), end());
 }
 
@@ -1101,22 +1398,105 @@ pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
     typename hashtable<T, Hash, KeyEqual>::const_iterator>
     hashtable<T, Hash, KeyEqual>::
     equal_range_unique(const key_type& key) const {
-    const auto n = hash(key);
-    for (node_ptr first = buckets_[n]; first; first = first->next) {
-        if (is_equal(value_traits::get_key(first->value), key)) {
-            if (first->next)
-                return MoperSTL::make_pair(M_cit(first), M_cit(first->next));
-            for (auto m = n + 1; m < bucket_size_; ++m) { // ȣһֵλ
-                if (buckets_[m])
-                    return MoperSTL::make_pair(M_cit(first), M_cit(buckets_[m]));
-            }
-            return MoperSTL::make_pair(M_cit(first), cend());
+    if (node_ptr np = find_node(key))
+        return MoperSTL::make_pair(M_cit(np), M_cit(next_node(np)));
+    return MoperSTL::make_pair(cend(), cend());
+}
+
+// ңÿֵӦĽڵ㣨ҲʱΪ nullptr f
+template <class T, class Hash, class KeyEqual>
+template <class ForwardIter, class Function>
+void hashtable<T, Hash, KeyEqual>::
+lookup_batch(ForwardIter first, ForwardIter last, Function f) const {
+    size_type code[HT_BATCH_SIZE];
+    size_type pos[HT_BATCH_SIZE];
+    while (first != last) {
+        ForwardIter group = first;
+        size_type n = 0;
+        for (; n < HT_BATCH_SIZE && first != last; ++n, ++first) {
+            code[n] = hash_(*first);
+            pos[n] = code_pos(code[n]);
+            ht_prefetch(&slot(pos[n]));
+        }
+        for (size_type i = 0; i < n; ++i) {
+            if (const base_ptr np = slot(pos[i]).first)
+                ht_prefetch(np);
         }
+        for (size_type i = 0; i < n; ++i, ++group)
+            f(find_in_bucket(pos[i], *group, code[i]));
+    }
+}
+
+// ڵеĽڵ㣬ֵظ
+template <class T, class Hash, class KeyEqual>
+pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
+hashtable<T, Hash, KeyEqual>::
+insert_unique(node_handle_type&& nh) {
+    if (nh.empty())
+        return MoperSTL::make_pair(end(), false);
+    rehash_if_need(1);
+    auto res = insert_node_unique(nh.node_);
+    if (res.second)
+        nh.release();
+    return res;
+}
+
+// ڵеĽڵ㣬ֵظ
+template <class T, class Hash, class KeyEqual>
+typename hashtable<T, Hash, KeyEqual>::iterator
+hashtable<T, Hash, KeyEqual>::
+insert_multi(node_handle_type&& nh) {
+    if (nh.empty())
+        return end();
+    rehash_if_need(1);
+    return insert_node_multi(nh.release());
+}
+
+// ϲ src Ľڵ㣬ֵظ
+// ժ½ڵ㣬ʧʱڵ src 
+template <class T, class Hash, class KeyEqual>
+template <class Hash2, class KeyEqual2>
+void hashtable<T, Hash, KeyEqual>::
+merge_unique(hashtable<T, Hash2, KeyEqual2>& src) {
+    if (static_cast<void*>(&src) == static_cast<void*>(this))
+        return;
+    base_ptr prev = &src.before_begin_;
+    while (prev->get_next()) {
+        node_ptr cur = next_node(prev);
+        if (find_node(value_traits::get_key(cur->value)) != nullptr) {
+            prev = cur;
+        } else {
+            rehash_if_need(1);
+            src.remove_node(prev, cur, src.node_pos(cur));
+            --src.size_;
+            cur->set_link(nullptr, false);
+            insert_node_unique(cur);
+        }
+    }
+}
+
+// ϲ src ȫڵ㣬ֵظ
+template <class T, class Hash, class KeyEqual>
+template <class Hash2, class KeyEqual2>
+void hashtable<T, Hash, KeyEqual>::
+merge_multi(hashtable<T, Hash2, KeyEqual2>& src) {
+    if (static_cast<void*>(&src) == static_cast<void*>(this))
+        return;
+    rehash_if_need(src.size_);
+    node_ptr cur = next_node(&src.before_begin_);
+    src.size_ = 0;
+    src.clear_buckets();
+    while (cur) {
+        node_ptr next = next_node(cur);
+        cur->set_link(nullptr, false);
+        insert_node_multi(cur);
+        cur = next;
     }
-    return MoperSTL::make_pair(cend(), cend());
 }
 
 //  hashtable
+// һڵڵ bucket  &before_begin_ҪΪָ򱾱ͷ
+// еĽʽ rehash ɱǨƽһ𽻻ڴɣΪ O(1)
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 swap(hashtable& rhs) noexcept {
@@ -1127,6 +1507,14 @@ swap(hashtable& rhs) noexcept {
         MoperSTL::swap(mlf_, rhs.mlf_);
         MoperSTL::swap(hash_, rhs.hash_);
         MoperSTL::swap(equal_, rhs.equal_);
+        MoperSTL::swap(policy_, rhs.policy_);
+        MoperSTL::swap(before_begin_.next_last, rhs.before_begin_.next_last);
+        old_buckets_.swap(rhs.old_buckets_);
+        MoperSTL::swap(old_policy_, rhs.old_policy_);
+        MoperSTL::swap(rehash_idx_, rhs.rehash_idx_);
+        MoperSTL::swap(incremental_, rhs.incremental_);
+        fix_front_bucket();
+        rhs.fix_front_bucket();
     }
 }
 
@@ -1137,10 +1525,11 @@ swap(hashtable& rhs) noexcept {
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 init(size_type n) {
-    const auto bucket_nums = next_size(n);
+    size_type bucket_nums = n;
+    policy_.commit(bucket_policy::next_size(bucket_nums));
     try {
         buckets_.reserve(bucket_nums);
-        buckets_.assign(bucket_nums, nullptr);
+        buckets_.assign(bucket_nums, hashtable_bucket());
     } catch (...) {
         bucket_size_ = 0;
         size_ = 0;
@@ -1150,28 +1539,36 @@ init(size_type n) {
 }
 
 // copy_init 
+// ˳ƽڵ㣬bucket  ht ͬÿ bucket һγʱβڵǰβҲ ht ͬ
+// ht ڽʽ rehash ʱƳıͬľɱǨƽȣ֮ĲǨ
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 copy_init(const hashtable& ht) {
-    bucket_size_ = 0;
+    size_ = 0;
+    mlf_ = ht.mlf_;
     buckets_.reserve(ht.bucket_size_);
-    buckets_.assign(ht.bucket_size_, nullptr);
+    buckets_.assign(ht.bucket_size_, hashtable_bucket());
+    bucket_size_ = ht.bucket_size_;
+    if (!ht.old_buckets_.empty()) {  //  ht ͬǨƽ
+        old_buckets_.assign(ht.old_buckets_.size(), hashtable_bucket());
+        rehash_idx_ = ht.rehash_idx_;
+    }
     try {
-        for (size_type i = 0; i < ht.bucket_size_; ++i) {
-            node_ptr cur = ht.buckets_[i];
-            if (cur) { // ĳ bucket 
-                auto copy = create_node(cur->value);
-                buckets_[i] = copy;
-                for (auto next = cur->next; next; cur = next, next = cur->next) {  //
-                    copy->next = create_node(next->value);
-                    copy = copy->next;
-                }
-                copy->next = nullptr;
+        base_ptr tail = &before_begin_;
+        for (node_ptr cur = next_node(&ht.before_begin_); cur; cur = next_node(cur)) {
+            node_ptr copy = create_node(cur->value);
+            const size_type code = ht.node_code(cur);
+            set_code(copy, code);
+            copy->set_last(cur->is_last());
+            tail->set_next(copy);
+            hashtable_bucket& b = slot(code_pos(code));
+            if (b.first == nullptr) {
+                b.before = tail;
+                b.first = copy;
             }
+            tail = copy;
+            ++size_;
         }
-        bucket_size_ = ht.bucket_size_;
-        mlf_ = ht.mlf_;
-        size_ = ht.size_;
     } catch (...) {
         clear();
     }
@@ -1186,7 +1583,7 @@ create_node(Args&& ...args) {
     node_ptr tmp = node_allocator::allocate(1);
     try {
         data_allocator::construct(MoperSTL::addressof(tmp->value), MoperSTL::forward<Args>(args)...);
-        tmp->next = nullptr;
+        tmp->set_link(nullptr, false);
     } catch (...) {
         node_allocator::deallocate(tmp);
         throw;
@@ -1203,34 +1600,79 @@ destroy_node(node_ptr node) {
     node = nullptr;
 }
 
-// next_size 
+// hash  bucket ԰ѹϣֵӳ䵽 bucketʱ
 template <class T, class Hash, class KeyEqual>
+template <class K>
 typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::next_size(size_type n) const {
-    return ht_next_prime(n);
+hashtable<T, Hash, KeyEqual>::
+hash(const K& key) const {
+    return code_pos(hash_(key));
 }
 
-// hash 
+// rehash_if_need 
+// ʽ rehash ʱֻ±еǨÿƽһ
 template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
-hash(const key_type& key, size_type n) const {
-    return hash_(key) % n;
+void hashtable<T, Hash, KeyEqual>::
+rehash_if_need(size_type n) {
+    if (!old_buckets_.empty())
+        rehash_step(HT_REHASH_STEP);
+    if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor()) {
+        if (incremental_)
+            start_rehash(size_ + n);
+        else
+            rehash(size_ + n);
+    }
 }
 
+// start_rehash 
+// ±ԭеıΪɱڵԭȴǨ
 template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
-hash(const key_type& key) const {
-    return hash_(key) % bucket_size_;
+void hashtable<T, Hash, KeyEqual>::
+start_rehash(size_type count) {
+    finish_rehash();  // һǨδʱ޺СһβԪأһ
+    size_type n = count;
+    const auto state = bucket_policy::next_size(n);
+    if (n <= bucket_size_)
+        return;
+    bucket_type bucket(n);
+    old_buckets_.swap(buckets_);
+    buckets_.swap(bucket);
+    old_policy_ = policy_;
+    policy_.commit(state);
+    bucket_size_ = n;
+    rehash_idx_ = 0;
+    rehash_step(HT_REHASH_STEP);
 }
 
-// rehash_if_need 
+// rehash_step 
+// Ѿɱд rehash_idx_ ʼ max_buckets  bucket ǨƵ±ɱǨϺͷ
+// ÿ bucket ĽڵһΣժºӵ±
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
-rehash_if_need(size_type n) {
-    if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor())
-        rehash(size_ + n);
+rehash_step(size_type max_buckets) {
+    const size_type old_count = old_buckets_.size();
+    for (; max_buckets > 0 && rehash_idx_ < old_count; --max_buckets) {
+        const base_ptr prev = old_buckets_[rehash_idx_].before;
+        if (prev == nullptr) {
+            ++rehash_idx_;
+            continue;
+        }
+        const node_ptr first = static_cast<node_ptr>(old_buckets_[rehash_idx_].first);
+        node_ptr last = first;
+        while (!last->is_last())
+            last = next_node(last);
+        const node_ptr after = next_node(last);
+        prev->set_next(after);
+        if (after)  // ֮ bucket ǰ last Ϊ prev
+            slot(node_pos(after)).before = prev;
+        last->set_link(nullptr, false);
+        old_buckets_[rehash_idx_++] = hashtable_bucket();
+        relink_chain(first);
+    }
+    if (rehash_idx_ == old_count) {
+        bucket_type().swap(old_buckets_);
+        rehash_idx_ = 0;
+    }
 }
 
 // copy_insert
@@ -1277,23 +1719,13 @@ template <class T, class Hash, class KeyEqual>
 typename hashtable<T, Hash, KeyEqual>::iterator
 hashtable<T, Hash, KeyEqual>::
 insert_node_multi(node_ptr np) {
-    const auto n = hash(value_traits::get_key(np->value));
-    auto cur = buckets_[n];
-    if (cur == nullptr) {
-        buckets_[n] = np;
-        ++size_;
-        return iterator(np, this);
-    }
-    for (; cur; cur = cur->next) {
-        if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value))) {
-            np->next = cur->next;
-            cur->next = np;
-            ++size_;
-            return iterator(np, this);
-        }
-    }
-    np->next = buckets_[n];
-    buckets_[n] = np;
+    const size_type code = hash_(value_traits::get_key(np->value));
+    const auto n = code_pos(code);
+    set_code(np, code);
+    if (node_ptr cur = find_in_bucket(n, value_traits::get_key(np->value), code))
+        link_after(cur, np, n);
+    else
+        link_front(np, n);
     ++size_;
     return iterator(np, this);
 }
@@ -1303,88 +1735,182 @@ template <class T, class Hash, class KeyEqual>
 pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
 hashtable<T, Hash, KeyEqual>::
 insert_node_unique(node_ptr np) {
-    const auto n = hash(value_traits::get_key(np->value));
-    auto cur = buckets_[n];
-    if (cur == nullptr) {
-        buckets_[n] = np;
-        ++size_;
-        return MoperSTL::make_pair(iterator(np, this), true);
-    }
-    for (; cur; cur = cur->next) {
-        if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value))) {
-            return MoperSTL::make_pair(iterator(cur, this), false);
-        }
-    }
-    np->next = buckets_[n];
-    buckets_[n] = np;
+    const size_type code = hash_(value_traits::get_key(np->value));
+    const auto n = code_pos(code);
+    if (node_ptr cur = find_in_bucket(n, value_traits::get_key(np->value), code))
+        return MoperSTL::make_pair(iterator(cur, this), false);
+    set_code(np, code);
+    link_front(np, n);
     ++size_;
     return MoperSTL::make_pair(iterator(np, this), true);
 }
 
-// replace_bucket 
+// unlink_node 
 template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
-replace_bucket(size_type bucket_count) {
-    bucket_type bucket(bucket_count);
-    if (size_ != 0) {
-        for (size_type i = 0; i < bucket_size_; ++i) {
-            for (auto first = buckets_[i]; first; first = first->next) {
-                auto tmp = create_node(first->value);
-                const auto n = hash(value_traits::get_key(first->value), bucket_count);
-                auto f = bucket[n];
-                bool is_inserted = false;
-                for (auto cur = f; cur; cur = cur->next) {
-                    if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(first->value))) {
-                        tmp->next = cur->next;
-                        cur->next = tmp;
-                        is_inserted = true;
-                        break;
-                    }
-                }
-                if (!is_inserted) {
-                    tmp->next = f;
-                    bucket[n] = tmp;
-                }
-            }
+typename hashtable<T, Hash, KeyEqual>::node_ptr
+hashtable<T, Hash, KeyEqual>::
+unlink_node(node_ptr np) {
+    const auto n = node_pos(np);
+    remove_node(node_before(np, n), np, n);
+    np->set_link(nullptr, false);
+    --size_;
+    return np;
+}
+
+// find_in_bucket 
+// ڵ n  bucket вϣֵΪ code  key ȵĵһڵ㣬Ҳʱ nullptr
+// before ǿʱдýڵǰ
+template <class T, class Hash, class KeyEqual>
+template <class K>
+typename hashtable<T, Hash, KeyEqual>::node_ptr
+hashtable<T, Hash, KeyEqual>::
+find_in_bucket(size_type n, const K& key, size_type code, base_ptr* before) const {
+    for (node_ptr cur = bucket_begin(n); cur; cur = next_node(cur)) {
+        if (node_equal(cur, key, code)) {
+            if (before)
+                *before = node_before(cur, n);
+            return cur;
         }
+        if (cur->is_last())  // ѵ bucket ĩβ
+            break;
     }
-    buckets_.swap(bucket);
-    bucket_size_ = buckets_.size();
+    return nullptr;
 }
 
-// erase_bucket 
-// ڵ n  bucket ڣɾ [first, last) Ľڵ
+// node_before 
+// λڵ n  bucket Ľڵ np ǰ
+template <class T, class Hash, class KeyEqual>
+typename hashtable<T, Hash, KeyEqual>::base_ptr
+hashtable<T, Hash, KeyEqual>::
+node_before(node_ptr np, size_type n) const {
+    const hashtable_bucket& b = slot(n);
+    if (b.first == np)
+        return b.before;
+    base_ptr prev = b.first;
+    while (prev->get_next() != np)
+        prev = prev->get_next();
+    return prev;
+}
+
+// link_front 
+// ѽڵΪ n  bucket ĵһڵ㣻bucket Ϊʱͷ
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
-erase_bucket(size_type n, node_ptr first, node_ptr last) {
-    auto cur = buckets_[n];
-    if (cur == first) {
-        erase_bucket(n, last);
-    } else {
-        node_ptr next = cur->next;
-        for (; next != first; cur = next, next = cur->next) {}
-        while (next != last) {
-            cur->next = next->next;
-            destroy_node(next);
-            next = cur->next;
-            --size_;
+link_front(node_ptr np, size_type n) {
+    hashtable_bucket& b = slot(n);
+    if (b.first) {
+        np->set_link(b.first, false);
+        b.before->set_next(np);
+        b.first = np;
+    } else {  // np  bucket ΨһĽڵ㣬ͬʱҲһڵ
+        np->set_link(before_begin_.get_next(), true);
+        before_begin_.set_next(np);
+        if (np->get_next())  // ԭĵһڵ bucket ǰΪ np
+            slot(node_pos(next_node(np))).before = np;
+        b.before = &before_begin_;
+        b.first = np;
+    }
+}
+
+// link_after 
+// ѽڵڵ n  bucket еĽڵ prev ֮
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+link_after(node_ptr prev, node_ptr np, size_type) {
+    np->set_link(prev->get_next(), prev->is_last());
+    prev->set_link(np, false);
+    if (np->is_last() && np->get_next())  // prev ԭ bucket һڵʱһ bucket ǰΪ np
+        slot(node_pos(next_node(np))).before = np;
+}
+
+// remove_node 
+// ѵ n  bucket ǰΪ prev Ľڵ np ժ£ά bucket  before  first
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+remove_node(base_ptr prev, node_ptr np, size_type n) {
+    const node_ptr next = next_node(np);
+    const bool last = np->is_last();  // np  bucket һڵ
+    hashtable_bucket& b = slot(n);
+    if (b.first == np) {
+        if (last)  // ͬʱҲǵһڵ㣬bucket 
+            b = hashtable_bucket();
+        else
+            b.first = next;
+    } else if (last) {  // ǰ np ͬһ bucketΪµһڵ
+        prev->set_last(true);
+    }
+    if (last && next)
+        slot(node_pos(next)).before = prev;
+    prev->set_next(next);
+}
+
+// relink_chain 
+// һѴժµĽڵӵڵ bucketԪ
+// мֵȵĽڵڣӺԱ
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+relink_chain(node_ptr first) {
+    // һڵڵ bucketڵ뵽ͷʱҪǰ
+    size_type front = 0;
+    if (before_begin_.get_next())
+        front = node_pos(next_node(&before_begin_));
+    node_ptr  last = nullptr;
+    size_type last_code = 0;
+    size_type last_pos = 0;
+    while (first) {
+        const node_ptr np = first;
+        first = next_node(first);
+        const size_type code = node_code(np);
+        if (last && code == last_code &&
+            is_equal(value_traits::get_key(last->value), value_traits::get_key(np->value))) {
+            link_after(last, np, last_pos);
+        } else {
+            last_pos = code_pos(code);
+            hashtable_bucket& b = slot(last_pos);
+            if (b.first) {
+                np->set_link(b.first, false);
+                b.before->set_next(np);
+            } else {
+                np->set_link(before_begin_.get_next(), true);
+                before_begin_.set_next(np);
+                if (np->get_next())
+                    slot(front).before = np;
+                b.before = &before_begin_;
+                front = last_pos;
+            }
+            b.first = np;
         }
+        last = np;
+        last_code = code;
     }
 }
 
-// erase_bucket 
-// ڵ n  bucket ڣɾ [buckets_[n], last) Ľڵ
+// replace_bucket 
+// ժµ bucket ӣԪأֵȵĽڵԱ
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
-erase_bucket(size_type n, node_ptr last) {
-    auto cur = buckets_[n];
-    while (cur != last) {
-        auto next = cur->next;
-        destroy_node(cur);
-        cur = next;
-        --size_;
+replace_bucket(size_type bucket_count, typename bucket_policy::state_type state) {
+    bucket_type bucket(bucket_count);
+    const node_ptr first = next_node(&before_begin_);
+    before_begin_.next_last = 0;
+    buckets_.swap(bucket);
+    bucket_size_ = buckets_.size();
+    policy_.commit(state);
+    relink_chain(first);
+}
+
+// clear_buckets 
+// ڵȫٻժº±ͷžɱ
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+clear_buckets() noexcept {
+    for (size_type i = 0; i < bucket_size_; ++i)
+        buckets_[i] = hashtable_bucket();
+    before_begin_.next_last = 0;
+    if (!old_buckets_.empty()) {
+        bucket_type().swap(old_buckets_);
+        rehash_idx_ = 0;
     }
-    buckets_[n] = last;
 }
 
 // equal_to 
@@ -0,0 +1,135 @@
+#ifndef MOPER_STL_NODE_HANDLE_H
+#define MOPER_STL_NODE_HANDLE_H
+
+// ڵ node_handle set / map / unordered_set / unordered_map  extractinsert  merge ʹ
+// extract ѽڵժ½insert ٰѽڵӽһ
+// ֻ޸ָ룬ḴƻƶԪأҲͷڴ
+// ʱԳнڵ㣬ԪزͷŽڵ
+
+#include <type_traits>
+
+#include "memory.h"
+#include "utility.h"
+
+namespace MoperSTL {
+
+// forward declaration
+
+template <class T, class Compare, bool OrderStatistic>
+class rb_tree;
+
+template <class T, class Hash, class KeyEqual>
+class hashtable;
+
+template <class Node, class T>
+class node_handle;
+
+// ʾеԪأset ṩ value()map ṩ key()  mapped()
+
+template <class Node, class T, bool IsMap = MoperSTL::is_pair<T>::value>
+struct node_handle_access {
+    typedef T value_type;
+
+    value_type& value() const {
+        return static_cast<const node_handle<Node, T>*>(this)->node_->value;
+    }
+};
+
+template <class Node, class T>
+struct node_handle_access<Node, T, true> {
+    typedef typename std::remove_const<typename T::first_type>::type key_type;
+    typedef typename T::second_type                                mapped_type;
+
+    // ֵ const ģڵ뿪޸ļֵһλ
+    key_type&    key() const {
+        return const_cast<key_type&>(static_cast<const node_handle<Node, T>*>(this)->node_->value.first);
+    }
+    mapped_type& mapped() const {
+        return static_cast<const node_handle<Node, T>*>(this)->node_->value.second;
+    }
+};
+
+// ģ node_handle
+// һڵͣڵдԪ
+// ֻƶܸƣֵͬ set  multisetmap  multimap ȣ֮Իཻڵ
+template <class Node, class T>
+class node_handle :public node_handle_access<Node, T> {
+    template <class, class, bool> friend class MoperSTL::rb_tree;
+    template <class, class, class> friend class MoperSTL::hashtable;
+    friend struct node_handle_access<Node, T>;
+
+public:
+    typedef MoperSTL::allocator<T>    allocator_type;
+
+private:
+    typedef MoperSTL::allocator<T>    data_allocator;
+    typedef MoperSTL::allocator<Node> node_allocator;
+
+    Node* node_;  // еĽڵ㣬ΪձʾΪ
+
+public:
+    constexpr node_handle() noexcept :node_(nullptr) {}
+
+    node_handle(node_handle&& rhs) noexcept :node_(rhs.node_) {
+        rhs.node_ = nullptr;
+    }
+
+    node_handle& operator=(node_handle&& rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            node_ = rhs.node_;
+            rhs.node_ = nullptr;
+        }
+        return *this;
+    }
+
+    node_handle(const node_handle&) = delete;
+    node_handle& operator=(const node_handle&) = delete;
+
+    ~node_handle() { reset(); }
+
+    bool           empty()         const noexcept { return node_ == nullptr; }
+    explicit       operator bool() const noexcept { return node_ != nullptr; }
+    allocator_type get_allocator() const { return allocator_type(); }
+
+    void swap(node_handle& rhs) noexcept {
+        MoperSTL::swap(node_, rhs.node_);
+    }
+
+private:
+    explicit node_handle(Node* node) noexcept :node_(node) {}
+
+    // ڵ㣬Ϊ
+    Node* release() noexcept {
+        Node* node = node_;
+        node_ = nullptr;
+        return node;
+    }
+
+    void reset() noexcept {
+        if (node_ != nullptr) {
+            data_allocator::destroy(MoperSTL::addressof(node_->value));
+            node_allocator::deallocate(node_);
+            node_ = nullptr;
+        }
+    }
+};
+
+//  MoperSTL  swap
+template <class Node, class T>
+void swap(node_handle<Node, T>& lhs, node_handle<Node, T>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// Խڵֵظʱķֵ
+// ɹʱ position ָԪأnode ΪգֵѴʱ position ָԪأڵ node 
+template <class Iterator, class NodeHandle>
+struct node_insert_return {
+    Iterator   position;
+    bool       inserted;
+    NodeHandle node;
+};
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_NODE_HANDLE_H */
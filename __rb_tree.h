@@ -2,12 +2,14 @@
 #define MOPER_STL_RB_TREE_H
 
 #include <initializer_list>
+#include <cstdint>
 
 #include "iterator.h"
 #include "memory.h"
 #include "utility.h"
 #include "type_traits.h"
 #include "exceptdef.h"
+#include "__node_handle.h"
 
 namespace MoperSTL {
 
@@ -18,6 +20,12 @@ typedef bool rb_tree_color_type;
 static constexpr rb_tree_color_type rb_tree_red = false;
 static constexpr rb_tree_color_type rb_tree_black = true;
 
+// ǩ from_sorted_range_tʾѰֵź򣨲ظϸ
+// ʹøñǩĹ캯καȽϣ O(n) ʱԵϽ
+struct from_sorted_range_t {};
+
+constexpr from_sorted_range_t from_sorted_range = from_sorted_range_t();
+
 // forward declaration
 
 template <class T> struct rb_tree_node_base;
@@ -106,10 +114,27 @@ struct rb_tree_node_base {
     typedef rb_tree_node_base<T>* base_ptr;
     typedef rb_tree_node<T>* node_ptr;
 
-    base_ptr   parent;  // ڵ
-    base_ptr   left;    // ӽڵ
-    base_ptr   right;   // ӽڵ
-    color_type color;   // ڵɫ
+    // ڵָɫһ֣ڵָٰ룬ָλΪ 0ɫ
+    // ڵͷָֻСrb_tree_node<int> Ϊ 32 ֽڶ 40 ֽ
+    std::uintptr_t parent_color;
+    base_ptr       left;    // ӽڵ
+    base_ptr       right;   // ӽڵ
+
+    base_ptr get_parent() const noexcept {
+        return reinterpret_cast<base_ptr>(parent_color & ~static_cast<std::uintptr_t>(1));
+    }
+
+    void set_parent(base_ptr p) noexcept {
+        parent_color = reinterpret_cast<std::uintptr_t>(p) | (parent_color & 1);
+    }
+
+    color_type get_color() const noexcept {
+        return static_cast<color_type>(parent_color & 1);
+    }
+
+    void set_color(color_type c) noexcept {
+        parent_color = (parent_color & ~static_cast<std::uintptr_t>(1)) | static_cast<std::uintptr_t>(c);
+    }
 
     base_ptr get_base_ptr() {
         return &*this;
@@ -140,6 +165,12 @@ struct rb_tree_node :public rb_tree_node_base<T> {
     }
 };
 
+// ˳ͳģʽµĽڵ㣬¼ԸýڵΪС
+template <class T>
+struct rb_tree_size_node :public rb_tree_node<T> {
+    std::size_t size;  // Ľڵ
+};
+
 // rb tree traits
 
 template <class T>
@@ -177,10 +208,10 @@ struct rb_tree_iterator_base :public MoperSTL::iterator<MoperSTL::bidirectional_
         if (node->right != nullptr) {
             node = rb_tree_min(node->right);
         } else {  // ûӽڵ
-            auto y = node->parent;
+            auto y = node->get_parent();
             while (y->right == node) {
                 node = y;
-                y = y->parent;
+                y = y->get_parent();
             }
             if (node->right != y)  // ӦԡѰҸڵһڵ㣬ڵûӽڵ㡱
                 node = y;
@@ -189,15 +220,15 @@ struct rb_tree_iterator_base :public MoperSTL::iterator<MoperSTL::bidirectional_
 
     // ʹ
     void dec() {
-        if (node->parent->parent == node && rb_tree_is_red(node)) { //  node Ϊ header
+        if (node->get_parent()->get_parent() == node && rb_tree_is_red(node)) { //  node Ϊ header
             node = node->right;  // ָ max ڵ
         } else if (node->left != nullptr) {
             node = rb_tree_max(node->left);
         } else {  //  header ڵ㣬Ҳӽڵ
-            auto y = node->parent;
+            auto y = node->get_parent();
             while (node == y->left) {
                 node = y;
-                y = y->parent;
+                y = y->get_parent();
             }
             node = y;
         }
@@ -319,22 +350,22 @@ NodePtr rb_tree_max(NodePtr x) noexcept {
 
 template <class NodePtr>
 bool rb_tree_is_lchild(NodePtr node) noexcept {
-    return node == node->parent->left;
+    return node == node->get_parent()->left;
 }
 
 template <class NodePtr>
 bool rb_tree_is_red(NodePtr node) noexcept {
-    return node->color == rb_tree_red;
+    return node->get_color() == rb_tree_red;
 }
 
 template <class NodePtr>
-void rb_tree_set_black(NodePtr& node) noexcept {
-    node->color = rb_tree_black;
+void rb_tree_set_black(NodePtr node) noexcept {
+    node->set_color(rb_tree_black);
 }
 
 template <class NodePtr>
-void rb_tree_set_red(NodePtr& node) noexcept {
-    node->color = rb_tree_red;
+void rb_tree_set_red(NodePtr node) noexcept {
+    node->set_color(rb_tree_red);
 }
 
 template <class NodePtr>
@@ -342,10 +373,60 @@ NodePtr rb_tree_next(NodePtr node) noexcept {
     if (node->right != nullptr)
         return rb_tree_min(node->right);
     while (!rb_tree_is_lchild(node))
-        node = node->parent;
-    return node->parent;
+        node = node->get_parent();
+    return node->get_parent();
 }
 
+// ṹıʱάڵ㸽ϢĲԣrotate / link / erase Ӧλõ
+// rb_tree_no_augment άκϢrb_tree_size_augment άС˳ͳ
+
+struct rb_tree_no_augment {
+    template <class NodePtr>
+    static void rotate(NodePtr, NodePtr) noexcept {}
+    template <class NodePtr>
+    static void link(NodePtr, NodePtr) noexcept {}
+    template <class NodePtr>
+    static void erase(NodePtr, NodePtr, NodePtr) noexcept {}
+    template <class NodePtr>
+    static void pull(NodePtr) noexcept {}
+};
+
+template <class T>
+struct rb_tree_size_augment {
+    typedef rb_tree_node_base<T>* base_ptr;
+    typedef rb_tree_size_node<T>* node_ptr;
+
+    static std::size_t size_of(base_ptr x) noexcept {
+        return x == nullptr ? 0 : static_cast<node_ptr>(x)->size;
+    }
+
+    // x ת y ֮£y  x ԭx С¼
+    static void rotate(base_ptr x, base_ptr y) noexcept {
+        static_cast<node_ptr>(y)->size = static_cast<node_ptr>(x)->size;
+        static_cast<node_ptr>(x)->size = size_of(x->left) + size_of(x->right) + 1;
+    }
+
+    // z ձӵУ·ϸȵСһ
+    static void link(base_ptr z, base_ptr header) noexcept {
+        static_cast<node_ptr>(z)->size = 1;
+        for (auto p = z->get_parent(); p != header; p = p->get_parent())
+            ++static_cast<node_ptr>(p)->size;
+    }
+
+    // Ҫɾ zʵ뿪ԭλõ yz  z ḷ́y ĸȼһy  z λС
+    static void erase(base_ptr z, base_ptr y, base_ptr header) noexcept {
+        for (auto p = y->get_parent(); p != header; p = p->get_parent())
+            --static_cast<node_ptr>(p)->size;
+        if (y != z)
+            static_cast<node_ptr>(y)->size = static_cast<node_ptr>(z)->size;
+    }
+
+    // x 滻join ʱӽڵ¼ x С
+    static void pull(base_ptr x) noexcept {
+        static_cast<node_ptr>(x)->size = size_of(x->left) + size_of(x->right) + 1;
+    }
+};
+
 /*---------------------------------------*\
 |       p                         p       |
 |      / \                       / \      |
@@ -356,24 +437,25 @@ NodePtr rb_tree_next(NodePtr node) noexcept {
 |     b   c                 a   b         |
 \*---------------------------------------*/
 // һΪ㣬Ϊڵ
-template <class NodePtr>
-void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept {
+template <class NodePtr, class Augment = rb_tree_no_augment>
+void rb_tree_rotate_left(NodePtr x, NodePtr& root, Augment aug = Augment()) noexcept {
     auto y = x->right;  // y Ϊ x ӽڵ
     x->right = y->left;
     if (y->left != nullptr)
-        y->left->parent = x;
-    y->parent = x->parent;
+        y->left->set_parent(x);
+    y->set_parent(x->get_parent());
 
     if (x == root) { //  x Ϊڵ㣬 y  x Ϊڵ
         root = y;
     } else if (rb_tree_is_lchild(x)) { //  x ӽڵ
-        x->parent->left = y;
+        x->get_parent()->left = y;
     } else { //  x ӽڵ
-        x->parent->right = y;
+        x->get_parent()->right = y;
     }
     //  x  y Ĺϵ
     y->left = x;
-    x->parent = y;
+    x->set_parent(y);
+    aug.rotate(x, y);
 }
 
 /*----------------------------------------*\
@@ -386,27 +468,29 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept {
 |   b   c                         c   a    |
 \*----------------------------------------*/
 // һΪ㣬Ϊڵ
-template <class NodePtr>
-void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept {
+template <class NodePtr, class Augment = rb_tree_no_augment>
+void rb_tree_rotate_right(NodePtr x, NodePtr& root, Augment aug = Augment()) noexcept {
     auto y = x->left;
     x->left = y->right;
     if (y->right)
-        y->right->parent = x;
-    y->parent = x->parent;
+        y->right->set_parent(x);
+    y->set_parent(x->get_parent());
 
     if (x == root) { //  x Ϊڵ㣬 y  x Ϊڵ
         root = y;
     } else if (rb_tree_is_lchild(x)) { //  x ӽڵ
-        x->parent->left = y;
+        x->get_parent()->left = y;
     } else { //  x ӽڵ
-        x->parent->right = y;
+        x->get_parent()->right = y;
     }
     //  x  y Ĺϵ
     y->right = x;
-    x->parent = y;
+    x->set_parent(y);
+    aug.rotate(x, y);
 }
 
 // ڵʹ rb tree ƽ⣬һΪڵ㣬Ϊڵ
+// ֵʾڵǷɺڣĺڸǷһ rb_tree_join ʹã
 //
 // case 1: ڵλڸڵ㣬ڵΪ
 // case 2: ڵĸڵΪڣûƻƽ⣬ֱӷ
@@ -419,81 +503,116 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept {
 //
 // ο: http://blog.csdn.net/v_JULY_v/article/details/6105630
 //          http://blog.csdn.net/v_JULY_v/article/details/6109153
-template <class NodePtr>
-void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept {
+template <class NodePtr, class Augment = rb_tree_no_augment>
+bool rb_tree_insert_rebalance(NodePtr x, NodePtr& root, Augment aug = Augment()) noexcept {
     rb_tree_set_red(x);  // ڵΪɫ
-    while (x != root && rb_tree_is_red(x->parent)) {
-        if (rb_tree_is_lchild(x->parent)) { // ڵӽڵ
-            auto uncle = x->parent->parent->right;
+    while (x != root && rb_tree_is_red(x->get_parent())) {
+        if (rb_tree_is_lchild(x->get_parent())) { // ڵӽڵ
+            auto uncle = x->get_parent()->get_parent()->right;
             if (uncle != nullptr && rb_tree_is_red(uncle)) { // case 3: ڵڵ㶼Ϊ
-                rb_tree_set_black(x->parent);
+                rb_tree_set_black(x->get_parent());
                 rb_tree_set_black(uncle);
-                x = x->parent->parent;
+                x = x->get_parent()->get_parent();
                 rb_tree_set_red(x);
             } else { // ڵڵΪ
                 if (!rb_tree_is_lchild(x)) { // case 4: ǰڵ x Ϊӽڵ
-                    x = x->parent;
-                    rb_tree_rotate_left(x, root);
+                    x = x->get_parent();
+                    rb_tree_rotate_left(x, root, aug);
                 }
                 // ת case 5 ǰڵΪӽڵ
-                rb_tree_set_black(x->parent);
-                rb_tree_set_red(x->parent->parent);
-                rb_tree_rotate_right(x->parent->parent, root);
+                rb_tree_set_black(x->get_parent());
+                rb_tree_set_red(x->get_parent()->get_parent());
+                rb_tree_rotate_right(x->get_parent()->get_parent(), root, aug);
                 break;
             }
         } else  // ڵӽڵ㣬Գƴ
         {
-            auto uncle = x->parent->parent->left;
+            auto uncle = x->get_parent()->get_parent()->left;
             if (uncle != nullptr && rb_tree_is_red(uncle)) { // case 3: ڵڵ㶼Ϊ
-                rb_tree_set_black(x->parent);
+                rb_tree_set_black(x->get_parent());
                 rb_tree_set_black(uncle);
-                x = x->parent->parent;
+                x = x->get_parent()->get_parent();
                 rb_tree_set_red(x);
                 // ʱ游ڵΪ죬ܻƻʣǰڵΪ游ڵ㣬
             } else { // ڵڵΪ
                 if (rb_tree_is_lchild(x)) { // case 4: ǰڵ x Ϊӽڵ
-                    x = x->parent;
-                    rb_tree_rotate_right(x, root);
+                    x = x->get_parent();
+                    rb_tree_rotate_right(x, root, aug);
                 }
                 // ת case 5 ǰڵΪӽڵ
-                rb_tree_set_black(x->parent);
-                rb_tree_set_red(x->parent->parent);
-                rb_tree_rotate_left(x->parent->parent, root);
+                rb_tree_set_black(x->get_parent());
+                rb_tree_set_red(x->get_parent()->get_parent());
+                rb_tree_rotate_left(x->get_parent()->get_parent(), root, aug);
                 break;
             }
         }
     }
+    const bool grow = rb_tree_is_red(root);
     rb_tree_set_black(root);  // ڵԶΪ
+    return grow;
+}
+
+// ڵ z Ϊ x ӽڵ㲢ʹ rb tree ƽ
+// x Ϊĸڵ㣬add_to_left ʾǷ߲룬header  parentleftright ֱָڵ㡢Сڵڵ
+template <class NodePtr, class Augment = rb_tree_no_augment>
+void rb_tree_link_and_rebalance(NodePtr z, NodePtr x, bool add_to_left, NodePtr header,
+                                Augment aug = Augment()) noexcept {
+    z->set_parent(x);
+    z->left = nullptr;
+    z->right = nullptr;
+    if (x == header) {
+        header->set_parent(z);
+        header->left = z;
+        header->right = z;
+    } else if (add_to_left) {
+        x->left = z;
+        if (header->left == x)
+            header->left = z;
+    } else {
+        x->right = z;
+        if (header->right == x)
+            header->right = z;
+    }
+    aug.link(z, header);
+    auto root = header->get_parent();
+    rb_tree_insert_rebalance(z, root, aug);
+    header->set_parent(root);
 }
 
-// ɾڵʹ rb tree ƽ⣬һΪҪɾĽڵ㣬Ϊڵ㣬ΪСڵ㣬Ϊڵ
+// ɾڵʹ rb tree ƽ⣬һΪҪɾĽڵ㣬Ϊ header parentleftright ֱָڵ㡢Сڵڵ
 // 
 // ο: http://blog.csdn.net/v_JULY_v/article/details/6105630
 //          http://blog.csdn.net/v_JULY_v/article/details/6109153
-template <class NodePtr>
-NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, NodePtr& rightmost) {
+template <class NodePtr, class Augment = rb_tree_no_augment>
+NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr header, Augment aug = Augment()) {
+    // ڵ header ɫ header ĸָ֣ȡϺд
+    NodePtr  root = header->get_parent();
+    NodePtr& leftmost = header->left;
+    NodePtr& rightmost = header->right;
+
   // y ǿܵ滻ڵ㣬ָҪɾĽڵ
     auto y = (z->left == nullptr || z->right == nullptr) ? z : rb_tree_next(z);
     // x  y һӽڵ NIL ڵ
     auto x = y->left != nullptr ? y->left : y->right;
     // xp Ϊ x ĸڵ
     NodePtr xp = nullptr;
+    aug.erase(z, y, header);
 
     // y != z ˵ z ǿӽڵ㣬ʱ y ָ z ڵ㣬x ָ y ӽڵ㡣
     //  y  z λã x  y λã y ָ z
     if (y != z) {
-        z->left->parent = y;
+        z->left->set_parent(y);
         y->left = z->left;
 
         //  y  z ӽڵ㣬ô z ӽڵһ
         if (y != z->right) { // x 滻 y λ
-            xp = y->parent;
+            xp = y->get_parent();
             if (x != nullptr)
-                x->parent = y->parent;
+                x->set_parent(y->get_parent());
 
-            y->parent->left = x;
+            y->get_parent()->left = x;
             y->right = z->right;
-            z->right->parent = y;
+            z->right->set_parent(y);
         } else {
             xp = y;
         }
@@ -502,26 +621,28 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
         if (root == z)
             root = y;
         else if (rb_tree_is_lchild(z))
-            z->parent->left = y;
+            z->get_parent()->left = y;
         else
-            z->parent->right = y;
-        y->parent = z->parent;
-        MoperSTL::swap(y->color, z->color);
+            z->get_parent()->right = y;
+        y->set_parent(z->get_parent());
+        auto color = y->get_color();
+        y->set_color(z->get_color());
+        z->set_color(color);
         y = z;
     }
     // y == z ˵ z ֻһ
     else {
-        xp = y->parent;
+        xp = y->get_parent();
         if (x)
-            x->parent = y->parent;
+            x->set_parent(y->get_parent());
 
           //  x  z ĸڵ
         if (root == z)
             root = x;
         else if (rb_tree_is_lchild(z))
-            z->parent->left = x;
+            z->get_parent()->left = x;
         else
-            z->parent->right = x;
+            z->get_parent()->right = x;
 
           // ʱ z пڵҽڵ㣬
         if (leftmost == z)
@@ -545,7 +666,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
                 if (rb_tree_is_red(brother)) { // case 1
                     rb_tree_set_black(brother);
                     rb_tree_set_red(xp);
-                    rb_tree_rotate_left(xp, root);
+                    rb_tree_rotate_left(xp, root, aug);
                     brother = xp->right;
                 }
                 // case 1 תΪΪ case 234 еһ
@@ -553,21 +674,21 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
                     (brother->right == nullptr || !rb_tree_is_red(brother->right))) { // case 2
                     rb_tree_set_red(brother);
                     x = xp;
-                    xp = xp->parent;
+                    xp = xp->get_parent();
                 } else {
                     if (brother->right == nullptr || !rb_tree_is_red(brother->right)) { // case 3
                         if (brother->left != nullptr)
                             rb_tree_set_black(brother->left);
                         rb_tree_set_red(brother);
-                        rb_tree_rotate_right(brother, root);
+                        rb_tree_rotate_right(brother, root, aug);
                         brother = xp->right;
                     }
                     // תΪ case 4
-                    brother->color = xp->color;
+                    brother->set_color(xp->get_color());
                     rb_tree_set_black(xp);
                     if (brother->right != nullptr)
                         rb_tree_set_black(brother->right);
-                    rb_tree_rotate_left(xp, root);
+                    rb_tree_rotate_left(xp, root, aug);
                     break;
                 }
             } else  // x Ϊӽڵ㣬Գƴ
@@ -576,28 +697,28 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
                 if (rb_tree_is_red(brother)) { // case 1
                     rb_tree_set_black(brother);
                     rb_tree_set_red(xp);
-                    rb_tree_rotate_right(xp, root);
+                    rb_tree_rotate_right(xp, root, aug);
                     brother = xp->left;
                 }
                 if ((brother->left == nullptr || !rb_tree_is_red(brother->left)) &&
                     (brother->right == nullptr || !rb_tree_is_red(brother->right))) { // case 2
                     rb_tree_set_red(brother);
                     x = xp;
-                    xp = xp->parent;
+                    xp = xp->get_parent();
                 } else {
                     if (brother->left == nullptr || !rb_tree_is_red(brother->left)) { // case 3
                         if (brother->right != nullptr)
                             rb_tree_set_black(brother->right);
                         rb_tree_set_red(brother);
-                        rb_tree_rotate_left(brother, root);
+                        rb_tree_rotate_left(brother, root, aug);
                         brother = xp->left;
                     }
                     // תΪ case 4
-                    brother->color = xp->color;
+                    brother->set_color(xp->get_color());
                     rb_tree_set_black(xp);
                     if (brother->left != nullptr)
                         rb_tree_set_black(brother->left);
-                    rb_tree_rotate_right(xp, root);
+                    rb_tree_rotate_right(xp, root, aug);
                     break;
                 }
             }
@@ -605,12 +726,74 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
         if (x != nullptr)
             rb_tree_set_black(x);
     }
+    header->set_parent(root);
     return y;
 }
 
+// Խڵ k öĺ l  rĸָΪգl еԪض k ֮ǰr еĶ k ֮
+// lhrh ΪĺڸߣΪʱΪ 0µĸµĺڸд h
+// ڸ߽ϴһң󣩲еڸһͬĺڽڵ cԺɫ k  c
+// c һΪ k ٰķʽϵʱ临Ӷ O(|lh - rh| + 1)
+template <class NodePtr, class Augment = rb_tree_no_augment>
+NodePtr rb_tree_join(NodePtr l, std::size_t lh, NodePtr k, NodePtr r, std::size_t rh,
+                     std::size_t& h, Augment aug = Augment()) noexcept {
+    // ɫĸͿڣڸ߼һ֤ k ĸڵǺڸߴ k Ľڵ㣬ʱ游ڵǴ
+    if (l != nullptr && rb_tree_is_red(l)) {
+        rb_tree_set_black(l);
+        ++lh;
+    }
+    if (r != nullptr && rb_tree_is_red(r)) {
+        rb_tree_set_black(r);
+        ++rh;
+    }
+    k->parent_color = 0;  // ڵΪգɫΪ
+    if (lh == rh) { // ڸͬk ֱΪ
+        k->left = l;
+        k->right = r;
+        if (l != nullptr)
+            l->set_parent(k);
+        if (r != nullptr)
+            r->set_parent(k);
+        rb_tree_set_black(k);
+        aug.pull(k);
+        h = lh + 1;
+        return k;
+    }
+    NodePtr root = lh > rh ? l : r;
+    NodePtr p = nullptr;
+    NodePtr c = root;
+    std::size_t ch = lh > rh ? lh : rh;
+    const std::size_t target = lh > rh ? rh : lh;
+    while (c != nullptr && (rb_tree_is_red(c) || ch > target)) {
+        if (!rb_tree_is_red(c))
+            --ch;
+        p = c;
+        c = lh > rh ? c->right : c->left;
+    }
+    if (lh > rh) {
+        k->left = c;
+        k->right = r;
+        p->right = k;
+    } else {
+        k->left = l;
+        k->right = c;
+        p->left = k;
+    }
+    if (k->left != nullptr)
+        k->left->set_parent(k);
+    if (k->right != nullptr)
+        k->right->set_parent(k);
+    k->set_parent(p);
+    for (NodePtr x = k; x != nullptr; x = x->get_parent())
+        aug.pull(x);
+    h = (lh > rh ? lh : rh) + (rb_tree_insert_rebalance(k, root, aug) ? 1 : 0);
+    return root;
+}
+
 // ģ rb_tree
-// һֵͣȽ
-template <class T, class Compare>
+// һֵͣȽͣ
+// Ϊ true ʱÿڵ¼Сṩ O(log n)  nthrankindex_of ˳ͳƲ
+template <class T, class Compare, bool OrderStatistic = false>
 class rb_tree {
 public:
   // rb_tree Ƕͱ 
@@ -620,8 +803,11 @@ public:
 
     typedef typename tree_traits::base_type          base_type;
     typedef typename tree_traits::base_ptr           base_ptr;
-    typedef typename tree_traits::node_type          node_type;
-    typedef typename tree_traits::node_ptr           node_ptr;
+    typedef typename std::conditional<OrderStatistic,
+        rb_tree_size_node<T>, typename tree_traits::node_type>::type node_type;
+    typedef node_type*                               node_ptr;
+    typedef typename std::conditional<OrderStatistic,
+        rb_tree_size_augment<T>, rb_tree_no_augment>::type   augment_type;
     typedef typename tree_traits::key_type           key_type;
     typedef typename tree_traits::mapped_type        mapped_type;
     typedef typename tree_traits::value_type         value_type;
@@ -644,9 +830,14 @@ public:
     typedef MoperSTL::reverse_iterator<iterator>        reverse_iterator;
     typedef MoperSTL::reverse_iterator<const_iterator>  const_reverse_iterator;
 
+    typedef MoperSTL::node_handle<node_type, T>         node_handle_type;
+
     allocator_type get_allocator() const { return node_allocator(); }
     key_compare    key_comp()      const { return key_comp_; }
 
+    // merge ҪһñȽϷʽͬĽڵ
+    template <class, class, bool> friend class rb_tree;
+
 private:
   // ݱ rb tree
     base_ptr    header_;      // ڵ㣬ڵ㻥ΪԷĸڵ
@@ -655,7 +846,8 @@ private:
 
 private:
   // ȡøڵ㣬Сڵڵ
-    base_ptr& root()      const { return header_->parent; }
+    base_ptr  root()      const { return header_->get_parent(); }
+    void      set_root(base_ptr x) { header_->set_parent(x); }
     base_ptr& leftmost()  const { return header_->left; }
     base_ptr& rightmost() const { return header_->right; }
 
@@ -753,6 +945,10 @@ public:
     void      insert_multi(InputIterator first, InputIterator last) {
         size_type n = MoperSTL::distance(first, last);
         THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+        if (node_count_ == 0 && is_sorted_range(first, last, false)) {  // ֱӽ
+            build_from_sorted(first, n);
+            return;
+        }
         for (; n > 0; --n, ++first)
             insert_multi(end(), *first);
     }
@@ -773,10 +969,22 @@ public:
     void      insert_unique(InputIterator first, InputIterator last) {
         size_type n = MoperSTL::distance(first, last);
         THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+        if (node_count_ == 0 && is_sorted_range(first, last, true)) {  // ϸֱӽ
+            build_from_sorted(first, n);
+            return;
+        }
         for (; n > 0; --n, ++first)
             insert_unique(end(), *first);
     }
 
+    // 滻ݣκαȽϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    void      assign_sorted(InputIterator first, InputIterator last) {
+        clear();
+        size_type n = MoperSTL::distance(first, last);
+        build_from_sorted(first, n);
+    }
+
     // erase
 
     iterator  erase(iterator hint);
@@ -788,10 +996,50 @@ public:
 
     void      clear();
 
+    // ڵ
+
+    // ѽڵժ½ͷŽڵ㣻key ʱؿվ
+    node_handle_type extract(iterator position);
+    node_handle_type extract(const key_type& key) {
+        auto it = find(key);
+        return it == end() ? node_handle_type() : extract(it);
+    }
+
+    // ѾеĽڵӽУֵѴڣΪգʱʧܣڵھ
+    MoperSTL::pair<iterator, bool> insert_unique(node_handle_type&& nh);
+    iterator  insert_unique(iterator hint, node_handle_type&& nh);
+    iterator  insert_multi(node_handle_type&& nh);
+    iterator  insert_multi(iterator hint, node_handle_type&& nh);
+
+    //  src ĽڵժӽԪأmerge_unique  src мֵѴڵĽڵ
+    template <class Compare2>
+    void      merge_unique(rb_tree<T, Compare2, OrderStatistic>& src);
+    template <class Compare2>
+    void      merge_multi(rb_tree<T, Compare2, OrderStatistic>& src);
+
+    // ƴָֻıĽṹԪ
+
+    //  rhs ȫڵڱ֮Ҫ rhs ԪضڱԪ֮ǰrhs Ϊգʱ临Ӷ O(log n)
+    void      join(rb_tree& rhs);
+    // ֵС key Ԫ rightright ԭеԪر
+    // OrderStatistic Ϊ true ʱʱ临ӶΪ O(log n)ҪͳƽһԪظ O(min(k, n - k))
+    void      split(const key_type& key, rb_tree& right);
+
+    // 㣬ֵظ split  join ݹ
+    // mn ֱΪнСϴԪظʱ临Ӷ O(m log(n/m + 1))Сϲ󼯺ϵĴ۽ӽСϵĴС
+    // Ҫ key_compare ׳쳣
+
+    // other Ľڵ㲢뱾ֵѴڵĽڵ㱻٣Ԫأother Ϊ
+    void      union_unique(rb_tree& other);
+    // ٱмֵ other еĽڵ
+    void      intersection_unique(const rb_tree& other);
+    // ٱмֵ other еĽڵ
+    void      difference_unique(const rb_tree& other);
+
     // rb_tree ز
 
-    iterator       find(const key_type& key);
-    const_iterator find(const key_type& key) const;
+    iterator       find(const key_type& key)       { return iterator(find_node(key)); }
+    const_iterator find(const key_type& key) const { return const_iterator(find_node(key)); }
 
     size_type      count_multi(const key_type& key) const {
         auto p = equal_range_multi(key);
@@ -801,11 +1049,11 @@ public:
         return find(key) != end() ? 1 : 0;
     }
 
-    iterator       lower_bound(const key_type& key);
-    const_iterator lower_bound(const key_type& key) const;
+    iterator       lower_bound(const key_type& key)       { return iterator(lower_bound_node(key)); }
+    const_iterator lower_bound(const key_type& key) const { return const_iterator(lower_bound_node(key)); }
 
-    iterator       upper_bound(const key_type& key);
-    const_iterator upper_bound(const key_type& key) const;
+    iterator       upper_bound(const key_type& key)       { return iterator(upper_bound_node(key)); }
+    const_iterator upper_bound(const key_type& key) const { return const_iterator(upper_bound_node(key)); }
 
     MoperSTL::pair<iterator, iterator>
         equal_range_multi(const key_type& key) {
@@ -829,6 +1077,96 @@ public:
         return it == end() ? MoperSTL::make_pair(it, it) : MoperSTL::make_pair(it, ++next);
     }
 
+    // 칹ң Compare  is_transparent ʱأ less<void>
+    // ֱֵȽϣṹʱ key_type
+
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       find(const K& key)       { return iterator(find_node(key)); }
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key) const { return const_iterator(find_node(key)); }
+
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count_multi(const K& key) const {
+        return static_cast<size_type>(MoperSTL::distance(
+            const_iterator(lower_bound_node(key)), const_iterator(upper_bound_node(key))));
+    }
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count_unique(const K& key) const {
+        return find_node(key) != header_ ? 1 : 0;
+    }
+
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       lower_bound(const K& key)       { return iterator(lower_bound_node(key)); }
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return const_iterator(lower_bound_node(key)); }
+
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       upper_bound(const K& key)       { return iterator(upper_bound_node(key)); }
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return const_iterator(upper_bound_node(key)); }
+
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    MoperSTL::pair<iterator, iterator>
+        equal_range_multi(const K& key) {
+        return MoperSTL::pair<iterator, iterator>(
+            iterator(lower_bound_node(key)), iterator(upper_bound_node(key)));
+    }
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    MoperSTL::pair<const_iterator, const_iterator>
+        equal_range_multi(const K& key) const {
+        return MoperSTL::pair<const_iterator, const_iterator>(
+            const_iterator(lower_bound_node(key)), const_iterator(upper_bound_node(key)));
+    }
+
+    // ͸Ƚ¿жԪ key ȼۣ equal_range_unique 
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    MoperSTL::pair<iterator, iterator>
+        equal_range_unique(const K& key) {
+        return equal_range_multi(key);
+    }
+    template <class K, class C = Compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    MoperSTL::pair<const_iterator, const_iterator>
+        equal_range_unique(const K& key) const {
+        return equal_range_multi(key);
+    }
+
+    // ˳ͳƲ OrderStatistic Ϊ true ʱãʱ临ӶȾΪ O(log n)
+
+    //  k Ԫأ 0 ʼk >= size() ʱ end()
+    iterator       nth(size_type k);
+    const_iterator nth(size_type k) const {
+        return const_cast<rb_tree*>(this)->nth(k);
+    }
+
+    // ֵС key Ԫظ lower_bound(key) ±
+    size_type      rank(const key_type& key) const;
+
+    // ָԪص±꣬end() ±Ϊ size()
+    size_type      index_of(const_iterator it) const;
+
+    // ֵλ [low, high) ڵԪظ
+    size_type      count_range(const key_type& low, const key_type& high) const {
+        const size_type l = rank(low), h = rank(high);
+        return h > l ? h - l : 0;
+    }
+
+    // ֮ľ
+    difference_type distance(const_iterator first, const_iterator last) const {
+        return static_cast<difference_type>(index_of(last)) - static_cast<difference_type>(index_of(first));
+    }
+
     void swap(rb_tree& rhs) noexcept;
 
 private:
@@ -843,6 +1181,14 @@ private:
     void     rb_tree_init();
     void     reset();
 
+    // lookupK Ϊ key_type ͸Ƚɽܵ
+    template <class K>
+    base_ptr find_node(const K& key) const;
+    template <class K>
+    base_ptr lower_bound_node(const K& key) const;
+    template <class K>
+    base_ptr upper_bound_node(const K& key) const;
+
     // get insert pos
     MoperSTL::pair<base_ptr, bool>
         get_insert_multi_pos(const key_type& key);
@@ -854,23 +1200,54 @@ private:
     iterator insert_node_at(base_ptr x, node_ptr node, bool add_to_left);
 
     // insert use hint
-    iterator insert_multi_use_hint(iterator hint, key_type key, node_ptr node);
-    iterator insert_unique_use_hint(iterator hint, key_type key, node_ptr node);
+    iterator insert_multi_use_hint(iterator hint, const key_type& key, node_ptr node);
+    MoperSTL::pair<iterator, bool>
+             insert_unique_use_hint(iterator hint, const key_type& key, node_ptr node);
+
+    // ѽڵժ£
+    node_ptr unlink_node(base_ptr x);
+
+    // join / splitĸڵ㸸ָΪգheight Ϊڸ
+    struct subtree {
+        base_ptr  root;
+        size_type height;
+    };
+    subtree  take_tree();
+    void     put_tree(base_ptr x);
+    static subtree take_child(base_ptr x, const subtree& t);
+    static subtree join_subtree(subtree l, base_ptr k, subtree r);
+    static subtree join_subtree(subtree l, subtree r);
+    static base_ptr split_first(subtree t, subtree& rest);
+    template <class K>
+    base_ptr split_subtree(subtree t, const K& key, subtree& l, subtree& r);
+    template <class K>
+    void     split_lower(subtree t, const K& key, subtree& l, subtree& r);
+    subtree  union_subtree(subtree t1, subtree t2, size_type& dup);
+    subtree  intersection_subtree(subtree t, base_ptr x, size_type& removed);
+    subtree  difference_subtree(subtree t, base_ptr x, size_type& removed);
+
+    // build from sorted range
+    template <class InputIterator>
+    bool     is_sorted_range(InputIterator first, InputIterator last, bool strict) const;
+    template <class InputIterator>
+    void     build_from_sorted(InputIterator first, size_type n);
+    template <class InputIterator>
+    base_ptr build_since(InputIterator& first, size_type n, size_type depth, size_type red_depth);
 
     // copy tree / erase tree
     base_ptr copy_from(base_ptr x, base_ptr p);
-    void     erase_since(base_ptr x);
+    size_type erase_since(base_ptr x);
 };
 
 /*****************************************************************************************/
 
 // ƹ캯
-template <class T, class Compare>
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+rb_tree<T, Compare, OrderStatistic>::
 rb_tree(const rb_tree& rhs) {
     rb_tree_init();
     if (rhs.node_count_ != 0) {
-        root() = copy_from(rhs.root(), header_);
+        set_root(copy_from(rhs.root(), header_));
         leftmost() = rb_tree_min(root());
         rightmost() = rb_tree_max(root());
     }
@@ -879,8 +1256,8 @@ rb_tree(const rb_tree& rhs) {
 }
 
 // ƶ캯
-template <class T, class Compare>
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+rb_tree<T, Compare, OrderStatistic>::
 rb_tree(rb_tree&& rhs) noexcept
     :header_(MoperSTL::move(rhs.header_)),
     node_count_(rhs.node_count_),
@@ -889,15 +1266,15 @@ rb_tree(rb_tree&& rhs) noexcept
 }
 
 // Ƹֵ
-template <class T, class Compare>
-rb_tree<T, Compare>&
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+rb_tree<T, Compare, OrderStatistic>&
+rb_tree<T, Compare, OrderStatistic>::
 operator=(const rb_tree& rhs) {
     if (this != &rhs) {
         clear();
 
         if (rhs.node_count_ != 0) {
-            root() = copy_from(rhs.root(), header_);
+            set_root(copy_from(rhs.root(), header_));
             leftmost() = rb_tree_min(root());
             rightmost() = rb_tree_max(root());
         }
@@ -909,9 +1286,9 @@ operator=(const rb_tree& rhs) {
 }
 
 // ƶֵ
-template <class T, class Compare>
-rb_tree<T, Compare>&
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+rb_tree<T, Compare, OrderStatistic>&
+rb_tree<T, Compare, OrderStatistic>::
 operator=(rb_tree&& rhs) {
     clear();
     header_ = MoperSTL::move(rhs.header_);
@@ -922,10 +1299,10 @@ operator=(rb_tree&& rhs) {
 }
 
 // ͵زԪأֵظ
-template <class T, class Compare>
+template <class T, class Compare, bool OrderStatistic>
 template <class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
 emplace_multi(Args&& ...args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MoperSTL::forward<Args>(args)...);
@@ -934,10 +1311,10 @@ emplace_multi(Args&& ...args) {
 }
 
 // ͵زԪأֵظ
-template <class T, class Compare>
+template <class T, class Compare, bool OrderStatistic>
 template <class ...Args>
-MoperSTL::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::
+MoperSTL::pair<typename rb_tree<T, Compare, OrderStatistic>::iterator, bool>
+rb_tree<T, Compare, OrderStatistic>::
 emplace_unique(Args&& ...args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MoperSTL::forward<Args>(args)...);
@@ -950,77 +1327,40 @@ emplace_unique(Args&& ...args) {
 }
 
 // ͵زԪأֵظ hint λλýӽʱʱ临ӶȿԽ
-template <class T, class Compare>
+template <class T, class Compare, bool OrderStatistic>
 template <class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
 emplace_multi_use_hint(iterator hint, Args&& ...args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MoperSTL::forward<Args>(args)...);
     if (node_count_ == 0) {
         return insert_node_at(header_, np, true);
     }
-    key_type key = value_traits::get_key(np->value);
-    if (hint == begin()) { // λ begin 
-        if (key_comp_(key, value_traits::get_key(*hint))) {
-            return insert_node_at(hint.node, np, true);
-        } else {
-            auto pos = get_insert_multi_pos(key);
-            return insert_node_at(pos.first, np, pos.second);
-        }
-    } else if (hint == end()) { // λ end 
-        if (!key_comp_(key, value_traits::get_key(rightmost()->get_node_ptr()->value))) {
-            return insert_node_at(rightmost(), np, false);
-        } else {
-            auto pos = get_insert_multi_pos(key);
-            return insert_node_at(pos.first, np, pos.second);
-        }
-    }
-    return insert_multi_use_hint(hint, key, np);
+    return insert_multi_use_hint(hint, value_traits::get_key(np->value), np);
 }
 
 // ͵زԪأֵظ hint λλýӽʱʱ临ӶȿԽ
-template<class T, class Compare>
+template <class T, class Compare, bool OrderStatistic>
 template<class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
 emplace_unique_use_hint(iterator hint, Args&& ...args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MoperSTL::forward<Args>(args)...);
     if (node_count_ == 0) {
         return insert_node_at(header_, np, true);
     }
-    key_type key = value_traits::get_key(np->value);
-    if (hint == begin()) { // λ begin 
-        if (key_comp_(key, value_traits::get_key(*hint))) {
-            return insert_node_at(hint.node, np, true);
-        } else {
-            auto pos = get_insert_unique_pos(key);
-            if (!pos.second) {
-                destroy_node(np);
-                return pos.first.first;
-            }
-            return insert_node_at(pos.first.first, np, pos.first.second);
-        }
-    } else if (hint == end()) { // λ end 
-        if (key_comp_(value_traits::get_key(rightmost()->get_node_ptr()->value), key)) {
-            return insert_node_at(rightmost(), np, false);
-        } else {
-            auto pos = get_insert_unique_pos(key);
-            if (!pos.second) {
-                destroy_node(np);
-                return pos.first.first;
-            }
-            return insert_node_at(pos.first.first, np, pos.first.second);
-        }
-    }
-    return insert_unique_use_hint(hint, key, np);
+    auto res = insert_unique_use_hint(hint, value_traits::get_key(np->value), np);
+    if (!res.second)
+        destroy_node(np);
+    return res.first;
 }
 
 // Ԫأڵֵظ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
 insert_multi(const value_type& value) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     auto res = get_insert_multi_pos(value_traits::get_key(value));
@@ -1028,37 +1368,37 @@ insert_multi(const value_type& value) {
 }
 
 // ֵڵֵظһ pairɹpair ĵڶΪ trueΪ false
-template <class T, class Compare>
-MoperSTL::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+MoperSTL::pair<typename rb_tree<T, Compare, OrderStatistic>::iterator, bool>
+rb_tree<T, Compare, OrderStatistic>::
 insert_unique(const value_type& value) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     auto res = get_insert_unique_pos(value_traits::get_key(value));
     if (res.second) { // ɹ
         return MoperSTL::make_pair(insert_value_at(res.first.first, value, res.first.second), true);
     }
-    return MoperSTL::make_pair(res.first.first, false);
+    return MoperSTL::make_pair(iterator(res.first.first), false);
 }
 
 // ɾ hint λõĽڵ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
 erase(iterator hint) {
-    auto node = hint.node->get_node_ptr();
+    auto node = static_cast<node_ptr>(hint.node);
     iterator next(node);
     ++next;
 
-    rb_tree_erase_rebalance(hint.node, root(), leftmost(), rightmost());
+    rb_tree_erase_rebalance(hint.node, header_, augment_type());
     destroy_node(node);
     --node_count_;
     return next;
 }
 
 // ɾֵ key Ԫأɾĸ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::size_type
+rb_tree<T, Compare, OrderStatistic>::
 erase_multi(const key_type& key) {
     auto p = equal_range_multi(key);
     size_type n = MoperSTL::distance(p.first, p.second);
@@ -1067,9 +1407,9 @@ erase_multi(const key_type& key) {
 }
 
 // ɾֵ key Ԫأɾĸ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::size_type
+rb_tree<T, Compare, OrderStatistic>::
 erase_unique(const key_type& key) {
     auto it = find(key);
     if (it != end()) {
@@ -1080,8 +1420,8 @@ erase_unique(const key_type& key) {
 }
 
 // ɾ[first, last)ڵԪ
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
 erase(iterator first, iterator last) {
     if (first == begin() && last == end()) {
         clear();
@@ -1092,40 +1432,34 @@ erase(iterator first, iterator last) {
 }
 
 //  rb tree
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
 clear() {
     if (node_count_ != 0) {
         erase_since(root());
         leftmost() = header_;
-        root() = nullptr;
+        set_root(nullptr);
         rightmost() = header_;
         node_count_ = 0;
     }
 }
 
-// ҼֵΪ k Ľڵ㣬ָĵ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
-find(const key_type& key) {
-    auto y = header_;  // һС key Ľڵ
-    auto x = root();
-    while (x != nullptr) {
-        if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) { // key Сڵ x ֵ
-            y = x, x = x->left;
-        } else { // key  x ֵ
-            x = x->right;
-        }
-    }
-    iterator j = iterator(y);
-    return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+// ҼֵΪ key Ľڵ㣬Ҳʱ header_
+template <class T, class Compare, bool OrderStatistic>
+template <class K>
+typename rb_tree<T, Compare, OrderStatistic>::base_ptr
+rb_tree<T, Compare, OrderStatistic>::
+find_node(const K& key) const {
+    auto y = lower_bound_node(key);
+    return (y == header_ || key_comp_(key, value_traits::get_key(y->get_node_ptr()->value))) ? header_ : y;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
-find(const key_type& key) const {
+// ֵС key ĵһڵ
+template <class T, class Compare, bool OrderStatistic>
+template <class K>
+typename rb_tree<T, Compare, OrderStatistic>::base_ptr
+rb_tree<T, Compare, OrderStatistic>::
+lower_bound_node(const K& key) const {
     auto y = header_;  // һС key Ľڵ
     auto x = root();
     while (x != nullptr) {
@@ -1135,102 +1469,287 @@ find(const key_type& key) const {
             x = x->right;
         }
     }
-    const_iterator j = const_iterator(y);
-    return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+    return y;
 }
 
-// ֵС key ĵһλ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
-lower_bound(const key_type& key) {
+// ֵ key ĵһڵ
+template <class T, class Compare, bool OrderStatistic>
+template <class K>
+typename rb_tree<T, Compare, OrderStatistic>::base_ptr
+rb_tree<T, Compare, OrderStatistic>::
+upper_bound_node(const K& key) const {
     auto y = header_;
     auto x = root();
     while (x != nullptr) {
-        if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) { // key <= x
+        if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) { // key < x
             y = x, x = x->left;
         } else {
             x = x->right;
         }
     }
-    return iterator(y);
+    return y;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
-lower_bound(const key_type& key) const {
-    auto y = header_;
+//  rb tree
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
+swap(rb_tree& rhs) noexcept {
+    if (this != &rhs) {
+        MoperSTL::swap(header_, rhs.header_);
+        MoperSTL::swap(node_count_, rhs.node_count_);
+        MoperSTL::swap(key_comp_, rhs.key_comp_);
+    }
+}
+
+// ȡ k ԪأСΪ k ʱΪǰڵ㣬Ӧ
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
+nth(size_type k) {
+    static_assert(OrderStatistic, "nth requires rb_tree with OrderStatistic = true");
     auto x = root();
     while (x != nullptr) {
-        if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) { // key <= x
-            y = x, x = x->left;
+        const size_type left_size = augment_type::size_of(x->left);
+        if (k < left_size) {
+            x = x->left;
+        } else if (k == left_size) {
+            return iterator(x);
         } else {
+            k -= left_size + 1;
             x = x->right;
         }
     }
-    return const_iterator(y);
+    return end();
 }
 
-// ֵС key һλ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
-upper_bound(const key_type& key) {
-    auto y = header_;
+// ֵС key Ԫظ
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::size_type
+rb_tree<T, Compare, OrderStatistic>::
+rank(const key_type& key) const {
+    static_assert(OrderStatistic, "rank requires rb_tree with OrderStatistic = true");
+    size_type r = 0;
     auto x = root();
     while (x != nullptr) {
-        if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) { // key < x
-            y = x, x = x->left;
-        } else {
+        if (key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) { // x < keyx 
+            r += augment_type::size_of(x->left) + 1;
             x = x->right;
+        } else {
+            x = x->left;
         }
     }
-    return iterator(y);
+    return r;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
-upper_bound(const key_type& key) const {
-    auto y = header_;
-    auto x = root();
-    while (x != nullptr) {
-        if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) { // key < x
-            y = x, x = x->left;
-        } else {
-            x = x->right;
+// ָԪص±꣺Ըýڵϣÿӽڵصڵʱϸڵ㼰
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::size_type
+rb_tree<T, Compare, OrderStatistic>::
+index_of(const_iterator it) const {
+    static_assert(OrderStatistic, "index_of requires rb_tree with OrderStatistic = true");
+    base_ptr x = it.node;
+    if (x == header_)
+        return node_count_;
+    size_type r = augment_type::size_of(x->left);
+    while (x != root()) {
+        auto p = x->get_parent();
+        if (p->right == x)
+            r += augment_type::size_of(p->left) + 1;
+        x = p;
+    }
+    return r;
+}
+
+// ժ position ָĽڵ㣬ڵ
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::node_handle_type
+rb_tree<T, Compare, OrderStatistic>::
+extract(iterator position) {
+    return node_handle_type(unlink_node(position.node));
+}
+
+// ڵеĽڵ㣬ֵظ
+template <class T, class Compare, bool OrderStatistic>
+MoperSTL::pair<typename rb_tree<T, Compare, OrderStatistic>::iterator, bool>
+rb_tree<T, Compare, OrderStatistic>::
+insert_unique(node_handle_type&& nh) {
+    if (nh.empty())
+        return MoperSTL::make_pair(end(), false);
+    auto res = get_insert_unique_pos(value_traits::get_key(nh.node_->value));
+    if (!res.second)
+        return MoperSTL::make_pair(iterator(res.first.first), false);
+    return MoperSTL::make_pair(insert_node_at(res.first.first, nh.release(), res.first.second), true);
+}
+
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
+insert_unique(iterator hint, node_handle_type&& nh) {
+    if (nh.empty())
+        return end();
+    if (node_count_ == 0)
+        return insert_node_at(header_, nh.release(), true);
+    auto res = insert_unique_use_hint(hint, value_traits::get_key(nh.node_->value), nh.node_);
+    if (res.second)
+        nh.release();
+    return res.first;
+}
+
+// ڵеĽڵ㣬ֵظ
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
+insert_multi(node_handle_type&& nh) {
+    if (nh.empty())
+        return end();
+    auto res = get_insert_multi_pos(value_traits::get_key(nh.node_->value));
+    return insert_node_at(res.first, nh.release(), res.second);
+}
+
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
+insert_multi(iterator hint, node_handle_type&& nh) {
+    if (nh.empty())
+        return end();
+    if (node_count_ == 0)
+        return insert_node_at(header_, nh.release(), true);
+    node_ptr np = nh.release();
+    return insert_multi_use_hint(hint, value_traits::get_key(np->value), np);
+}
+
+// ϲ src Ľڵ㣬ֵظ
+// src ȽϷʽ򣬵뱾ıȽϷʽܲͬÿڵ㶼Ը²Ҳλ
+template <class T, class Compare, bool OrderStatistic>
+template <class Compare2>
+void rb_tree<T, Compare, OrderStatistic>::
+merge_unique(rb_tree<T, Compare2, OrderStatistic>& src) {
+    if (static_cast<void*>(&src) == static_cast<void*>(this))
+        return;
+    for (auto it = src.begin(); it != src.end();) {
+        auto cur = it++;
+        auto res = get_insert_unique_pos(value_traits::get_key(*cur));
+        if (res.second)
+            insert_node_at(res.first.first, src.unlink_node(cur.node), res.first.second);
+    }
+}
+
+// ϲ src ȫڵ㣬ֵظȼ۵ԪڱԪ֮
+template <class T, class Compare, bool OrderStatistic>
+template <class Compare2>
+void rb_tree<T, Compare, OrderStatistic>::
+merge_multi(rb_tree<T, Compare2, OrderStatistic>& src) {
+    if (static_cast<void*>(&src) == static_cast<void*>(this))
+        return;
+    THROW_LENGTH_ERROR_IF(node_count_ > max_size() - src.size(), "rb_tree<T, Comp>'s size too big");
+    for (auto it = src.begin(); it != src.end();) {
+        auto cur = it++;
+        auto res = get_insert_multi_pos(value_traits::get_key(*cur));
+        insert_node_at(res.first, src.unlink_node(cur.node), res.second);
+    }
+}
+
+//  rhs ڱ֮ȡ rhs СڵΪӵ㣬O(log n)
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
+join(rb_tree& rhs) {
+    if (this == &rhs || rhs.node_count_ == 0)
+        return;
+    THROW_LENGTH_ERROR_IF(node_count_ > max_size() - rhs.node_count_, "rb_tree<T, Comp>'s size too big");
+    subtree l = take_tree();
+    subtree rest;
+    base_ptr k = split_first(rhs.take_tree(), rest);
+    put_tree(join_subtree(l, k, rest).root);
+    node_count_ += rhs.node_count_;
+    rhs.put_tree(nullptr);
+    rhs.node_count_ = 0;
+}
+
+// ֵС key Ԫ right
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
+split(const key_type& key, rb_tree& right) {
+    if (this == &right)
+        return;
+    right.clear();
+    size_type right_count = 0;
+    if constexpr (!OrderStatistic) {
+        // ûСӷָͬʱһ༴Ϊٵһ
+        iterator f = lower_bound(key), b = f;
+        for (size_type n = 0; ; ++n, ++f, --b) {
+            if (f == end()) {
+                right_count = n;
+                break;
+            }
+            if (b == begin()) {
+                right_count = node_count_ - n;
+                break;
+            }
         }
     }
-    return const_iterator(y);
+    subtree l, r;
+    split_lower(take_tree(), key, l, r);
+    if constexpr (OrderStatistic)
+        right_count = augment_type::size_of(r.root);
+    put_tree(l.root);
+    right.put_tree(r.root);
+    node_count_ -= right_count;
+    right.node_count_ = right_count;
 }
 
-//  rb tree
-template <class T, class Compare>
-void rb_tree<T, Compare>::
-swap(rb_tree& rhs) noexcept {
-    if (this != &rhs) {
-        MoperSTL::swap(header_, rhs.header_);
-        MoperSTL::swap(node_count_, rhs.node_count_);
-        MoperSTL::swap(key_comp_, rhs.key_comp_);
+// 
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
+union_unique(rb_tree& other) {
+    if (this == &other || other.node_count_ == 0)
+        return;
+    THROW_LENGTH_ERROR_IF(node_count_ > max_size() - other.node_count_, "rb_tree<T, Comp>'s size too big");
+    size_type dup = 0;
+    put_tree(union_subtree(take_tree(), other.take_tree(), dup).root);
+    node_count_ += other.node_count_ - dup;
+    other.put_tree(nullptr);
+    other.node_count_ = 0;
+}
+
+// 
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
+intersection_unique(const rb_tree& other) {
+    if (this == &other)
+        return;
+    size_type removed = 0;
+    put_tree(intersection_subtree(take_tree(), other.root(), removed).root);
+    node_count_ -= removed;
+}
+
+// 
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
+difference_unique(const rb_tree& other) {
+    if (this == &other) {
+        clear();
+        return;
     }
+    size_type removed = 0;
+    put_tree(difference_subtree(take_tree(), other.root(), removed).root);
+    node_count_ -= removed;
 }
 
 /*****************************************************************************************/
 // helper function
 
 // һ
-template <class T, class Compare>
+template <class T, class Compare, bool OrderStatistic>
 template <class ...Args>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, OrderStatistic>::node_ptr
+rb_tree<T, Compare, OrderStatistic>::
 create_node(Args&&... args) {
     auto tmp = node_allocator::allocate(1);
     try {
         data_allocator::construct(MoperSTL::addressof(tmp->value), MoperSTL::forward<Args>(args)...);
         tmp->left = nullptr;
         tmp->right = nullptr;
-        tmp->parent = nullptr;
+        tmp->parent_color = 0;  // ڵΪգɫΪ
     } catch (...) {
         node_allocator::deallocate(tmp);
         throw;
@@ -1239,48 +1758,49 @@ create_node(Args&&... args) {
 }
 
 // һ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::node_ptr
+rb_tree<T, Compare, OrderStatistic>::
 clone_node(base_ptr x) {
     node_ptr tmp = create_node(x->get_node_ptr()->value);
-    tmp->color = x->color;
+    tmp->set_color(x->get_color());
+    if constexpr (OrderStatistic)
+        tmp->size = static_cast<node_ptr>(x)->size;
     tmp->left = nullptr;
     tmp->right = nullptr;
     return tmp;
 }
 
 // һ
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
 destroy_node(node_ptr p) {
     data_allocator::destroy(&p->value);
     node_allocator::deallocate(p);
 }
 
 // ʼ
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
 rb_tree_init() {
     header_ = base_allocator::allocate(1);
-    header_->color = rb_tree_red;  // header_ ڵɫΪ죬 root 
-    root() = nullptr;
+    header_->parent_color = 0;  // ڵΪգheader_ ڵɫΪ죬 root 
     leftmost() = header_;
     rightmost() = header_;
     node_count_ = 0;
 }
 
 // reset 
-template <class T, class Compare>
-void rb_tree<T, Compare>::reset() {
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::reset() {
     header_ = nullptr;
     node_count_ = 0;
 }
 
 // get_insert_multi_pos 
-template <class T, class Compare>
-MoperSTL::pair<typename rb_tree<T, Compare>::base_ptr, bool>
-rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
+template <class T, class Compare, bool OrderStatistic>
+MoperSTL::pair<typename rb_tree<T, Compare, OrderStatistic>::base_ptr, bool>
+rb_tree<T, Compare, OrderStatistic>::get_insert_multi_pos(const key_type& key) {
     auto x = root();
     auto y = header_;
     bool add_to_left = true;
@@ -1293,9 +1813,9 @@ rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
 }
 
 // get_insert_unique_pos 
-template <class T, class Compare>
-MoperSTL::pair<MoperSTL::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
-rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) { // һ pairһֵΪһ pairĸڵһ bool ʾǷ߲룬
+template <class T, class Compare, bool OrderStatistic>
+MoperSTL::pair<MoperSTL::pair<typename rb_tree<T, Compare, OrderStatistic>::base_ptr, bool>, bool>
+rb_tree<T, Compare, OrderStatistic>::get_insert_unique_pos(const key_type& key) { // һ pairһֵΪһ pairĸڵһ bool ʾǷ߲룬
   // ڶֵΪһ boolʾǷɹ
     auto x = root();
     auto y = header_;
@@ -1316,79 +1836,57 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) { // 
     if (key_comp_(value_traits::get_key(*j), key)) { // ½ڵûظ
         return MoperSTL::make_pair(MoperSTL::make_pair(y, add_to_left), true);
     }
-    // ˣʾ½ڵнڵֵظ
-    return MoperSTL::make_pair(MoperSTL::make_pair(y, add_to_left), false);
+    // ˣʾ½ڵнڵֵظظĽڵ
+    return MoperSTL::make_pair(MoperSTL::make_pair(j.node, add_to_left), false);
 }
 
 // insert_value_at 
 // x Ϊĸڵ㣬 value ΪҪֵadd_to_left ʾǷ߲
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
 insert_value_at(base_ptr x, const value_type& value, bool add_to_left) {
     node_ptr node = create_node(value);
-    node->parent = x;
-    auto base_node = node->get_base_ptr();
-    if (x == header_) {
-        root() = base_node;
-        leftmost() = base_node;
-        rightmost() = base_node;
-    } else if (add_to_left) {
-        x->left = base_node;
-        if (leftmost() == x)
-            leftmost() = base_node;
-    } else {
-        x->right = base_node;
-        if (rightmost() == x)
-            rightmost() = base_node;
-    }
-    rb_tree_insert_rebalance(base_node, root());
+    rb_tree_link_and_rebalance(node->get_base_ptr(), x, add_to_left, header_, augment_type());
     ++node_count_;
     return iterator(node);
 }
 
 //  x ڵ㴦µĽڵ
 // x Ϊĸڵ㣬 node ΪҪĽڵ㣬add_to_left ʾǷ߲
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
 insert_node_at(base_ptr x, node_ptr node, bool add_to_left) {
-    node->parent = x;
-    auto base_node = node->get_base_ptr();
-    if (x == header_) {
-        root() = base_node;
-        leftmost() = base_node;
-        rightmost() = base_node;
-    } else if (add_to_left) {
-        x->left = base_node;
-        if (leftmost() == x)
-            leftmost() = base_node;
-    } else {
-        x->right = base_node;
-        if (rightmost() == x)
-            rightmost() = base_node;
-    }
-    rb_tree_insert_rebalance(base_node, root());
+    rb_tree_link_and_rebalance(node->get_base_ptr(), x, add_to_left, header_, augment_type());
     ++node_count_;
     return iterator(node);
 }
 
 // Ԫأֵظʹ hint
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
-insert_multi_use_hint(iterator hint, key_type key, node_ptr node) {
-  //  hint Ѱҿɲλ
-    auto np = hint.node;
-    auto before = hint;
-    --before;
-    auto bnp = before.node;
-    if (!key_comp_(key, value_traits::get_key(*before)) &&
-        !key_comp_(value_traits::get_key(*hint), key)) { // before <= node <= hint
-        if (bnp->right == nullptr) {
-            return insert_node_at(bnp, node, false);
-        } else if (np->left == nullptr) {
-            return insert_node_at(np, node, true);
+// ½ڵǡλ hint ֮ǰ֮ʱ end() ׷ӣڽڵбһڶӦһûӽڵ㣬
+// ֱӼɣԸ²ңƽľ̯ O(1)ľ̯ӶΪ O(1)
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::iterator
+rb_tree<T, Compare, OrderStatistic>::
+insert_multi_use_hint(iterator hint, const key_type& key, node_ptr node) {
+    if (hint == end() || !key_comp_(value_traits::get_key(*hint), key)) { // node <= hint
+        if (hint == begin())
+            return insert_node_at(hint.node, node, true);
+        auto before = hint;
+        --before;
+        if (!key_comp_(key, value_traits::get_key(*before))) { // before <= node <= hint
+            if (before.node->right == nullptr)
+                return insert_node_at(before.node, node, false);
+            return insert_node_at(hint.node, node, true);
+        }
+    } else { // hint < node
+        auto after = hint;
+        ++after;
+        if (after == end() || !key_comp_(value_traits::get_key(*after), key)) { // hint < node <= after
+            if (hint.node->right == nullptr)
+                return insert_node_at(hint.node, node, false);
+            return insert_node_at(after.node, node, true);
         }
     }
     auto pos = get_insert_multi_pos(key);
@@ -1396,38 +1894,328 @@ insert_multi_use_hint(iterator hint, key_type key, node_ptr node) {
 }
 
 // Ԫأֵظʹ hint
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
-insert_unique_use_hint(iterator hint, key_type key, node_ptr node) {
-  //  hint Ѱҿɲλ
-    auto np = hint.node;
-    auto before = hint;
-    --before;
-    auto bnp = before.node;
-    if (key_comp_(value_traits::get_key(*before), key) &&
-        key_comp_(key, value_traits::get_key(*hint))) { // before < node < hint
-        if (bnp->right == nullptr) {
-            return insert_node_at(bnp, node, false);
-        } else if (np->left == nullptr) {
-            return insert_node_at(np, node, true);
+// ֵѴʱ nodeԪ falseɵ߾δ node
+template <class T, class Compare, bool OrderStatistic>
+MoperSTL::pair<typename rb_tree<T, Compare, OrderStatistic>::iterator, bool>
+rb_tree<T, Compare, OrderStatistic>::
+insert_unique_use_hint(iterator hint, const key_type& key, node_ptr node) {
+    typedef MoperSTL::pair<iterator, bool> result;
+    if (hint == end() || key_comp_(key, value_traits::get_key(*hint))) { // node < hint
+        if (hint == begin())
+            return result(insert_node_at(hint.node, node, true), true);
+        auto before = hint;
+        --before;
+        if (key_comp_(value_traits::get_key(*before), key)) { // before < node < hint
+            if (before.node->right == nullptr)
+                return result(insert_node_at(before.node, node, false), true);
+            return result(insert_node_at(hint.node, node, true), true);
         }
+    } else if (key_comp_(value_traits::get_key(*hint), key)) { // hint < node
+        auto after = hint;
+        ++after;
+        if (after == end() || key_comp_(key, value_traits::get_key(*after))) { // hint < node < after
+            if (hint.node->right == nullptr)
+                return result(insert_node_at(hint.node, node, false), true);
+            return result(insert_node_at(after.node, node, true), true);
+        }
+    } else { //  hint ֵ
+        return result(hint, false);
     }
     auto pos = get_insert_unique_pos(key);
-    if (!pos.second) {
-        destroy_node(node);
-        return pos.first.first;
+    if (!pos.second)
+        return result(iterator(pos.first.first), false);
+    return result(insert_node_at(pos.first.first, node, pos.first.second), true);
+}
+
+// ѽڵ x ժ£ظýڵ㣬ڵԪرֲ
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::node_ptr
+rb_tree<T, Compare, OrderStatistic>::
+unlink_node(base_ptr x) {
+    rb_tree_erase_rebalance(x, header_, augment_type());
+    --node_count_;
+    return static_cast<node_ptr>(x);
+}
+
+// Ϊȡڸ·O(log n)
+// ȡ header ָԭĽڵ㣬 put_tree
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::subtree
+rb_tree<T, Compare, OrderStatistic>::
+take_tree() {
+    subtree t = { root(), 0 };
+    for (base_ptr x = t.root; x != nullptr; x = x->left) {
+        if (!rb_tree_is_red(x))
+            ++t.height;
+    }
+    if (t.root != nullptr)
+        t.root->set_parent(nullptr);
+    return t;
+}
+
+//  x Ϊ¹ҵ header £Сڵ
+template <class T, class Compare, bool OrderStatistic>
+void rb_tree<T, Compare, OrderStatistic>::
+put_tree(base_ptr x) {
+    set_root(x);
+    if (x == nullptr) {
+        leftmost() = header_;
+        rightmost() = header_;
+        return;
+    }
+    rb_tree_set_black(x);  // ĸΪ죬ΪĸΪ
+    x->set_parent(header_);
+    leftmost() = rb_tree_min(x);
+    rightmost() = rb_tree_max(x);
+}
+
+//  t ĸڵӽڵ x ȡΪ
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::subtree
+rb_tree<T, Compare, OrderStatistic>::
+take_child(base_ptr x, const subtree& t) {
+    if (x != nullptr)
+        x->set_parent(nullptr);
+    return subtree{ x, t.height - (rb_tree_is_red(t.root) ? 0 : 1) };
+}
+
+// Խڵ k  l  r
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::subtree
+rb_tree<T, Compare, OrderStatistic>::
+join_subtree(subtree l, base_ptr k, subtree r) {
+    subtree t;
+    t.root = rb_tree_join(l.root, l.height, k, r.root, r.height, t.height, augment_type());
+    return t;
+}
+
+//  l  rûмڵʱȡ r СڵΪӵ
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::subtree
+rb_tree<T, Compare, OrderStatistic>::
+join_subtree(subtree l, subtree r) {
+    if (r.root == nullptr)
+        return l;
+    if (l.root == nullptr)
+        return r;
+    subtree rest;
+    base_ptr k = split_first(r, rest);
+    return join_subtree(l, k, rest);
+}
+
+// ȡǿ t Сڵ㣬ڵ rest
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::base_ptr
+rb_tree<T, Compare, OrderStatistic>::
+split_first(subtree t, subtree& rest) {
+    base_ptr x = t.root;
+    subtree l = take_child(x->left, t);
+    subtree r = take_child(x->right, t);
+    if (l.root == nullptr) {
+        rest = r;
+        return x;
+    }
+    subtree ll;
+    base_ptr k = split_first(l, ll);
+    rest = join_subtree(ll, x, r);
+    return k;
+}
+
+//  key ָ tС key Ԫ l key  r key ȵĽڵ㣨ûΪգ
+template <class T, class Compare, bool OrderStatistic>
+template <class K>
+typename rb_tree<T, Compare, OrderStatistic>::base_ptr
+rb_tree<T, Compare, OrderStatistic>::
+split_subtree(subtree t, const K& key, subtree& l, subtree& r) {
+    if (t.root == nullptr) {
+        l = r = subtree{ nullptr, 0 };
+        return nullptr;
+    }
+    base_ptr x = t.root;
+    subtree lc = take_child(x->left, t);
+    subtree rc = take_child(x->right, t);
+    const key_type& xk = value_traits::get_key(x->get_node_ptr()->value);
+    if (key_comp_(key, xk)) {
+        base_ptr m = split_subtree(lc, key, l, r);
+        r = join_subtree(r, x, rc);
+        return m;
+    }
+    if (key_comp_(xk, key)) {
+        base_ptr m = split_subtree(rc, key, l, r);
+        l = join_subtree(lc, x, l);
+        return m;
+    }
+    l = lc;
+    r = rc;
+    return x;
+}
+
+//  key ָ tС key Ԫ l r
+template <class T, class Compare, bool OrderStatistic>
+template <class K>
+void rb_tree<T, Compare, OrderStatistic>::
+split_lower(subtree t, const K& key, subtree& l, subtree& r) {
+    if (t.root == nullptr) {
+        l = r = subtree{ nullptr, 0 };
+        return;
+    }
+    base_ptr x = t.root;
+    subtree lc = take_child(x->left, t);
+    subtree rc = take_child(x->right, t);
+    if (key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
+        split_lower(rc, key, l, r);
+        l = join_subtree(lc, x, l);
+    } else {
+        split_lower(lc, key, l, r);
+        r = join_subtree(r, x, rc);
+    }
+}
+
+//  t2 ĸָ t1ֱݹ󲢣Ըø t1 ֮ȵĽڵ㣩
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::subtree
+rb_tree<T, Compare, OrderStatistic>::
+union_subtree(subtree t1, subtree t2, size_type& dup) {
+    if (t1.root == nullptr)
+        return t2;
+    if (t2.root == nullptr)
+        return t1;
+    base_ptr x = t2.root;
+    subtree l2 = take_child(x->left, t2);
+    subtree r2 = take_child(x->right, t2);
+    subtree l1, r1;
+    base_ptr m = split_subtree(t1, value_traits::get_key(x->get_node_ptr()->value), l1, r1);
+    subtree l = union_subtree(l1, l2, dup);
+    subtree r = union_subtree(r1, r2, dup);
+    if (m != nullptr) { // ֵظ t1 Ľڵ
+        destroy_node(static_cast<node_ptr>(x));
+        ++dup;
+        return join_subtree(l, m, r);
+    }
+    return join_subtree(l, x, r);
+}
+
+//  other еĽڵ x ָ tֻ x ȵĽڵ㣬x ڵ޸
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::subtree
+rb_tree<T, Compare, OrderStatistic>::
+intersection_subtree(subtree t, base_ptr x, size_type& removed) {
+    if (t.root == nullptr)
+        return t;
+    if (x == nullptr) {
+        removed += erase_since(t.root);
+        return subtree{ nullptr, 0 };
+    }
+    subtree l1, r1;
+    base_ptr m = split_subtree(t, value_traits::get_key(x->get_node_ptr()->value), l1, r1);
+    subtree l = intersection_subtree(l1, x->left, removed);
+    subtree r = intersection_subtree(r1, x->right, removed);
+    if (m != nullptr)
+        return join_subtree(l, m, r);
+    return join_subtree(l, r);
+}
+
+//  other еĽڵ x ָ t x ȵĽڵ㣬x ڵ޸
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::subtree
+rb_tree<T, Compare, OrderStatistic>::
+difference_subtree(subtree t, base_ptr x, size_type& removed) {
+    if (t.root == nullptr || x == nullptr)
+        return t;
+    subtree l1, r1;
+    base_ptr m = split_subtree(t, value_traits::get_key(x->get_node_ptr()->value), l1, r1);
+    subtree l = difference_subtree(l1, x->left, removed);
+    subtree r = difference_subtree(r1, x->right, removed);
+    if (m != nullptr) {
+        destroy_node(static_cast<node_ptr>(m));
+        ++removed;
+    }
+    return join_subtree(l, r);
+}
+
+// is_sorted_range 
+// жǷ񰴼ֵstrict Ϊ true ʱҪϸ
+template <class T, class Compare, bool OrderStatistic>
+template <class InputIterator>
+bool rb_tree<T, Compare, OrderStatistic>::
+is_sorted_range(InputIterator first, InputIterator last, bool strict) const {
+    if (first == last)
+        return true;
+    auto prev = first;
+    for (++first; first != last; ++first, ++prev) {
+        const auto& a = value_traits::get_key(*prev);
+        const auto& b = value_traits::get_key(*first);
+        if (strict ? !key_comp_(a, b) : key_comp_(b, a))
+            return false;
+    }
+    return true;
+}
+
+// build_from_sorted 
+// е n ԪΪһƽĺÿԪֻһΣȽ
+// С 1пӵֻ h  h + 1 ֣h Ϊ
+// Ϊ h ĽڵΪɫΪɫ
+template <class T, class Compare, bool OrderStatistic>
+template <class InputIterator>
+void rb_tree<T, Compare, OrderStatistic>::
+build_from_sorted(InputIterator first, size_type n) {
+    if (n == 0)
+        return;
+    size_type red_depth = 0;
+    while ((static_cast<size_type>(2) << red_depth) - 1 <= n)
+        ++red_depth;
+    auto r = build_since(first, n, 0, red_depth);
+    r->set_parent(header_);
+    set_root(r);
+    leftmost() = rb_tree_min(r);
+    rightmost() = rb_tree_max(r);
+    node_count_ = n;
+}
+
+// build_since 
+// ȡ n Ԫؽĸdepth Ϊ
+template <class T, class Compare, bool OrderStatistic>
+template <class InputIterator>
+typename rb_tree<T, Compare, OrderStatistic>::base_ptr
+rb_tree<T, Compare, OrderStatistic>::
+build_since(InputIterator& first, size_type n, size_type depth, size_type red_depth) {
+    if (n == 0)
+        return nullptr;
+    const size_type left_count = (n - 1) / 2;
+    base_ptr l = build_since(first, left_count, depth + 1, red_depth);
+    node_ptr x = nullptr;
+    try {
+        x = create_node(*first);
+    } catch (...) {
+        if (l != nullptr)
+            erase_since(l);
+        throw;
     }
-    return insert_node_at(pos.first.first, node, pos.first.second);
+    ++first;
+    x->left = l;
+    if (l != nullptr)
+        l->set_parent(x);
+    try {
+        x->right = build_since(first, n - 1 - left_count, depth + 1, red_depth);
+    } catch (...) {
+        erase_since(x);
+        throw;
+    }
+    if (x->right != nullptr)
+        x->right->set_parent(x);
+    x->set_color(depth == red_depth ? rb_tree_red : rb_tree_black);
+    if constexpr (OrderStatistic)
+        x->size = n;
+    return x;
 }
 
 // copy_from 
 // ݹ鸴һڵ x ʼp Ϊ x ĸڵ
-template <class T, class Compare>
-typename rb_tree<T, Compare>::base_ptr
-rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::base_ptr
+rb_tree<T, Compare, OrderStatistic>::copy_from(base_ptr x, base_ptr p) {
     auto top = clone_node(x);
-    top->parent = p;
+    top->set_parent(p);
     try {
         if (x->right)
             top->right = copy_from(x->right, top);
@@ -1436,7 +2224,7 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
         while (x != nullptr) {
             auto y = clone_node(x);
             p->left = y;
-            y->parent = p;
+            y->set_parent(p);
             if (x->right)
                 y->right = copy_from(x->right, y);
             p = y;
@@ -1451,51 +2239,56 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
 
 // erase_since 
 //  x ڵ㿪ʼɾýڵ㼰
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+// ɾĽڵ
+template <class T, class Compare, bool OrderStatistic>
+typename rb_tree<T, Compare, OrderStatistic>::size_type
+rb_tree<T, Compare, OrderStatistic>::
 erase_since(base_ptr x) {
+    size_type n = 0;
     while (x != nullptr) {
-        erase_since(x->right);
+        n += erase_since(x->right);
         auto y = x->left;
-        destroy_node(x->get_node_ptr());
+        destroy_node(static_cast<node_ptr>(x));
         x = y;
+        ++n;
     }
+    return n;
 }
 
 // رȽϲ
-template <class T, class Compare>
-bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, bool OrderStatistic>
+bool operator==(const rb_tree<T, Compare, OrderStatistic>& lhs, const rb_tree<T, Compare, OrderStatistic>& rhs) {
     return lhs.size() == rhs.size() && MoperSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T, class Compare>
-bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, bool OrderStatistic>
+bool operator<(const rb_tree<T, Compare, OrderStatistic>& lhs, const rb_tree<T, Compare, OrderStatistic>& rhs) {
     return MoperSTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T, class Compare>
-bool operator!=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, bool OrderStatistic>
+bool operator!=(const rb_tree<T, Compare, OrderStatistic>& lhs, const rb_tree<T, Compare, OrderStatistic>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T, class Compare>
-bool operator>(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, bool OrderStatistic>
+bool operator>(const rb_tree<T, Compare, OrderStatistic>& lhs, const rb_tree<T, Compare, OrderStatistic>& rhs) {
     return rhs < lhs;
 }
 
-template <class T, class Compare>
-bool operator<=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, bool OrderStatistic>
+bool operator<=(const rb_tree<T, Compare, OrderStatistic>& lhs, const rb_tree<T, Compare, OrderStatistic>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T, class Compare>
-bool operator>=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, bool OrderStatistic>
+bool operator>=(const rb_tree<T, Compare, OrderStatistic>& lhs, const rb_tree<T, Compare, OrderStatistic>& rhs) {
     return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <class T, class Compare>
-void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept {
+template <class T, class Compare, bool OrderStatistic>
+void swap(rb_tree<T, Compare, OrderStatistic>& lhs, rb_tree<T, Compare, OrderStatistic>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
@@ -1833,6 +1833,67 @@ bool operator>=(const basic_string<CharType, CharTraits>& lhs,
     return lhs.compare(rhs) >= 0;
 }
 
+//  C ַȽϣʱ basic_string͸Ƚ less<void>칹
+template <class CharType, class CharTraits>
+bool operator==(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs) {
+    return lhs.compare(rhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator!=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs) {
+    return lhs.compare(rhs) != 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs) {
+    return lhs.compare(rhs) < 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs) {
+    return lhs.compare(rhs) <= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs) {
+    return lhs.compare(rhs) > 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs) {
+    return lhs.compare(rhs) >= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator==(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs) {
+    return rhs.compare(lhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator!=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs) {
+    return rhs.compare(lhs) != 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs) {
+    return rhs.compare(lhs) > 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs) {
+    return rhs.compare(lhs) >= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs) {
+    return rhs.compare(lhs) < 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs) {
+    return rhs.compare(lhs) <= 0;
+}
+
 //  mystl  swap
 template <class CharType, class CharTraits>
 void swap(basic_string<CharType, CharTraits>& lhs,
@@ -1841,11 +1902,19 @@ void swap(basic_string<CharType, CharTraits>& lhs,
 }
 
 // ػ MoperSTL::hash
-template <class CharType, class CharTraits>
-struct hash<basic_string<CharType, CharTraits>> {
-    size_t operator()(const basic_string<CharType, CharTraits>& str) {
-        return bitwise_hash((const unsigned char*)str.c_str(),
-                            str.size() * sizeof(CharType));
+// ùϣ͸ģ C ַͬ basic_string õͬĹϣֵ
+//  equal_to<void> ʹʱֱַ
+template <class CharType, class CharTraits, class Policy>
+struct hash<basic_string<CharType, CharTraits>, Policy> {
+    typedef int is_transparent;
+
+    size_t operator()(const basic_string<CharType, CharTraits>& str) const {
+        return Policy::hash_bytes((const unsigned char*)str.c_str(),
+                                  str.size() * sizeof(CharType));
+    }
+    size_t operator()(const CharType* str) const {
+        return Policy::hash_bytes((const unsigned char*)str,
+                                  CharTraits::length(str) * sizeof(CharType));
     }
 };
 
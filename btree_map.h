@@ -0,0 +1,520 @@
+#ifndef MOPER_STL_BTREE_MAP_H
+#define MOPER_STL_BTREE_MAP_H
+
+#include "__btree.h"
+#include "functional.h"
+
+namespace MoperSTL {
+
+// ģ btree_mapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::lessĴ B ڵСֽڣ
+// ɾʹеʧЧerase رɾԪ֮λ
+template <class Key, class T, class Compare = MoperSTL::less<Key>, std::size_t NodeBytes = BTREE_NODE_BYTES>
+class btree_map {
+public:
+  // btree_map Ƕͱ
+    typedef Key                        key_type;
+    typedef T                          mapped_type;
+    typedef MoperSTL::pair<const Key, T>  value_type;
+    typedef Compare                    key_compare;
+
+    // һ functorԪرȽ
+    class value_compare : public binary_function <value_type, value_type, bool> {
+        friend class btree_map<Key, T, Compare, NodeBytes>;
+    private:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+    public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);  // ȽϼֵĴС
+        }
+    };
+
+private:
+  //  MoperSTL::btree Ϊײ
+    typedef MoperSTL::btree<value_type, key_compare, NodeBytes>  base_type;
+    base_type tree_;
+
+public:
+  // ʹ btree ͱ
+    typedef typename base_type::pointer                pointer;
+    typedef typename base_type::const_pointer          const_pointer;
+    typedef typename base_type::reference              reference;
+    typedef typename base_type::const_reference        const_reference;
+    typedef typename base_type::iterator               iterator;
+    typedef typename base_type::const_iterator         const_iterator;
+    typedef typename base_type::reverse_iterator       reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type              size_type;
+    typedef typename base_type::difference_type        difference_type;
+    typedef typename base_type::allocator_type         allocator_type;
+
+public:
+  // 졢ơƶֵ
+
+    btree_map() = default;
+
+    template <class InputIterator>
+    btree_map(InputIterator first, InputIterator last)
+        :tree_() {
+        tree_.insert_unique(first, last);
+    }
+
+    btree_map(std::initializer_list<value_type> ilist)
+        :tree_() {
+        tree_.insert_unique(ilist.begin(), ilist.end());
+    }
+
+    btree_map(const btree_map& rhs)
+        :tree_(rhs.tree_) {}
+    btree_map(btree_map&& rhs) noexcept
+        :tree_(MoperSTL::move(rhs.tree_)) {}
+
+    btree_map& operator=(const btree_map& rhs) {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+    btree_map& operator=(btree_map&& rhs) {
+        tree_ = MoperSTL::move(rhs.tree_);
+        return *this;
+    }
+
+    btree_map& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ؽӿ
+
+    key_compare            key_comp()      const { return tree_.key_comp(); }
+    value_compare          value_comp()    const { return value_compare(tree_.key_comp()); }
+    allocator_type         get_allocator() const { return tree_.get_allocator(); }
+
+    // 
+
+    iterator               begin()         noexcept {
+        return tree_.begin();
+    }
+    const_iterator         begin()   const noexcept {
+        return tree_.begin();
+    }
+    iterator               end()           noexcept {
+        return tree_.end();
+    }
+    const_iterator         end()     const noexcept {
+        return tree_.end();
+    }
+
+    reverse_iterator       rbegin()        noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin()  const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator       rend()          noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend()    const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator         cbegin()  const noexcept {
+        return begin();
+    }
+    const_iterator         cend()    const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend()   const noexcept {
+        return rend();
+    }
+
+// 
+    bool                   empty()    const noexcept { return tree_.empty(); }
+    size_type              size()     const noexcept { return tree_.size(); }
+    size_type              max_size() const noexcept { return tree_.max_size(); }
+
+    // Ԫ
+
+    // ֵڣat ׳һ쳣
+    mapped_type& at(const key_type& key) {
+        iterator it = lower_bound(key);
+        // it->first >= key
+        THROW_OUT_OF_RANGE_IF(it == end() || key_comp()(it->first, key),
+                              "btree_map<Key, T> no such element exists");
+        return it->second;
+    }
+    const mapped_type& at(const key_type& key) const {
+        const_iterator it = lower_bound(key);
+        // it->first >= key
+        THROW_OUT_OF_RANGE_IF(it == end() || key_comp()(it->first, key),
+                              "btree_map<Key, T> no such element exists");
+        return it->second;
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        iterator it = lower_bound(key);
+        // it->first >= key
+        if (it == end() || key_comp()(key, it->first))
+            it = emplace_hint(it, key, T{});
+        return it->second;
+    }
+    mapped_type& operator[](key_type&& key) {
+        iterator it = lower_bound(key);
+        // it->first >= key
+        if (it == end() || key_comp()(key, it->first))
+            it = emplace_hint(it, MoperSTL::move(key), T{});
+        return it->second;
+    }
+
+    // ɾ
+
+    template <class ...Args>
+    pair<iterator, bool> emplace(Args&& ...args) {
+        return tree_.emplace_unique(MoperSTL::forward<Args>(args)...);
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(iterator hint, Args&& ...args) {
+        return tree_.emplace_unique_use_hint(hint, MoperSTL::forward<Args>(args)...);
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        return tree_.insert_unique(value);
+    }
+    pair<iterator, bool> insert(value_type&& value) {
+        return tree_.insert_unique(MoperSTL::move(value));
+    }
+
+    iterator insert(iterator hint, const value_type& value) {
+        return tree_.insert_unique(hint, value);
+    }
+    iterator insert(iterator hint, value_type&& value) {
+        return tree_.insert_unique(hint, MoperSTL::move(value));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree_.insert_unique(first, last);
+    }
+
+    iterator  erase(iterator position) { return tree_.erase(position); }
+    size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+    iterator  erase(iterator first, iterator last) { return tree_.erase(first, last); }
+
+    void      clear() { tree_.clear(); }
+
+    // btree_map ز
+
+    iterator       find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key)        const { return tree_.find(key); }
+
+    size_type      count(const key_type& key)       const { return tree_.count_unique(key); }
+
+    iterator       lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+
+    iterator       upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    pair<iterator, iterator>
+        equal_range(const key_type& key) {
+        return tree_.equal_range_unique(key);
+    }
+
+    pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        return tree_.equal_range_unique(key);
+    }
+
+    void           swap(btree_map& rhs) noexcept {
+        tree_.swap(rhs.tree_);
+    }
+
+public:
+    friend bool operator==(const btree_map& lhs, const btree_map& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator< (const btree_map& lhs, const btree_map& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+// رȽϲ
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator==(const btree_map<Key, T, Compare, NodeBytes>& lhs, const btree_map<Key, T, Compare, NodeBytes>& rhs) {
+    return lhs == rhs;
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator<(const btree_map<Key, T, Compare, NodeBytes>& lhs, const btree_map<Key, T, Compare, NodeBytes>& rhs) {
+    return lhs < rhs;
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator!=(const btree_map<Key, T, Compare, NodeBytes>& lhs, const btree_map<Key, T, Compare, NodeBytes>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator>(const btree_map<Key, T, Compare, NodeBytes>& lhs, const btree_map<Key, T, Compare, NodeBytes>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator<=(const btree_map<Key, T, Compare, NodeBytes>& lhs, const btree_map<Key, T, Compare, NodeBytes>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator>=(const btree_map<Key, T, Compare, NodeBytes>& lhs, const btree_map<Key, T, Compare, NodeBytes>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  mystl  swap
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+void swap(btree_map<Key, T, Compare, NodeBytes>& lhs, btree_map<Key, T, Compare, NodeBytes>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// ģ btree_multimapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::lessĴ B ڵСֽڣ
+// ɾʹеʧЧerase رɾԪ֮λ
+template <class Key, class T, class Compare = MoperSTL::less<Key>, std::size_t NodeBytes = BTREE_NODE_BYTES>
+class btree_multimap {
+public:
+  // btree_multimap ͱ
+    typedef Key                        key_type;
+    typedef T                          mapped_type;
+    typedef MoperSTL::pair<const Key, T>  value_type;
+    typedef Compare                    key_compare;
+
+    // һ functorԪرȽ
+    class value_compare : public binary_function <value_type, value_type, bool> {
+        friend class btree_multimap<Key, T, Compare, NodeBytes>;
+    private:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+    public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+    };
+
+private:
+  //  MoperSTL::btree Ϊײ
+    typedef MoperSTL::btree<value_type, key_compare, NodeBytes>  base_type;
+    base_type tree_;
+
+public:
+  // ʹ btree ͱ
+    typedef typename base_type::pointer                pointer;
+    typedef typename base_type::const_pointer          const_pointer;
+    typedef typename base_type::reference              reference;
+    typedef typename base_type::const_reference        const_reference;
+    typedef typename base_type::iterator               iterator;
+    typedef typename base_type::const_iterator         const_iterator;
+    typedef typename base_type::reverse_iterator       reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type              size_type;
+    typedef typename base_type::difference_type        difference_type;
+    typedef typename base_type::allocator_type         allocator_type;
+
+public:
+  // 졢ơƶ
+
+    btree_multimap() = default;
+
+    template <class InputIterator>
+    btree_multimap(InputIterator first, InputIterator last)
+        :tree_() {
+        tree_.insert_multi(first, last);
+    }
+    btree_multimap(std::initializer_list<value_type> ilist)
+        :tree_() {
+        tree_.insert_multi(ilist.begin(), ilist.end());
+    }
+
+    btree_multimap(const btree_multimap& rhs)
+        :tree_(rhs.tree_) {}
+    btree_multimap(btree_multimap&& rhs) noexcept
+        :tree_(MoperSTL::move(rhs.tree_)) {}
+
+    btree_multimap& operator=(const btree_multimap& rhs) {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+    btree_multimap& operator=(btree_multimap&& rhs) {
+        tree_ = MoperSTL::move(rhs.tree_);
+        return *this;
+    }
+
+    btree_multimap& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_multi(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ؽӿ
+
+    key_compare            key_comp()      const { return tree_.key_comp(); }
+    value_compare          value_comp()    const { return value_compare(tree_.key_comp()); }
+    allocator_type         get_allocator() const { return tree_.get_allocator(); }
+
+    // 
+
+    iterator               begin()         noexcept {
+        return tree_.begin();
+    }
+    const_iterator         begin()   const noexcept {
+        return tree_.begin();
+    }
+    iterator               end()           noexcept {
+        return tree_.end();
+    }
+    const_iterator         end()     const noexcept {
+        return tree_.end();
+    }
+
+    reverse_iterator       rbegin()        noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin()  const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator       rend()          noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend()    const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator         cbegin()  const noexcept {
+        return begin();
+    }
+    const_iterator         cend()    const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend()   const noexcept {
+        return rend();
+    }
+
+// 
+    bool                   empty()    const noexcept { return tree_.empty(); }
+    size_type              size()     const noexcept { return tree_.size(); }
+    size_type              max_size() const noexcept { return tree_.max_size(); }
+
+    // ɾ
+
+    template <class ...Args>
+    iterator emplace(Args&& ...args) {
+        return tree_.emplace_multi(MoperSTL::forward<Args>(args)...);
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(iterator hint, Args&& ...args) {
+        return tree_.emplace_multi_use_hint(hint, MoperSTL::forward<Args>(args)...);
+    }
+
+    iterator insert(const value_type& value) {
+        return tree_.insert_multi(value);
+    }
+    iterator insert(value_type&& value) {
+        return tree_.insert_multi(MoperSTL::move(value));
+    }
+
+    iterator insert(iterator hint, const value_type& value) {
+        return tree_.insert_multi(hint, value);
+    }
+    iterator insert(iterator hint, value_type&& value) {
+        return tree_.insert_multi(hint, MoperSTL::move(value));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree_.insert_multi(first, last);
+    }
+
+    iterator       erase(iterator position) { return tree_.erase(position); }
+    size_type      erase(const key_type& key) { return tree_.erase_multi(key); }
+    iterator       erase(iterator first, iterator last) { return tree_.erase(first, last); }
+
+    void           clear() { tree_.clear(); }
+
+    // btree_multimap ز
+
+    iterator       find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key)        const { return tree_.find(key); }
+
+    size_type      count(const key_type& key)       const { return tree_.count_multi(key); }
+
+    iterator       lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+
+    iterator       upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    pair<iterator, iterator>
+        equal_range(const key_type& key) {
+        return tree_.equal_range_multi(key);
+    }
+
+    pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        return tree_.equal_range_multi(key);
+    }
+
+    void swap(btree_multimap& rhs) noexcept {
+        tree_.swap(rhs.tree_);
+    }
+
+public:
+    friend bool operator==(const btree_multimap& lhs, const btree_multimap& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator< (const btree_multimap& lhs, const btree_multimap& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+// رȽϲ
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator==(const btree_multimap<Key, T, Compare, NodeBytes>& lhs, const btree_multimap<Key, T, Compare, NodeBytes>& rhs) {
+    return lhs == rhs;
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator<(const btree_multimap<Key, T, Compare, NodeBytes>& lhs, const btree_multimap<Key, T, Compare, NodeBytes>& rhs) {
+    return lhs < rhs;
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator!=(const btree_multimap<Key, T, Compare, NodeBytes>& lhs, const btree_multimap<Key, T, Compare, NodeBytes>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator>(const btree_multimap<Key, T, Compare, NodeBytes>& lhs, const btree_multimap<Key, T, Compare, NodeBytes>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator<=(const btree_multimap<Key, T, Compare, NodeBytes>& lhs, const btree_multimap<Key, T, Compare, NodeBytes>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+bool operator>=(const btree_multimap<Key, T, Compare, NodeBytes>& lhs, const btree_multimap<Key, T, Compare, NodeBytes>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  mystl  swap
+template <class Key, class T, class Compare, std::size_t NodeBytes>
+void swap(btree_multimap<Key, T, Compare, NodeBytes>& lhs, btree_multimap<Key, T, Compare, NodeBytes>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+
+}; /* MoperSTL */
+
+#endif
@@ -0,0 +1,459 @@
+#ifndef MOPER_STL_BTREE_SET_H
+#define MOPER_STL_BTREE_SET_H
+
+#include "__btree.h"
+#include "functional.h"
+
+namespace MoperSTL {
+
+// ģ btree_setֵظ
+// һֵֵͣȽϷʽȱʡʹ MoperSTL::less B ڵСֽڣ
+// ɾʹеʧЧerase رɾԪ֮λ
+template <class Key, class Compare = MoperSTL::less<Key>, std::size_t NodeBytes = BTREE_NODE_BYTES>
+class btree_set {
+public:
+    typedef Key        key_type;
+    typedef Key        value_type;
+    typedef Compare    key_compare;
+    typedef Compare    value_compare;
+
+private:
+  //  MoperSTL::btree Ϊײ
+    typedef MoperSTL::btree<value_type, key_compare, NodeBytes>  base_type;
+    base_type tree_;
+
+public:
+  // ʹ btree ͱ
+    typedef typename base_type::const_pointer          pointer;
+    typedef typename base_type::const_pointer          const_pointer;
+    typedef typename base_type::const_reference        reference;
+    typedef typename base_type::const_reference        const_reference;
+    typedef typename base_type::const_iterator         iterator;
+    typedef typename base_type::const_iterator         const_iterator;
+    typedef typename base_type::const_reverse_iterator reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type              size_type;
+    typedef typename base_type::difference_type        difference_type;
+    typedef typename base_type::allocator_type         allocator_type;
+
+public:
+  // 졢ơƶ
+    btree_set() = default;
+
+    template <class InputIterator>
+    btree_set(InputIterator first, InputIterator last)
+        :tree_() {
+        tree_.insert_unique(first, last);
+    }
+    btree_set(std::initializer_list<value_type> ilist)
+        :tree_() {
+        tree_.insert_unique(ilist.begin(), ilist.end());
+    }
+
+    btree_set(const btree_set& rhs)
+        :tree_(rhs.tree_) {}
+    btree_set(btree_set&& rhs) noexcept
+        :tree_(MoperSTL::move(rhs.tree_)) {}
+
+    btree_set& operator=(const btree_set& rhs) {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+    btree_set& operator=(btree_set&& rhs) {
+        tree_ = MoperSTL::move(rhs.tree_);
+        return *this;
+    }
+    btree_set& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ؽӿ
+
+    key_compare      key_comp()      const { return tree_.key_comp(); }
+    value_compare    value_comp()    const { return tree_.key_comp(); }
+    allocator_type   get_allocator() const { return tree_.get_allocator(); }
+
+    // 
+
+    iterator               begin()         noexcept {
+        return tree_.begin();
+    }
+    const_iterator         begin()   const noexcept {
+        return tree_.begin();
+    }
+    iterator               end()           noexcept {
+        return tree_.end();
+    }
+    const_iterator         end()     const noexcept {
+        return tree_.end();
+    }
+
+    reverse_iterator       rbegin()        noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin()  const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator       rend()          noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend()    const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator         cbegin()  const noexcept {
+        return begin();
+    }
+    const_iterator         cend()    const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend()   const noexcept {
+        return rend();
+    }
+
+// 
+    bool                   empty()    const noexcept { return tree_.empty(); }
+    size_type              size()     const noexcept { return tree_.size(); }
+    size_type              max_size() const noexcept { return tree_.max_size(); }
+
+    // ɾ
+
+    template <class ...Args>
+    pair<iterator, bool> emplace(Args&& ...args) {
+        auto res = tree_.emplace_unique(MoperSTL::forward<Args>(args)...);
+        return pair<iterator, bool>(res.first, res.second);
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(iterator hint, Args&& ...args) {
+        return tree_.emplace_unique_use_hint(hint, MoperSTL::forward<Args>(args)...);
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        auto res = tree_.insert_unique(value);
+        return pair<iterator, bool>(res.first, res.second);
+    }
+    pair<iterator, bool> insert(value_type&& value) {
+        auto res = tree_.insert_unique(MoperSTL::move(value));
+        return pair<iterator, bool>(res.first, res.second);
+    }
+
+    iterator insert(iterator hint, const value_type& value) {
+        return tree_.insert_unique(hint, value);
+    }
+    iterator insert(iterator hint, value_type&& value) {
+        return tree_.insert_unique(hint, MoperSTL::move(value));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree_.insert_unique(first, last);
+    }
+
+    iterator  erase(iterator position) { return tree_.erase(position); }
+    size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+    iterator  erase(iterator first, iterator last) { return tree_.erase(first, last); }
+
+    void      clear() { tree_.clear(); }
+
+    // btree_set ز
+
+    iterator       find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key)        const { return tree_.find(key); }
+
+    size_type      count(const key_type& key)       const { return tree_.count_unique(key); }
+
+    iterator       lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+
+    iterator       upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    pair<iterator, iterator>
+        equal_range(const key_type& key) {
+        return static_cast<const base_type&>(tree_).equal_range_unique(key);
+    }
+
+    pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        return tree_.equal_range_unique(key);
+    }
+
+    void swap(btree_set& rhs) noexcept {
+        tree_.swap(rhs.tree_);
+    }
+
+public:
+    friend bool operator==(const btree_set& lhs, const btree_set& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator< (const btree_set& lhs, const btree_set& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+// رȽϲ
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator==(const btree_set<Key, Compare, NodeBytes>& lhs, const btree_set<Key, Compare, NodeBytes>& rhs) {
+    return lhs == rhs;
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator<(const btree_set<Key, Compare, NodeBytes>& lhs, const btree_set<Key, Compare, NodeBytes>& rhs) {
+    return lhs < rhs;
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator!=(const btree_set<Key, Compare, NodeBytes>& lhs, const btree_set<Key, Compare, NodeBytes>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator>(const btree_set<Key, Compare, NodeBytes>& lhs, const btree_set<Key, Compare, NodeBytes>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator<=(const btree_set<Key, Compare, NodeBytes>& lhs, const btree_set<Key, Compare, NodeBytes>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator>=(const btree_set<Key, Compare, NodeBytes>& lhs, const btree_set<Key, Compare, NodeBytes>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  mystl  swap
+template <class Key, class Compare, std::size_t NodeBytes>
+void swap(btree_set<Key, Compare, NodeBytes>& lhs, btree_set<Key, Compare, NodeBytes>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// ģ btree_multisetֵظ
+// һֵֵͣȽϷʽȱʡʹ MoperSTL::less B ڵСֽڣ
+// ɾʹеʧЧerase رɾԪ֮λ
+template <class Key, class Compare = MoperSTL::less<Key>, std::size_t NodeBytes = BTREE_NODE_BYTES>
+class btree_multiset {
+public:
+    typedef Key        key_type;
+    typedef Key        value_type;
+    typedef Compare    key_compare;
+    typedef Compare    value_compare;
+
+private:
+  //  MoperSTL::btree Ϊײ
+    typedef MoperSTL::btree<value_type, key_compare, NodeBytes>  base_type;
+    base_type tree_;  //  btree  btree_multiset
+
+public:
+  // ʹ btree ͱ
+    typedef typename base_type::const_pointer          pointer;
+    typedef typename base_type::const_pointer          const_pointer;
+    typedef typename base_type::const_reference        reference;
+    typedef typename base_type::const_reference        const_reference;
+    typedef typename base_type::const_iterator         iterator;
+    typedef typename base_type::const_iterator         const_iterator;
+    typedef typename base_type::const_reverse_iterator reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type              size_type;
+    typedef typename base_type::difference_type        difference_type;
+    typedef typename base_type::allocator_type         allocator_type;
+
+public:
+  // 졢ơƶ
+    btree_multiset() = default;
+
+    template <class InputIterator>
+    btree_multiset(InputIterator first, InputIterator last)
+        :tree_() {
+        tree_.insert_multi(first, last);
+    }
+    btree_multiset(std::initializer_list<value_type> ilist)
+        :tree_() {
+        tree_.insert_multi(ilist.begin(), ilist.end());
+    }
+
+    btree_multiset(const btree_multiset& rhs)
+        :tree_(rhs.tree_) {}
+    btree_multiset(btree_multiset&& rhs) noexcept
+        :tree_(MoperSTL::move(rhs.tree_)) {}
+
+    btree_multiset& operator=(const btree_multiset& rhs) {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+    btree_multiset& operator=(btree_multiset&& rhs) {
+        tree_ = MoperSTL::move(rhs.tree_);
+        return *this;
+    }
+    btree_multiset& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_multi(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ؽӿ
+
+    key_compare      key_comp()      const { return tree_.key_comp(); }
+    value_compare    value_comp()    const { return tree_.key_comp(); }
+    allocator_type   get_allocator() const { return tree_.get_allocator(); }
+
+    // 
+
+    iterator               begin()         noexcept {
+        return tree_.begin();
+    }
+    const_iterator         begin()   const noexcept {
+        return tree_.begin();
+    }
+    iterator               end()           noexcept {
+        return tree_.end();
+    }
+    const_iterator         end()     const noexcept {
+        return tree_.end();
+    }
+
+    reverse_iterator       rbegin()        noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin()  const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator       rend()          noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend()    const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator         cbegin()  const noexcept {
+        return begin();
+    }
+    const_iterator         cend()    const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend()   const noexcept {
+        return rend();
+    }
+
+// 
+    bool                   empty()    const noexcept { return tree_.empty(); }
+    size_type              size()     const noexcept { return tree_.size(); }
+    size_type              max_size() const noexcept { return tree_.max_size(); }
+
+    // ɾ
+
+    template <class ...Args>
+    iterator emplace(Args&& ...args) {
+        return tree_.emplace_multi(MoperSTL::forward<Args>(args)...);
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(iterator hint, Args&& ...args) {
+        return tree_.emplace_multi_use_hint(hint, MoperSTL::forward<Args>(args)...);
+    }
+
+    iterator insert(const value_type& value) {
+        return tree_.insert_multi(value);
+    }
+    iterator insert(value_type&& value) {
+        return tree_.insert_multi(MoperSTL::move(value));
+    }
+
+    iterator insert(iterator hint, const value_type& value) {
+        return tree_.insert_multi(hint, value);
+    }
+    iterator insert(iterator hint, value_type&& value) {
+        return tree_.insert_multi(hint, MoperSTL::move(value));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree_.insert_multi(first, last);
+    }
+
+    iterator       erase(iterator position) { return tree_.erase(position); }
+    size_type      erase(const key_type& key) { return tree_.erase_multi(key); }
+    iterator       erase(iterator first, iterator last) { return tree_.erase(first, last); }
+
+    void           clear() { tree_.clear(); }
+
+    // btree_multiset ز
+
+    iterator       find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key)        const { return tree_.find(key); }
+
+    size_type      count(const key_type& key)       const { return tree_.count_multi(key); }
+
+    iterator       lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+
+    iterator       upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    pair<iterator, iterator>
+        equal_range(const key_type& key) {
+        return static_cast<const base_type&>(tree_).equal_range_multi(key);
+    }
+
+    pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        return tree_.equal_range_multi(key);
+    }
+
+    void swap(btree_multiset& rhs) noexcept {
+        tree_.swap(rhs.tree_);
+    }
+
+public:
+    friend bool operator==(const btree_multiset& lhs, const btree_multiset& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator< (const btree_multiset& lhs, const btree_multiset& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+// رȽϲ
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator==(const btree_multiset<Key, Compare, NodeBytes>& lhs, const btree_multiset<Key, Compare, NodeBytes>& rhs) {
+    return lhs == rhs;
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator<(const btree_multiset<Key, Compare, NodeBytes>& lhs, const btree_multiset<Key, Compare, NodeBytes>& rhs) {
+    return lhs < rhs;
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator!=(const btree_multiset<Key, Compare, NodeBytes>& lhs, const btree_multiset<Key, Compare, NodeBytes>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator>(const btree_multiset<Key, Compare, NodeBytes>& lhs, const btree_multiset<Key, Compare, NodeBytes>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator<=(const btree_multiset<Key, Compare, NodeBytes>& lhs, const btree_multiset<Key, Compare, NodeBytes>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class Compare, std::size_t NodeBytes>
+bool operator>=(const btree_multiset<Key, Compare, NodeBytes>& lhs, const btree_multiset<Key, Compare, NodeBytes>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  mystl  swap
+template <class Key, class Compare, std::size_t NodeBytes>
+void swap(btree_multiset<Key, Compare, NodeBytes>& lhs, btree_multiset<Key, Compare, NodeBytes>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+
+}; /* MOPER_STL_BTREE_SET_H */
+
+#endif
@@ -0,0 +1,610 @@
+#ifndef MOPER_STL_CIRCULAR_BUFFER_H
+#define MOPER_STL_CIRCULAR_BUFFER_H
+
+#include <initializer_list>
+#include "exceptdef.h"
+#include "memory.h"
+#include "algorithm.h"
+#include "iterator.h"
+#include "utility.h"
+
+namespace MoperSTL {
+
+// circular_buffer ȱʡ
+#ifndef CIRCULAR_BUFFER_INIT_SIZE
+#define CIRCULAR_BUFFER_INIT_SIZE 16
+#endif
+
+// ʱĴ
+// cb_overwrite : ɵԪأpush_back ͷpush_front β
+// cb_reject    : ܾд룬push ϵк false
+// cb_throw     : ܾд벢׳ length_error޷鷵ֵĳϣ queue::push
+enum class circular_buffer_policy { cb_overwrite, cb_reject, cb_throw };
+
+//  n ȡΪ 2 ݣСΪ 1
+inline std::size_t __cb_round_up_pow2(std::size_t n) {
+    std::size_t cap = 1;
+    while (cap < n)
+        cap <<= 1;
+    return cap;
+}
+
+// circular_buffer ĵ
+// pos Ϊδȡģ߼±꣬ʵλΪ buf + (pos & mask)ͷβ±Ȼ
+template <class T, class Ref, class Ptr>
+struct __circular_buffer_iterator : public MoperSTL::iterator<MoperSTL::random_access_iterator_tag, T> {
+    typedef __circular_buffer_iterator<T, T&, T*>             iterator;
+    typedef __circular_buffer_iterator<T, const T&, const T*> const_iterator;
+    typedef __circular_buffer_iterator                        self;
+
+    typedef T                 value_type;
+    typedef Ptr               pointer;
+    typedef Ref               reference;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+    typedef T*                value_pointer;
+
+    // Ա
+    value_pointer buf;   // ׵ַ
+    size_type     mask;  //  - 1
+    size_type     pos;   // ߼±
+
+    // 졢ƺ
+    __circular_buffer_iterator() noexcept
+        :buf(nullptr), mask(0), pos(0) {}
+
+    __circular_buffer_iterator(value_pointer b, size_type m, size_type p) noexcept
+        :buf(b), mask(m), pos(p) {}
+
+    __circular_buffer_iterator(const iterator& rhs) noexcept
+        :buf(rhs.buf), mask(rhs.mask), pos(rhs.pos) {}
+
+    self& operator=(const iterator& rhs) noexcept {
+        buf = rhs.buf;
+        mask = rhs.mask;
+        pos = rhs.pos;
+        return *this;
+    }
+
+    // 
+    reference operator*()  const { return buf[pos & mask]; }
+    pointer   operator->() const { return buf + (pos & mask); }
+    reference operator[](difference_type n) const { return buf[(pos + n) & mask]; }
+
+    difference_type operator-(const self& x) const {
+        return static_cast<difference_type>(pos - x.pos);
+    }
+
+    self& operator++() { ++pos; return *this; }
+    self  operator++(int) { self tmp = *this; ++pos; return tmp; }
+    self& operator--() { --pos; return *this; }
+    self  operator--(int) { self tmp = *this; --pos; return tmp; }
+
+    self& operator+=(difference_type n) { pos += n; return *this; }
+    self  operator+ (difference_type n) const { self tmp = *this; return tmp += n; }
+    self& operator-=(difference_type n) { pos -= n; return *this; }
+    self  operator- (difference_type n) const { self tmp = *this; return tmp -= n; }
+
+    // رȽϲ߼±갴 begin ľȽϣӦ±
+    bool operator==(const self& rhs) const { return pos == rhs.pos; }
+    bool operator!=(const self& rhs) const { return pos != rhs.pos; }
+    bool operator< (const self& rhs) const { return (*this - rhs) < 0; }
+    bool operator> (const self& rhs) const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+// ģ circular_buffer
+// ģ T ͣPolicy ʱĴ
+//  2 ݣ±ֻһΰλ룻ԪڴΪ䣬ͨ array_one / array_two д
+// Ϊ queue ĵײMoperSTL::queue<T, MoperSTL::circular_buffer<T>>
+template <class T, circular_buffer_policy Policy = circular_buffer_policy::cb_overwrite>
+class circular_buffer {
+public:
+    // circular_buffer ͱ
+    typedef MoperSTL::allocator<T>                      allocator_type;
+    typedef MoperSTL::allocator<T>                      data_allocator;
+
+    typedef typename allocator_type::value_type      value_type;
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::size_type       size_type;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef __circular_buffer_iterator<T, T&, T*>             iterator;
+    typedef __circular_buffer_iterator<T, const T&, const T*> const_iterator;
+    typedef MoperSTL::reverse_iterator<iterator>        reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+    // һ䣺׵ַԪظ
+    typedef MoperSTL::pair<pointer, size_type>          array_range;
+    typedef MoperSTL::pair<const_pointer, size_type>    const_array_range;
+
+    static constexpr circular_buffer_policy policy = Policy;
+
+    allocator_type get_allocator() { return allocator_type(); }
+
+private:
+    // ĸһ circular_buffer
+    pointer   buf_;   // ׵ַ
+    size_type mask_;  //  - 1
+    size_type head_;  // һԪص߼±
+    size_type tail_;  // һԪصһλõ߼±
+
+public:
+    // 졢ơƶ
+
+    circular_buffer() {
+        init(CIRCULAR_BUFFER_INIT_SIZE);
+    }
+
+    // ע⣺ deque ͬ n ʾĻΪ
+    explicit circular_buffer(size_type n) {
+        init(n);
+    }
+
+    circular_buffer(size_type n, const value_type& value) {
+        init(n);
+        try {
+            MoperSTL::uninitialized_fill_n(buf_, n, value);
+        }
+        catch (...) {
+            data_allocator().deallocate(buf_, capacity());
+            buf_ = nullptr;
+            throw;
+        }
+        tail_ = n;
+    }
+
+    template <class IIter, typename std::enable_if<
+        std::is_convertible_v<
+        typename MoperSTL::iterator_traits<IIter>::iterator_category, MoperSTL::input_iterator_tag>
+        , int>::type = 0>
+    circular_buffer(IIter first, IIter last) {
+        init(CIRCULAR_BUFFER_INIT_SIZE);
+        copy_init(first, last);
+    }
+
+    circular_buffer(std::initializer_list<value_type> ilist) {
+        init(ilist.size());
+        copy_init(ilist.begin(), ilist.end());
+    }
+
+    circular_buffer(const circular_buffer& rhs) {
+        init(rhs.capacity());
+        copy_init(rhs.begin(), rhs.end());
+    }
+
+    circular_buffer(circular_buffer&& rhs) noexcept
+        :buf_(rhs.buf_), mask_(rhs.mask_), head_(rhs.head_), tail_(rhs.tail_) {
+        rhs.buf_ = nullptr;
+        rhs.mask_ = 0;
+        rhs.head_ = 0;
+        rhs.tail_ = 0;
+    }
+
+    circular_buffer& operator=(const circular_buffer& rhs) {
+        if (this != &rhs) {
+            circular_buffer tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    circular_buffer& operator=(circular_buffer&& rhs) noexcept {
+        if (this != &rhs) {
+            circular_buffer tmp(MoperSTL::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    circular_buffer& operator=(std::initializer_list<value_type> ilist) {
+        circular_buffer tmp(ilist);
+        swap(tmp);
+        return *this;
+    }
+
+    ~circular_buffer() {
+        if (buf_ != nullptr) {
+            clear();
+            data_allocator().deallocate(buf_, capacity());
+            buf_ = nullptr;
+        }
+    }
+
+public:
+    // ز
+
+    iterator               begin()         noexcept { return iterator(buf_, mask_, head_); }
+    const_iterator         begin()   const noexcept { return const_iterator(buf_, mask_, head_); }
+    iterator               end()           noexcept { return iterator(buf_, mask_, tail_); }
+    const_iterator         end()     const noexcept { return const_iterator(buf_, mask_, tail_); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // ز
+
+    bool      empty()    const noexcept { return head_ == tail_; }
+    bool      full()     const noexcept { return size() == capacity(); }
+    size_type size()     const noexcept { return tail_ - head_; }
+    size_type capacity() const noexcept { return buf_ == nullptr ? 0 : mask_ + 1; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / 2 / sizeof(T); }
+    size_type reserve_size() const noexcept { return capacity() - size(); }
+
+    void      reserve(size_type n);
+
+    // Ԫز
+
+    reference       operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return buf_[(head_ + n) & mask_];
+    }
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return buf_[(head_ + n) & mask_];
+    }
+
+    reference       at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "circular_buffer<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "circular_buffer<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference       front() {
+        MYSTL_DEBUG(!empty());
+        return buf_[head_ & mask_];
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return buf_[head_ & mask_];
+    }
+    reference       back() {
+        MYSTL_DEBUG(!empty());
+        return buf_[(tail_ - 1) & mask_];
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return buf_[(tail_ - 1) & mask_];
+    }
+
+    // дز
+    // Ԫذ߼˳λ array_one  array_two ڴУarray_two Ϊ
+    array_range       array_one()       noexcept;
+    const_array_range array_one() const noexcept;
+    array_range       array_two()       noexcept;
+    const_array_range array_two() const noexcept;
+
+    // ʹԪڴţarray_two ΪգԪصַ
+    pointer           linearize();
+
+    // ޸ز
+    // push / emplace ϵкдɹʱ true
+    // ʱcb_overwrite һ˵Ԫز truecb_reject ޸Ĳ false
+    // cb_throw ޸Ĳ׳ length_errorΪ 0ƶʱܸǴ
+
+    template <class ...Args>
+    bool emplace_back(Args&& ...args);
+    template <class ...Args>
+    bool emplace_front(Args&& ...args);
+
+    bool push_back(const value_type& value)  { return emplace_back(value); }
+    bool push_back(value_type&& value)       { return emplace_back(MoperSTL::move(value)); }
+    bool push_front(const value_type& value) { return emplace_front(value); }
+    bool push_front(value_type&& value)      { return emplace_front(MoperSTL::move(value)); }
+
+    // д [first, first + n)ʵдԪظ
+    size_type push_back_n(const value_type* first, size_type n);
+    //  n Ԫزƶ out УʵʵԪظ
+    size_type pop_front_n(value_type* out, size_type n);
+
+    void pop_front();
+    void pop_back();
+
+    void clear();
+
+    void swap(circular_buffer& rhs) noexcept;
+
+private:
+    // helper functions
+
+    void init(size_type n);
+    template <class IIter>
+    void copy_init(IIter first, IIter last);
+    template <class ...Args>
+    void overwrite_at(size_type pos, Args&& ...args);
+    bool reject_full() const;
+};
+
+/*****************************************************************************************/
+
+// Ԥ n ԪصĿռ䣬Ԫؽ
+template <class T, circular_buffer_policy Policy>
+void circular_buffer<T, Policy>::reserve(size_type n) {
+    if (n <= capacity())
+        return;
+    THROW_LENGTH_ERROR_IF(n > max_size(), "circular_buffer<T>'s size too big");
+    const size_type new_cap = MoperSTL::__cb_round_up_pow2(n);
+    pointer new_buf = data_allocator().allocate(new_cap);
+    const size_type len = size();
+    try {
+        MoperSTL::uninitialized_move(begin(), end(), new_buf);
+    }
+    catch (...) {
+        data_allocator().deallocate(new_buf, new_cap);
+        throw;
+    }
+    if (buf_ != nullptr) {
+        clear();
+        data_allocator().deallocate(buf_, capacity());
+    }
+    buf_ = new_buf;
+    mask_ = new_cap - 1;
+    head_ = 0;
+    tail_ = len;
+}
+
+template <class T, circular_buffer_policy Policy>
+typename circular_buffer<T, Policy>::array_range
+circular_buffer<T, Policy>::array_one() noexcept {
+    const size_type h = head_ & mask_;
+    const size_type n = size();
+    return array_range(buf_ + h, n < capacity() - h ? n : capacity() - h);
+}
+
+template <class T, circular_buffer_policy Policy>
+typename circular_buffer<T, Policy>::const_array_range
+circular_buffer<T, Policy>::array_one() const noexcept {
+    const size_type h = head_ & mask_;
+    const size_type n = size();
+    return const_array_range(buf_ + h, n < capacity() - h ? n : capacity() - h);
+}
+
+template <class T, circular_buffer_policy Policy>
+typename circular_buffer<T, Policy>::array_range
+circular_buffer<T, Policy>::array_two() noexcept {
+    const size_type h = head_ & mask_;
+    const size_type n = size();
+    return array_range(buf_, n > capacity() - h ? n - (capacity() - h) : 0);
+}
+
+template <class T, circular_buffer_policy Policy>
+typename circular_buffer<T, Policy>::const_array_range
+circular_buffer<T, Policy>::array_two() const noexcept {
+    const size_type h = head_ & mask_;
+    const size_type n = size();
+    return const_array_range(buf_, n > capacity() - h ? n - (capacity() - h) : 0);
+}
+
+template <class T, circular_buffer_policy Policy>
+typename circular_buffer<T, Policy>::pointer
+circular_buffer<T, Policy>::linearize() {
+    if (array_two().second != 0) {
+        // һ¿ռУ
+        const size_type cap = capacity();
+        const size_type len = size();
+        pointer new_buf = data_allocator().allocate(cap);
+        try {
+            MoperSTL::uninitialized_move(begin(), end(), new_buf);
+        }
+        catch (...) {
+            data_allocator().deallocate(new_buf, cap);
+            throw;
+        }
+        clear();
+        data_allocator().deallocate(buf_, cap);
+        buf_ = new_buf;
+        head_ = 0;
+        tail_ = len;
+    }
+    return buf_ + (head_ & mask_);
+}
+
+// β͵عԪ
+template <class T, circular_buffer_policy Policy>
+template <class ...Args>
+bool circular_buffer<T, Policy>::emplace_back(Args&& ...args) {
+    // ƶĻΪ 0ȲдҲûпɸǵԪ
+    if (capacity() == 0)
+        return reject_full();
+    if (full()) {
+        if (Policy != circular_buffer_policy::cb_overwrite)
+            return reject_full();
+        // βһλǡΪͷԪأֱӸǲ
+        overwrite_at(tail_, MoperSTL::forward<Args>(args)...);
+        ++head_;
+        ++tail_;
+        return true;
+    }
+    data_allocator().construct(buf_ + (tail_ & mask_), MoperSTL::forward<Args>(args)...);
+    ++tail_;
+    return true;
+}
+
+// ͷ͵عԪ
+template <class T, circular_buffer_policy Policy>
+template <class ...Args>
+bool circular_buffer<T, Policy>::emplace_front(Args&& ...args) {
+    if (capacity() == 0)
+        return reject_full();
+    if (full()) {
+        if (Policy != circular_buffer_policy::cb_overwrite)
+            return reject_full();
+        // ͷǰһλǡΪβԪأֱӸǲǰ
+        overwrite_at(head_ - 1, MoperSTL::forward<Args>(args)...);
+        --head_;
+        --tail_;
+        return true;
+    }
+    data_allocator().construct(buf_ + ((head_ - 1) & mask_), MoperSTL::forward<Args>(args)...);
+    --head_;
+    return true;
+}
+
+template <class T, circular_buffer_policy Policy>
+typename circular_buffer<T, Policy>::size_type
+circular_buffer<T, Policy>::push_back_n(const value_type* first, size_type n) {
+    if ((Policy != circular_buffer_policy::cb_overwrite || capacity() == 0) && n > reserve_size()) {
+        // cb_throw дκԪ֮ǰ׳
+        THROW_LENGTH_ERROR_IF(Policy == circular_buffer_policy::cb_throw,
+                              "circular_buffer<T> has not enough space");
+        n = reserve_size();
+    }
+    for (size_type i = 0; i < n; ++i)
+        emplace_back(first[i]);
+    return n;
+}
+
+template <class T, circular_buffer_policy Policy>
+typename circular_buffer<T, Policy>::size_type
+circular_buffer<T, Policy>::pop_front_n(value_type* out, size_type n) {
+    if (n > size())
+        n = size();
+    // δ
+    array_range one = array_one();
+    const size_type n1 = n < one.second ? n : one.second;
+    MoperSTL::move(one.first, one.first + n1, out);
+    MoperSTL::destory(one.first, one.first + n1);
+    if (n > n1) {
+        MoperSTL::move(buf_, buf_ + (n - n1), out + n1);
+        MoperSTL::destory(buf_, buf_ + (n - n1));
+    }
+    head_ += n;
+    return n;
+}
+
+template <class T, circular_buffer_policy Policy>
+void circular_buffer<T, Policy>::pop_front() {
+    MYSTL_DEBUG(!empty());
+    data_allocator().destroy(buf_ + (head_ & mask_));
+    ++head_;
+}
+
+template <class T, circular_buffer_policy Policy>
+void circular_buffer<T, Policy>::pop_back() {
+    MYSTL_DEBUG(!empty());
+    --tail_;
+    data_allocator().destroy(buf_ + (tail_ & mask_));
+}
+
+//  circular_buffer
+template <class T, circular_buffer_policy Policy>
+void circular_buffer<T, Policy>::clear() {
+    if (!std::is_trivially_destructible<T>::value) {
+        array_range one = array_one();
+        array_range two = array_two();
+        MoperSTL::destory(one.first, one.first + one.second);
+        MoperSTL::destory(two.first, two.first + two.second);
+    }
+    head_ = tail_ = 0;
+}
+
+template <class T, circular_buffer_policy Policy>
+void circular_buffer<T, Policy>::swap(circular_buffer& rhs) noexcept {
+    if (this != &rhs) {
+        MoperSTL::swap(buf_, rhs.buf_);
+        MoperSTL::swap(mask_, rhs.mask_);
+        MoperSTL::swap(head_, rhs.head_);
+        MoperSTL::swap(tail_, rhs.tail_);
+    }
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <class T, circular_buffer_policy Policy>
+void circular_buffer<T, Policy>::init(size_type n) {
+    THROW_LENGTH_ERROR_IF(n > max_size(), "circular_buffer<T>'s size too big");
+    const size_type cap = MoperSTL::__cb_round_up_pow2(n);
+    buf_ = data_allocator().allocate(cap);
+    mask_ = cap - 1;
+    head_ = tail_ = 0;
+}
+
+// Χʱ䣬֤ʧԪ
+template <class T, circular_buffer_policy Policy>
+template <class IIter>
+void circular_buffer<T, Policy>::copy_init(IIter first, IIter last) {
+    try {
+        for (; first != last; ++first) {
+            if (full())
+                reserve(capacity() << 1);
+            emplace_back(*first);
+        }
+    }
+    catch (...) {
+        clear();
+        data_allocator().deallocate(buf_, capacity());
+        buf_ = nullptr;
+        throw;
+    }
+}
+
+// ߼± pos ѴڵԪ
+template <class T, circular_buffer_policy Policy>
+template <class ...Args>
+void circular_buffer<T, Policy>::overwrite_at(size_type pos, Args&& ...args) {
+    buf_[pos & mask_] = value_type(MoperSTL::forward<Args>(args)...);
+}
+
+// ޷дʱĴcb_throw ׳ length_errorԷ false
+template <class T, circular_buffer_policy Policy>
+bool circular_buffer<T, Policy>::reject_full() const {
+    THROW_LENGTH_ERROR_IF(Policy == circular_buffer_policy::cb_throw, "circular_buffer<T> is full");
+    return false;
+}
+
+// رȽϲ
+template <class T, circular_buffer_policy Policy>
+bool operator==(const circular_buffer<T, Policy>& lhs, const circular_buffer<T, Policy>& rhs) {
+    return lhs.size() == rhs.size() &&
+        MoperSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, circular_buffer_policy Policy>
+bool operator<(const circular_buffer<T, Policy>& lhs, const circular_buffer<T, Policy>& rhs) {
+    return MoperSTL::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, circular_buffer_policy Policy>
+bool operator!=(const circular_buffer<T, Policy>& lhs, const circular_buffer<T, Policy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, circular_buffer_policy Policy>
+bool operator>(const circular_buffer<T, Policy>& lhs, const circular_buffer<T, Policy>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, circular_buffer_policy Policy>
+bool operator<=(const circular_buffer<T, Policy>& lhs, const circular_buffer<T, Policy>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, circular_buffer_policy Policy>
+bool operator>=(const circular_buffer<T, Policy>& lhs, const circular_buffer<T, Policy>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  mystl  swap
+template <class T, circular_buffer_policy Policy>
+void swap(circular_buffer<T, Policy>& lhs, circular_buffer<T, Policy>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_CIRCULAR_BUFFER_H */
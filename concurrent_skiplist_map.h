@@ -0,0 +1,770 @@
+#ifndef MOPER_STL_CONCURRENT_SKIPLIST_MAP_H
+#define MOPER_STL_CONCURRENT_SKIPLIST_MAP_H
+
+// ͷļģ concurrent_skiplist_mapһɱ߳ͬʱдӳ
+// ײΪFraser / Herlihy 㷨
+//   ֻȡָ룬Ҳдݣ CAS ӵ 0 㣬ӳɹɣϲ
+//   ɾȸڵ next ָɾǣ߼ɾǵ 0 ɹ̼߳Ϊɾߣ
+//   ֮ɾԼ;ýڵĲ CAS Ӹժ
+//   ժµĽڵ㽻ڼԪڴգepoch-based reclamationȷû߳Կܷʺͷ
+// ص 0 ǰɾĽڵ㣬һµģʧЧظʣ
+// ʼǰѴڼδɾԪһᱻʵڼɾԪؿܷʵҲܷʲ
+// ڵֱʹö operator new 䣺memory_pool ̰߳ȫڵ߳бͷ
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "utility.h"
+#include "exceptdef.h"
+
+namespace MoperSTL {
+
+/*****************************************************************************************/
+// ڼԪڴ
+// ̷߳ʹڵǰȽٽepoch_guardµʱȫּԪ
+// ݽṹժµĽڵ뱾̵߳ĴժʱȫּԪ e
+// ֻдٽ̶߳ѹ۲쵽Ԫ e ʱȫּԪƽƽ e + 2 ֮
+// ٽе̶߳ڽڵժ֮ģٳʱͷ
+
+// ҪӳͷŵĶĹͷ
+struct epoch_node {
+    epoch_node* epoch_next;                 // 
+    void      (*epoch_reclaim)(epoch_node*); // ͷź
+};
+
+// ÿ߳һݵļ¼߳˳̸֮߳ãͷ
+struct epoch_record {
+    std::atomic<std::size_t> state;          // (Ԫ << 1) | Ƿٽ
+    std::atomic<bool>        in_use;         // Ƿѱĳ߳ռ
+    epoch_record*            next;           // м¼ɵֻ
+
+    // ֻռøü¼̷߳
+    std::size_t              nest;           // ٽǶײ
+    epoch_node*              retired[3];     // Ԫģ 3 Ĵ
+    std::size_t              retired_epoch[3];
+    std::size_t              retired_count;
+};
+
+class epoch_domain {
+public:
+    // յĽڵﵽĿʱƽԪ
+    static constexpr std::size_t collect_threshold = 64;
+
+private:
+    std::atomic<std::size_t>   epoch_;
+    std::atomic<epoch_record*> records_;
+
+    constexpr epoch_domain() noexcept :epoch_(0), records_(nullptr) {}
+
+public:
+    static epoch_domain& instance() noexcept {
+        static epoch_domain domain;
+        return domain;
+    }
+
+    // ǰ̵߳ļ¼
+    static epoch_record* local() {
+        struct holder {
+            epoch_record* rec = nullptr;
+            ~holder() {
+                if (rec != nullptr) {  // ߳˳ǰգʣøü¼߳
+                    instance().collect(rec);
+                    rec->in_use.store(false, std::memory_order_release);
+                }
+            }
+        };
+        static thread_local holder h;
+        if (h.rec == nullptr)
+            h.rec = instance().acquire_record();
+        return h.rec;
+    }
+
+    void enter(epoch_record* rec) noexcept {
+        if (rec->nest++ == 0) {
+            std::size_t e = epoch_.load(std::memory_order_seq_cst);
+            while (true) {
+                // ֮ԹڵĶȡд뱻߳̿
+                rec->state.exchange((e << 1) | 1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                // дǰȫּԪѾƽʱµļԪɣ¼¼
+                const std::size_t now = epoch_.load(std::memory_order_seq_cst);
+                if (now == e)
+                    break;
+                e = now;
+            }
+        }
+    }
+
+    void leave(epoch_record* rec) noexcept {
+        if (--rec->nest == 0)
+            rec->state.store(rec->state.load(std::memory_order_relaxed) & ~std::size_t(1),
+                             std::memory_order_release);
+    }
+
+    // ڵѴݽṹժ£߱봦ٽ
+    void retire(epoch_record* rec, epoch_node* p) noexcept {
+        // Զ--дȡԪʹƽԪ֮߳¼Ԫ̶߳ܿǰժ
+        const std::size_t e = epoch_.fetch_add(0, std::memory_order_acq_rel);
+        const std::size_t i = e % 3;
+        if (rec->retired[i] != nullptr && rec->retired_epoch[i] != e)  //  3 Ԫͷ
+            reclaim(rec, i);
+        p->epoch_next = rec->retired[i];
+        rec->retired[i] = p;
+        rec->retired_epoch[i] = e;
+        if (++rec->retired_count >= collect_threshold)
+            collect(rec);
+    }
+
+private:
+    epoch_record* acquire_record() {
+        for (epoch_record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed) &&
+                r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return r;
+        }
+        epoch_record* r = new epoch_record();
+        r->state.store(0, std::memory_order_relaxed);
+        r->in_use.store(true, std::memory_order_relaxed);
+        r->nest = 0;
+        for (int i = 0; i < 3; ++i) {
+            r->retired[i] = nullptr;
+            r->retired_epoch[i] = 0;
+        }
+        r->retired_count = 0;
+        r->next = records_.load(std::memory_order_relaxed);
+        while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release,
+                                               std::memory_order_relaxed)) {}
+        return r;
+    }
+
+    // дٽ̶߳ѹ۲쵽ǰԪʱȫּԪһ
+    void try_advance() noexcept {
+        std::size_t e = epoch_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (epoch_record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            const std::size_t s = r->state.load(std::memory_order_acquire);
+            if ((s & 1) && (s >> 1) != e)
+                return;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        epoch_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+    }
+
+    void collect(epoch_record* rec) noexcept {
+        try_advance();
+        const std::size_t e = epoch_.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < 3; ++i) {
+            if (rec->retired[i] != nullptr && rec->retired_epoch[i] + 2 <= e)
+                reclaim(rec, i);
+        }
+    }
+
+    static void reclaim(epoch_record* rec, std::size_t i) noexcept {
+        epoch_node* p = rec->retired[i];
+        rec->retired[i] = nullptr;
+        while (p != nullptr) {
+            epoch_node* next = p->epoch_next;
+            p->epoch_reclaim(p);
+            --rec->retired_count;
+            p = next;
+        }
+    }
+};
+
+// ٽڼ䣬ǰ̶߳Ľڵ㲻ᱻͷ
+// ԸƣǶ׽룩ֻڴ߳ʹú
+class epoch_guard {
+private:
+    epoch_record* rec_;  // Ϊձʾٽ
+
+public:
+    epoch_guard() noexcept :rec_(nullptr) {}
+
+    static epoch_guard pin() {
+        epoch_guard g;
+        g.rec_ = epoch_domain::local();
+        epoch_domain::instance().enter(g.rec_);
+        return g;
+    }
+
+    epoch_guard(const epoch_guard& rhs) noexcept :rec_(rhs.rec_) {
+        if (rec_ != nullptr)
+            epoch_domain::instance().enter(rec_);
+    }
+    epoch_guard(epoch_guard&& rhs) noexcept :rec_(rhs.rec_) {
+        rhs.rec_ = nullptr;
+    }
+
+    epoch_guard& operator=(epoch_guard rhs) noexcept {
+        MoperSTL::swap(rec_, rhs.rec_);
+        return *this;
+    }
+
+    ~epoch_guard() {
+        if (rec_ != nullptr)
+            epoch_domain::instance().leave(rec_);
+    }
+
+    // ӳͷժµĽڵ㣬ǿ
+    void retire(epoch_node* p) const noexcept {
+        epoch_domain::instance().retire(rec_, p);
+    }
+};
+
+/*****************************************************************************************/
+// ڵ
+// ڵ֮ height ԭӵ next ָ룬λΪ 1 ʾýڵѱ߼ɾ
+
+template <class T>
+struct skiplist_node :public epoch_node {
+    typedef std::atomic<std::uintptr_t> link_type;
+
+    std::atomic<int> owners;  // ɾߣɺһڴ
+    int              height;
+    T                value;
+
+    link_type* next() noexcept { return reinterpret_cast<link_type*>(this + 1); }
+
+    static bool           is_marked(std::uintptr_t p) noexcept { return (p & 1) != 0; }
+    static skiplist_node* get_ptr(std::uintptr_t p) noexcept {
+        return reinterpret_cast<skiplist_node*>(p & ~std::uintptr_t(1));
+    }
+    static std::uintptr_t make_link(skiplist_node* p, bool mark = false) noexcept {
+        return reinterpret_cast<std::uintptr_t>(p) | (mark ? 1 : 0);
+    }
+
+    bool deleted() noexcept { return is_marked(next()[0].load(std::memory_order_acquire)); }
+};
+
+// concurrent_skiplist_map ĵV Ϊ const value_type ʱΪ const_iterator
+// һ epoch_guardڼָڵ㲻ᱻͷţʹԪѱ߳ɾ
+// ˵ֻڴ߳ʹãҲ˳ڱ棬ƳнڵĻ
+template <class T, class V>
+struct skiplist_iterator {
+    typedef MoperSTL::forward_iterator_tag  iterator_category;
+    typedef T                               value_type;
+    typedef std::ptrdiff_t                  difference_type;
+    typedef V*                              pointer;
+    typedef V&                              reference;
+
+    typedef skiplist_node<T>                node_type;
+    typedef skiplist_iterator<T, V>         self;
+
+    node_type*  node;   // Ϊձʾ end()
+    epoch_guard guard;
+
+    skiplist_iterator() :node(nullptr), guard() {}
+    skiplist_iterator(node_type* x, const epoch_guard& g) :node(x), guard(x == nullptr ? epoch_guard() : g) {}
+
+    //  iterator תΪ const_iterator
+    template <class U, typename std::enable_if<
+        std::is_same<const U, V>::value && !std::is_same<U, V>::value, int>::type = 0>
+    skiplist_iterator(const skiplist_iterator<T, U>& rhs) :node(rhs.node), guard(rhs.guard) {}
+
+    reference operator*()  const { return node->value; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        node = skip_deleted(node_type::get_ptr(node->next()[0].load(std::memory_order_acquire)));
+        if (node == nullptr)
+            guard = epoch_guard();
+        return *this;
+    }
+    self operator++(int) {
+        self tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node == rhs.node; }
+    bool operator!=(const self& rhs) const { return node != rhs.node; }
+
+    static node_type* skip_deleted(node_type* x) noexcept {
+        while (x != nullptr) {
+            const std::uintptr_t next = x->next()[0].load(std::memory_order_acquire);
+            if (!node_type::is_marked(next))
+                break;
+            x = node_type::get_ptr(next);
+        }
+        return x;
+    }
+};
+
+// ģ concurrent_skiplist_mapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::less
+// гԱ졢⣩Ա߳ͬʱ
+// Ԫزֵٸı䣻ͨ޸ʵֵҪɵͬʹԭ͵ʵֵ
+// Ԫʱܱ߳ɾṩ operator[]  atʹ find / insert / try_emplace صĵ
+template <class Key, class T, class Compare = MoperSTL::less<Key>>
+class concurrent_skiplist_map {
+public:
+  // concurrent_skiplist_map Ƕͱ
+    typedef Key                                         key_type;
+    typedef T                                           mapped_type;
+    typedef MoperSTL::pair<const Key, T>                value_type;
+    typedef Compare                                     key_compare;
+
+    typedef MoperSTL::allocator<value_type>             data_allocator;
+    typedef skiplist_node<value_type>                   node_type;
+
+    typedef value_type*                                 pointer;
+    typedef const value_type*                           const_pointer;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef skiplist_iterator<value_type, value_type>       iterator;
+    typedef skiplist_iterator<value_type, const value_type> const_iterator;
+    typedef std::size_t                                 size_type;
+    typedef std::ptrdiff_t                              difference_type;
+
+    // ÿһĸΪ 1/4֧ 4^16 Ԫ
+    static constexpr int max_height = 16;
+
+private:
+    typedef node_type*                        node_ptr;
+    typedef typename node_type::link_type     link_type;
+
+    node_ptr                 head_;    // ڱڵ㣬ӵ max_height 㣬Ԫ
+    std::atomic<int>         height_;  // ǰõֻ߲Ҵһ㿪ʼ
+    std::atomic<size_type>   size_;    // ֻǽֵ
+    key_compare              comp_;
+
+public:
+  // 졢ͬʱ
+
+    concurrent_skiplist_map() :concurrent_skiplist_map(key_compare()) {}
+
+    explicit concurrent_skiplist_map(const key_compare& comp)
+        :head_(allocate_node(max_height)), height_(1), size_(0), comp_(comp) {
+        for (int i = 0; i < max_height; ++i)
+            ::new (static_cast<void*>(head_->next() + i)) link_type(0);
+    }
+
+    template <class InputIterator>
+    concurrent_skiplist_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        :concurrent_skiplist_map(comp) {
+        insert(first, last);
+    }
+    concurrent_skiplist_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        :concurrent_skiplist_map(comp) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    concurrent_skiplist_map(const concurrent_skiplist_map&) = delete;
+    concurrent_skiplist_map& operator=(const concurrent_skiplist_map&) = delete;
+
+    ~concurrent_skiplist_map();
+
+public:
+  // ؽӿ
+
+    key_compare key_comp() const { return comp_; }
+
+    // أһµ
+
+    iterator       begin() {
+        epoch_guard g = epoch_guard::pin();
+        return iterator(first_node(), g);
+    }
+    const_iterator begin()  const {
+        epoch_guard g = epoch_guard::pin();
+        return const_iterator(first_node(), g);
+    }
+    iterator       end()          noexcept { return iterator(); }
+    const_iterator end()    const noexcept { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+
+    // أsize ڲֻǽֵ
+
+    bool      empty()    const {
+        epoch_guard g = epoch_guard::pin();
+        return first_node() == nullptr;
+    }
+    size_type size()     const noexcept { return size_.load(std::memory_order_relaxed); }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(node_type); }
+
+    // أlock-freeֵѴʱ룬ָԪصĵ false
+
+    template <class ...Args>
+    MoperSTL::pair<iterator, bool> emplace(Args&& ...args) {
+        epoch_guard g = epoch_guard::pin();
+        node_ptr x = create_node(random_height(), MoperSTL::forward<Args>(args)...);
+        return insert_node(x, g);
+    }
+
+    // ֵѴʱԪأʵֵ args 
+    template <class ...Args>
+    MoperSTL::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args) {
+        epoch_guard g = epoch_guard::pin();
+        if (node_ptr y = find_node(key))
+            return MoperSTL::pair<iterator, bool>(iterator(y, g), false);
+        node_ptr x = create_node(random_height(), key, mapped_type(MoperSTL::forward<Args>(args)...));
+        return insert_node(x, g);
+    }
+
+    MoperSTL::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+    MoperSTL::pair<iterator, bool> insert(value_type&& value)      { return emplace(MoperSTL::move(value)); }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            emplace(*first);
+    }
+
+    // ɾأlock-freeɾԪظ0  1ɾͬһֵʱֻһ̳߳ɹ
+
+    size_type erase(const key_type& key);
+
+    // ɾ position ָĽڵ㣨δɾһԪ
+    // ڵǼֵɾԪѱ߳ɾͬһֱֵ²ʱɾ²Ԫ
+    iterator  erase(const_iterator position) {
+        iterator next(position.node, position.guard);
+        ++next;
+        erase_node(position.node, position.guard);
+        return next;
+    }
+
+    // ɾԪأ̵߳ĲͬʱʱһΪ
+    // ÿɾһԪ˳һٽⳤʱֹԪƽ
+    void      clear() {
+        while (true) {
+            epoch_guard g = epoch_guard::pin();
+            node_ptr x = first_node();
+            if (x == nullptr)
+                break;
+            erase_node(x, g);
+        }
+    }
+
+    // أֻȡָ룬wait-freeдͬʱʱΪ lock-free
+
+    iterator       find(const key_type& key) {
+        epoch_guard g = epoch_guard::pin();
+        return iterator(find_node(key), g);
+    }
+    const_iterator find(const key_type& key) const {
+        epoch_guard g = epoch_guard::pin();
+        return const_iterator(find_node(key), g);
+    }
+
+    size_type      count(const key_type& key)    const { return contains(key) ? 1 : 0; }
+    bool           contains(const key_type& key) const {
+        epoch_guard g = epoch_guard::pin();
+        return find_node(key) != nullptr;
+    }
+
+    iterator       lower_bound(const key_type& key) {
+        epoch_guard g = epoch_guard::pin();
+        return iterator(bound_node(key, false), g);
+    }
+    const_iterator lower_bound(const key_type& key) const {
+        epoch_guard g = epoch_guard::pin();
+        return const_iterator(bound_node(key, false), g);
+    }
+    iterator       upper_bound(const key_type& key) {
+        epoch_guard g = epoch_guard::pin();
+        return iterator(bound_node(key, true), g);
+    }
+    const_iterator upper_bound(const key_type& key) const {
+        epoch_guard g = epoch_guard::pin();
+        return const_iterator(bound_node(key, true), g);
+    }
+
+    MoperSTL::pair<iterator, iterator>
+    equal_range(const key_type& key) {
+        return MoperSTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+    MoperSTL::pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const {
+        return MoperSTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+private:
+    // helper functions
+
+    // ºҪѴٽ
+
+    node_ptr first_node() const noexcept {
+        return iterator::skip_deleted(node_type::get_ptr(head_->next()[0].load(std::memory_order_acquire)));
+    }
+
+    static int random_height() noexcept;
+
+    static node_ptr allocate_node(int height);
+    static void     deallocate_node(node_ptr x) noexcept;
+    template <class ...Args>
+    static node_ptr create_node(int height, Args&& ...args);
+    static void     destroy_node(node_ptr x) noexcept;
+    static void     reclaim_node(epoch_node* p) noexcept;
+    static void     release_node(node_ptr x, const epoch_guard& g) noexcept;
+
+    bool     equal_key(node_ptr x, const key_type& key) const {
+        return x != nullptr && !comp_(key, x->value.first);
+    }
+    node_ptr find_node(const key_type& key) const;
+    node_ptr bound_node(const key_type& key, bool upper) const;
+    bool     search(const key_type& key, node_ptr* preds, node_ptr* succs);
+    bool     erase_node(node_ptr x, const epoch_guard& g);
+    MoperSTL::pair<iterator, bool> insert_node(node_ptr x, const epoch_guard& g);
+};
+
+/*****************************************************************************************/
+
+// ʱû̷߳ʣڵ 0 Ľڵ㶼δڴ
+template <class Key, class T, class Compare>
+concurrent_skiplist_map<Key, T, Compare>::
+~concurrent_skiplist_map() {
+    node_ptr x = node_type::get_ptr(head_->next()[0].load(std::memory_order_acquire));
+    while (x != nullptr) {
+        node_ptr next = node_type::get_ptr(x->next()[0].load(std::memory_order_relaxed));
+        destroy_node(x);
+        x = next;
+    }
+    deallocate_node(head_);
+}
+
+// ɾֵΪ key Ԫ
+template <class Key, class T, class Compare>
+typename concurrent_skiplist_map<Key, T, Compare>::size_type
+concurrent_skiplist_map<Key, T, Compare>::
+erase(const key_type& key) {
+    epoch_guard g = epoch_guard::pin();
+    node_ptr preds[max_height], succs[max_height];
+    if (!search(key, preds, succs))
+        return 0;
+    return erase_node(succs[0], g) ? 1 : 0;
+}
+
+// ɾڵ xǷɱ߳ɾx ѱ߳ɾʱκ
+// g  x ȡʱѳУ֤ x δ
+template <class Key, class T, class Compare>
+bool concurrent_skiplist_map<Key, T, Compare>::
+erase_node(node_ptr x, const epoch_guard& g) {
+    // ϶±Ǹ next ָ룬ֹнڵ x ֮
+    for (int i = x->height - 1; i > 0; --i) {
+        std::uintptr_t next = x->next()[i].load(std::memory_order_acquire);
+        while (!node_type::is_marked(next) &&
+               !x->next()[i].compare_exchange_weak(next, next | 1, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {}
+    }
+    // ǵ 0 ɹ߳Ϊɾ
+    std::uintptr_t next = x->next()[0].load(std::memory_order_acquire);
+    while (true) {
+        if (node_type::is_marked(next))
+            return false;  // ѱ߳ɾ
+        if (x->next()[0].compare_exchange_weak(next, next | 1, std::memory_order_acq_rel,
+                                               std::memory_order_acquire))
+            break;
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    node_ptr preds[max_height], succs[max_height];
+    search(x->value.first, preds, succs);  //  x Ӹժ
+    release_node(x, g);
+    return true;
+}
+
+// ѹõĽڵֵѴʱٸýڵ
+template <class Key, class T, class Compare>
+MoperSTL::pair<typename concurrent_skiplist_map<Key, T, Compare>::iterator, bool>
+concurrent_skiplist_map<Key, T, Compare>::
+insert_node(node_ptr x, const epoch_guard& g) {
+    const key_type& key = x->value.first;
+    node_ptr preds[max_height], succs[max_height];
+    const int h = x->height;
+    while (true) {
+        if (search(key, preds, succs)) {
+            destroy_node(x);
+            return MoperSTL::pair<iterator, bool>(iterator(succs[0], g), false);
+        }
+        for (int i = 0; i < h; ++i)
+            x->next()[i].store(node_type::make_link(succs[i]), std::memory_order_relaxed);
+        std::uintptr_t expected = node_type::make_link(succs[0]);
+        if (preds[0]->next()[0].compare_exchange_strong(expected, node_type::make_link(x),
+                                                        std::memory_order_acq_rel,
+                                                        std::memory_order_relaxed))
+            break;
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    // ԪѾɼϲx ڴڼ䱻ɾʱֹͣ
+    int top = height_.load(std::memory_order_relaxed);
+    while (top < h && !height_.compare_exchange_weak(top, h, std::memory_order_relaxed)) {}
+    for (int i = 1; i < h; ++i) {
+        while (true) {
+            std::uintptr_t next = x->next()[i].load(std::memory_order_acquire);
+            if (node_type::is_marked(next))
+                goto done;
+            if (node_type::get_ptr(next) != succs[i] &&
+                !x->next()[i].compare_exchange_strong(next, node_type::make_link(succs[i]),
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire))
+                continue;  // ǻ޸ģ¼
+            std::uintptr_t expected = node_type::make_link(succs[i]);
+            if (preds[i]->next()[i].compare_exchange_strong(expected, node_type::make_link(x),
+                                                            std::memory_order_acq_rel,
+                                                            std::memory_order_relaxed))
+                break;
+            search(key, preds, succs);
+            if (succs[0] != x)  // x ѱɾӵ 0 ժ
+                goto done;
+        }
+    }
+done:
+    // ϲӿܷɾժ x ֮ٲһժЩ
+    if (x->deleted())
+        search(key, preds, succs);
+    release_node(x, g);
+    return MoperSTL::pair<iterator, bool>(iterator(x, g), true);
+}
+
+//  key ڸǰ preds  succs; CAS ժѱ߼ɾĽڵ
+// ص 0 ĺǷǼֵΪ key Ľڵ
+template <class Key, class T, class Compare>
+bool concurrent_skiplist_map<Key, T, Compare>::
+search(const key_type& key, node_ptr* preds, node_ptr* succs) {
+retry:
+    node_ptr pred = head_;
+    for (int i = max_height - 1; i >= 0; --i) {
+        node_ptr curr = node_type::get_ptr(pred->next()[i].load(std::memory_order_acquire));
+        while (curr != nullptr) {
+            std::uintptr_t next = curr->next()[i].load(std::memory_order_acquire);
+            if (node_type::is_marked(next)) {  // curr ѱɾӵ i ժ
+                std::uintptr_t expected = node_type::make_link(curr);
+                if (!pred->next()[i].compare_exchange_strong(expected, next & ~std::uintptr_t(1),
+                                                             std::memory_order_acq_rel,
+                                                             std::memory_order_relaxed))
+                    goto retry;  // pred ѱɾ޸
+                curr = node_type::get_ptr(next);
+                continue;
+            }
+            if (!comp_(curr->value.first, key))
+                break;
+            pred = curr;
+            curr = node_type::get_ptr(next);
+        }
+        preds[i] = pred;
+        succs[i] = curr;
+    }
+    return equal_key(succs[0], key);
+}
+
+// ֻزҼֵΪ key δɾĽڵ㣬ɾĽڵժ
+template <class Key, class T, class Compare>
+typename concurrent_skiplist_map<Key, T, Compare>::node_ptr
+concurrent_skiplist_map<Key, T, Compare>::
+find_node(const key_type& key) const {
+    node_ptr x = bound_node(key, false);
+    return equal_key(x, key) ? x : nullptr;
+}
+
+// һδɾҲСڣupper Ϊ true ʱڣkey Ľڵ
+template <class Key, class T, class Compare>
+typename concurrent_skiplist_map<Key, T, Compare>::node_ptr
+concurrent_skiplist_map<Key, T, Compare>::
+bound_node(const key_type& key, bool upper) const {
+    node_ptr pred = head_;
+    node_ptr curr = nullptr;
+    for (int i = height_.load(std::memory_order_relaxed) - 1; i >= 0; --i) {
+        curr = node_type::get_ptr(pred->next()[i].load(std::memory_order_acquire));
+        while (curr != nullptr) {
+            const std::uintptr_t next = curr->next()[i].load(std::memory_order_acquire);
+            if (node_type::is_marked(next)) {
+                curr = node_type::get_ptr(next);
+                continue;
+            }
+            if (upper ? comp_(key, curr->value.first) : !comp_(curr->value.first, key))
+                break;
+            pred = curr;
+            curr = node_type::get_ptr(next);
+        }
+    }
+    //  0  curr δǣڶȡɾȷһ
+    return iterator::skip_deleted(curr);
+}
+
+// ÿһĸΪ 1/4
+template <class Key, class T, class Compare>
+int concurrent_skiplist_map<Key, T, Compare>::
+random_height() noexcept {
+    static thread_local std::uint32_t seed = 0;
+    if (seed == 0)
+        seed = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&seed) >> 4) | 1;
+    seed ^= seed << 13;  // xorshift32
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    std::uint32_t bits = seed;
+    int h = 1;
+    while (h < max_height && (bits & 3) == 0) {
+        ++h;
+        bits >>= 2;
+    }
+    return h;
+}
+
+//  height  next ָĽڵ㣬Ԫ
+template <class Key, class T, class Compare>
+typename concurrent_skiplist_map<Key, T, Compare>::node_ptr
+concurrent_skiplist_map<Key, T, Compare>::
+allocate_node(int height) {
+    const std::size_t bytes = sizeof(node_type) + height * sizeof(link_type);
+    node_ptr x = static_cast<node_ptr>(::operator new(bytes, std::align_val_t(alignof(node_type))));
+    x->height = height;
+    return x;
+}
+
+template <class Key, class T, class Compare>
+void concurrent_skiplist_map<Key, T, Compare>::
+deallocate_node(node_ptr x) noexcept {
+    ::operator delete(static_cast<void*>(x), std::align_val_t(alignof(node_type)));
+}
+
+template <class Key, class T, class Compare>
+template <class ...Args>
+typename concurrent_skiplist_map<Key, T, Compare>::node_ptr
+concurrent_skiplist_map<Key, T, Compare>::
+create_node(int height, Args&& ...args) {
+    node_ptr x = allocate_node(height);
+    try {
+        data_allocator::construct(MoperSTL::addressof(x->value), MoperSTL::forward<Args>(args)...);
+    } catch (...) {
+        deallocate_node(x);
+        throw;
+    }
+    ::new (static_cast<void*>(MoperSTL::addressof(x->owners))) std::atomic<int>(2);
+    for (int i = 0; i < height; ++i)
+        ::new (static_cast<void*>(x->next() + i)) link_type(0);
+    x->epoch_reclaim = &reclaim_node;
+    return x;
+}
+
+template <class Key, class T, class Compare>
+void concurrent_skiplist_map<Key, T, Compare>::
+destroy_node(node_ptr x) noexcept {
+    data_allocator::destroy(MoperSTL::addressof(x->value));
+    deallocate_node(x);
+}
+
+template <class Key, class T, class Compare>
+void concurrent_skiplist_map<Key, T, Compare>::
+reclaim_node(epoch_node* p) noexcept {
+    destroy_node(static_cast<node_ptr>(p));
+}
+
+// ϲ㡢ɾժ½ڵһΣ߰ѽڵ㽻ڴ
+template <class Key, class T, class Compare>
+void concurrent_skiplist_map<Key, T, Compare>::
+release_node(node_ptr x, const epoch_guard& g) noexcept {
+    if (x->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        g.retire(x);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_CONCURRENT_SKIPLIST_MAP_H */
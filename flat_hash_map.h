@@ -0,0 +1,293 @@
+#ifndef MOPER_STL_FLAT_HASH_MAP_H
+#define MOPER_STL_FLAT_HASH_MAP_H
+
+// ͷļģ flat_hash_map
+// flat_hash_map Ľӿ unordered_map ͬײΪѰַ flat_hash_tableԪֱӴĲλ
+//  unordered_map 
+//   ؽƶԪأʹеָʧЧbucket λû local iterator  bucket_size
+//   ԪزڽڵУûнڵextract  merge
+
+#include "__flat_hash_table.h"
+
+namespace MoperSTL {
+
+// ģ flat_hash_mapֵظ
+// һֵͣʵֵͣϣȱʡʹ MoperSTL::hash
+// ĴֵȽϷʽȱʡʹ MoperSTL::equal_to
+template <class Key, class T, class Hash = MoperSTL::hash<Key>, class KeyEqual = MoperSTL::equal_to<Key>>
+class flat_hash_map {
+private:
+  // ʹ flat_hash_table Ϊײ
+    typedef flat_hash_table<MoperSTL::pair<const Key, T>, Hash, KeyEqual> base_type;
+    base_type ht_;
+
+public:
+  // ʹ flat_hash_table ͱ
+
+    typedef typename base_type::allocator_type       allocator_type;
+    typedef typename base_type::key_type             key_type;
+    typedef typename base_type::mapped_type          mapped_type;
+    typedef typename base_type::value_type           value_type;
+    typedef typename base_type::hasher               hasher;
+    typedef typename base_type::key_equal            key_equal;
+
+    typedef typename base_type::size_type            size_type;
+    typedef typename base_type::difference_type      difference_type;
+    typedef typename base_type::pointer              pointer;
+    typedef typename base_type::const_pointer        const_pointer;
+    typedef typename base_type::reference            reference;
+    typedef typename base_type::const_reference      const_reference;
+
+    typedef typename base_type::iterator             iterator;
+    typedef typename base_type::const_iterator       const_iterator;
+
+    allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+  // 졢ơƶȱʡ첻ռ
+
+    flat_hash_map()
+        :ht_(0, Hash(), KeyEqual()) {}
+
+    explicit flat_hash_map(size_type bucket_count,
+                           const Hash& hash = Hash(),
+                           const KeyEqual& equal = KeyEqual())
+        :ht_(bucket_count, hash, equal) {}
+
+    template <class InputIterator>
+    flat_hash_map(InputIterator first, InputIterator last,
+                  const size_type bucket_count = 0,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual())
+        :ht_(bucket_count, hash, equal) {
+        ht_.reserve(static_cast<size_type>(MoperSTL::distance(first, last)));
+        ht_.insert_unique(first, last);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> ilist,
+                  const size_type bucket_count = 0,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual())
+        :ht_(bucket_count, hash, equal) {
+        ht_.reserve(ilist.size());
+        ht_.insert_unique(ilist.begin(), ilist.end());
+    }
+
+    flat_hash_map(const flat_hash_map& rhs)
+        :ht_(rhs.ht_) {}
+    flat_hash_map(flat_hash_map&& rhs) noexcept
+        :ht_(MoperSTL::move(rhs.ht_)) {}
+
+    flat_hash_map& operator=(const flat_hash_map& rhs) {
+        ht_ = rhs.ht_;
+        return *this;
+    }
+    flat_hash_map& operator=(flat_hash_map&& rhs) noexcept {
+        ht_ = MoperSTL::move(rhs.ht_);
+        return *this;
+    }
+
+    flat_hash_map& operator=(std::initializer_list<value_type> ilist) {
+        ht_.clear();
+        ht_.reserve(ilist.size());
+        ht_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~flat_hash_map() = default;
+
+    // 
+
+    iterator       begin()        noexcept {
+        return ht_.begin();
+    }
+    const_iterator begin()  const noexcept {
+        return ht_.begin();
+    }
+    iterator       end()          noexcept {
+        return ht_.end();
+    }
+    const_iterator end()    const noexcept {
+        return ht_.end();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return ht_.cbegin();
+    }
+    const_iterator cend()   const noexcept {
+        return ht_.cend();
+    }
+
+// 
+
+    bool      empty()    const noexcept { return ht_.empty(); }
+    size_type size()     const noexcept { return ht_.size(); }
+    size_type max_size() const noexcept { return ht_.max_size(); }
+
+    // ޸
+
+    // empalce / empalce_hintѰַ hint û壬Ϊӿڼ
+
+    template <class ...Args>
+    pair<iterator, bool> emplace(Args&& ...args) {
+        return ht_.emplace_unique(MoperSTL::forward<Args>(args)...);
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator, Args&& ...args) {
+        return ht_.emplace_unique(MoperSTL::forward<Args>(args)...).first;
+    }
+
+// insert
+
+    pair<iterator, bool> insert(const value_type& value) {
+        return ht_.insert_unique(value);
+    }
+    pair<iterator, bool> insert(value_type&& value) {
+        return ht_.insert_unique(MoperSTL::move(value));
+    }
+
+    iterator insert(const_iterator, const value_type& value) {
+        return ht_.insert_unique(value).first;
+    }
+    iterator insert(const_iterator, value_type&& value) {
+        return ht_.insert_unique(MoperSTL::move(value)).first;
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        ht_.insert_unique(first, last);
+    }
+
+// erase / clear
+
+    void      erase(const_iterator it) {
+        ht_.erase(it);
+    }
+    void      erase(const_iterator first, const_iterator last) {
+        ht_.erase(first, last);
+    }
+
+    size_type erase(const key_type& key) {
+        return ht_.erase_unique(key);
+    }
+
+    // Ԫأλ
+    void      clear() {
+        ht_.clear();
+    }
+
+    void      swap(flat_hash_map& other) noexcept {
+        ht_.swap(other.ht_);
+    }
+
+// 
+
+    mapped_type& at(const key_type& key) {
+        iterator it = ht_.find(key);
+        THROW_OUT_OF_RANGE_IF(it == ht_.end(), "flat_hash_map<Key, T> no such element exists");
+        return it->second;
+    }
+    const mapped_type& at(const key_type& key) const {
+        const_iterator it = ht_.find(key);
+        THROW_OUT_OF_RANGE_IF(it == ht_.end(), "flat_hash_map<Key, T> no such element exists");
+        return it->second;
+    }
+
+    // ֻһΣֵʱŹԪأʵֵҲֻڲʱֵʼ
+    mapped_type& operator[](const key_type& key) {
+        return ht_.emplace_key_default(key, key).first->second;
+    }
+    mapped_type& operator[](key_type&& key) {
+        return ht_.emplace_key_default(key, MoperSTL::move(key)).first->second;
+    }
+
+    size_type      count(const key_type& key) const {
+        return ht_.count(key);
+    }
+
+    iterator       find(const key_type& key) {
+        return ht_.find(key);
+    }
+    const_iterator find(const key_type& key)  const {
+        return ht_.find(key);
+    }
+
+    pair<iterator, iterator> equal_range(const key_type& key) {
+        return ht_.equal_range_unique(key);
+    }
+    pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return ht_.equal_range_unique(key);
+    }
+
+    // 칹ң hasher  key_equal  is_transparent ʱ
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    size_type      count(const K& key) const {
+        return ht_.count(key);
+    }
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    iterator       find(const K& key) {
+        return ht_.find(key);
+    }
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    const_iterator find(const K& key)  const {
+        return ht_.find(key);
+    }
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<iterator, iterator> equal_range(const K& key) {
+        return ht_.equal_range_unique(key);
+    }
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<const_iterator, const_iterator> equal_range(const K& key) const {
+        return ht_.equal_range_unique(key);
+    }
+
+// bucket interfacebucket λ
+
+    size_type bucket_count()                 const noexcept {
+        return ht_.bucket_count();
+    }
+    size_type max_bucket_count()             const noexcept {
+        return ht_.max_bucket_count();
+    }
+
+// hash policymax_load_factor ȱʡΪ 7/8Ҳܳ 7/8
+
+    float     load_factor()            const noexcept { return ht_.load_factor(); }
+
+    float     max_load_factor()        const noexcept { return ht_.max_load_factor(); }
+    void      max_load_factor(float ml) { ht_.max_load_factor(ml); }
+
+    void      rehash(size_type count) { ht_.rehash(count); }
+    void      reserve(size_type count) { ht_.reserve(count); }
+
+    hasher    hash_fcn()               const { return ht_.hash_fcn(); }
+    key_equal key_eq()                 const { return ht_.key_eq(); }
+
+public:
+    friend bool operator==(const flat_hash_map& lhs, const flat_hash_map& rhs) {
+        return lhs.ht_.equal_unique(rhs.ht_);
+    }
+    friend bool operator!=(const flat_hash_map& lhs, const flat_hash_map& rhs) {
+        return !lhs.ht_.equal_unique(rhs.ht_);
+    }
+};
+
+//  mystl  swap
+template <class Key, class T, class Hash, class KeyEqual>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual>& lhs,
+          flat_hash_map<Key, T, Hash, KeyEqual>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_FLAT_HASH_MAP_H */
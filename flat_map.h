@@ -0,0 +1,930 @@
+#ifndef MOPER_STL_FLAT_MAP_H
+#define MOPER_STL_FLAT_MAP_H
+
+// ͷļģ flat_map  flat_multimap
+// ֵʵֱֵ𰴼ֵ˳ MoperSTL::vector Уӿ map / multimap ͬ
+// ֻŵļֵ޷֧ĶֲңʵֵֵСʱʺܸ
+// ԪصĲɾΪ O(n)ԪأԭԪһαϲ
+// õõͬʱüֵʵֵĴ flat_map_reference pair 
+// ע⣺ɾʹеʧЧ
+
+#include <initializer_list>
+
+#include "__flat_tree.h"
+#include "exceptdef.h"
+
+namespace MoperSTL {
+
+// ģ flat_mapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::less
+template <class Key, class T, class Compare = MoperSTL::less<Key>>
+class flat_map {
+public:
+  // flat_map Ƕͱ
+    typedef Key                              key_type;
+    typedef T                                mapped_type;
+    typedef MoperSTL::pair<Key, T>           value_type;
+    typedef Compare                          key_compare;
+    typedef MoperSTL::vector<Key>            key_container_type;
+    typedef MoperSTL::vector<T>              mapped_container_type;
+
+    // һ functorԪرȽ
+    class value_compare : public binary_function <value_type, value_type, bool> {
+        friend class flat_map<Key, T, Compare>;
+    private:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+    public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);  // ȽϼֵĴС
+        }
+    };
+
+    typedef flat_map_iterator<Key, T>                   iterator;
+    typedef flat_map_iterator<Key, const T>             const_iterator;
+    typedef typename iterator::reference                reference;
+    typedef typename const_iterator::reference          const_reference;
+    typedef MoperSTL::reverse_iterator<iterator>        reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>  const_reverse_iterator;
+    typedef typename key_container_type::size_type       size_type;
+    typedef typename key_container_type::difference_type difference_type;
+
+private:
+    key_container_type    keys_;    // ֵϸŵļֵ
+    mapped_container_type values_;  //  keys_ һһӦʵֵ
+    key_compare           comp_;
+
+public:
+  // 졢ơƶֵ
+
+    flat_map() = default;
+
+    explicit flat_map(const key_compare& comp)
+        :keys_(), values_(), comp_(comp) {}
+
+    template <class InputIterator>
+    flat_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        :keys_(), values_(), comp_(comp) {
+        insert(first, last);
+    }
+    // Լֵϸ乹죬Ƚϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    flat_map(sorted_unique_t, InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare())
+        :keys_(), values_(), comp_(comp) {
+        merge_unique<false>(first, last,
+                            flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+    }
+    flat_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        :keys_(), values_(), comp_(comp) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // ӹֵܼϸ vector Ϊײ洢
+    flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values,
+             const key_compare& comp = key_compare())
+        :keys_(MoperSTL::move(keys)), values_(MoperSTL::move(values)), comp_(comp) {
+        MYSTL_DEBUG(keys_.size() == values_.size());
+    }
+
+    flat_map(const flat_map& rhs)
+        :keys_(rhs.keys_), values_(rhs.values_), comp_(rhs.comp_) {}
+    flat_map(flat_map&& rhs) noexcept
+        :keys_(MoperSTL::move(rhs.keys_)), values_(MoperSTL::move(rhs.values_)), comp_(rhs.comp_) {}
+
+    flat_map& operator=(const flat_map& rhs) {
+        keys_ = rhs.keys_;
+        values_ = rhs.values_;
+        comp_ = rhs.comp_;
+        return *this;
+    }
+    flat_map& operator=(flat_map&& rhs) {
+        keys_ = MoperSTL::move(rhs.keys_);
+        values_ = MoperSTL::move(rhs.values_);
+        comp_ = rhs.comp_;
+        return *this;
+    }
+    flat_map& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ؽӿ
+
+    key_compare                  key_comp()   const { return comp_; }
+    value_compare                value_comp() const { return value_compare(comp_); }
+
+    // ײļֵʵֵ vector
+    const key_container_type&    keys()       const noexcept { return keys_; }
+    const mapped_container_type& values()     const noexcept { return values_; }
+
+    // Լֵϸ vector 滻ײ洢
+    void replace(key_container_type&& keys, mapped_container_type&& values) {
+        MYSTL_DEBUG(keys.size() == values.size());
+        keys_ = MoperSTL::move(keys);
+        values_ = MoperSTL::move(values);
+    }
+
+    // 
+
+    iterator               begin()         noexcept { return make_iter(0); }
+    const_iterator         begin()   const noexcept { return make_iter(0); }
+    iterator               end()           noexcept { return make_iter(size()); }
+    const_iterator         end()     const noexcept { return make_iter(size()); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 
+    bool                   empty()    const noexcept { return keys_.empty(); }
+    size_type              size()     const noexcept { return keys_.size(); }
+    size_type              max_size() const noexcept { return keys_.max_size(); }
+    size_type              capacity() const noexcept { return keys_.capacity(); }
+
+    void reserve(size_type n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+    void shrink_to_fit() {
+        keys_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    // Ԫ
+
+    // ֵڣat ׳һ쳣
+    mapped_type& at(const key_type& key) {
+        const size_type i = find_index(key);
+        THROW_OUT_OF_RANGE_IF(i == size(), "flat_map<Key, T> no such element exists");
+        return values_[i];
+    }
+    const mapped_type& at(const key_type& key) const {
+        const size_type i = find_index(key);
+        THROW_OUT_OF_RANGE_IF(i == size(), "flat_map<Key, T> no such element exists");
+        return values_[i];
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        const size_type i = lower_bound_index(key);
+        if (i == size() || comp_(key, keys_[i]))
+            insert_at(i, key);
+        return values_[i];
+    }
+    mapped_type& operator[](key_type&& key) {
+        const size_type i = lower_bound_index(key);
+        if (i == size() || comp_(key, keys_[i]))
+            insert_at(i, MoperSTL::move(key));
+        return values_[i];
+    }
+
+    // ɾ
+
+    template <class ...Args>
+    pair<iterator, bool> emplace(Args&& ...args) {
+        value_type value(MoperSTL::forward<Args>(args)...);
+        return insert(MoperSTL::move(value));
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator hint, Args&& ...args) {
+        value_type value(MoperSTL::forward<Args>(args)...);
+        return insert(hint, MoperSTL::move(value));
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        return insert_value(value.first, value.second);
+    }
+    pair<iterator, bool> insert(value_type&& value) {
+        return insert_value(MoperSTL::move(value.first), MoperSTL::move(value.second));
+    }
+
+    iterator insert(const_iterator hint, const value_type& value) {
+        return insert_value_use_hint(hint, value.first, value.second);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        return insert_value_use_hint(hint, MoperSTL::move(value.first), MoperSTL::move(value.second));
+    }
+
+    // 룺Ԫȷʱ岢ȶԭԪһαϲʱ临Ӷ O(n + m log m)
+    // ֵظʱȳֵԪ
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        MoperSTL::vector<value_type> buf;
+        buf.reserve(flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+        for (; first != last; ++first)
+            buf.emplace_back(*first);
+        flat_stable_sort(buf.data(), buf.data() + buf.size(), value_comp());
+        merge_unique<true>(buf.begin(), buf.end(), buf.size());
+    }
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // ֵϸ䣺ԭԪһαϲʱ临Ӷ O(n + m)
+    template <class InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last) {
+        merge_unique<false>(first, last,
+                            flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+    }
+
+    iterator  erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+    iterator  erase(const_iterator first, const_iterator last) {
+        const size_type i = index_of(first), j = index_of(last);
+        keys_.erase(keys_.begin() + i, keys_.begin() + j);
+        values_.erase(values_.begin() + i, values_.begin() + j);
+        return make_iter(i);
+    }
+    size_type erase(const key_type& key) {
+        const size_type i = find_index(key);
+        if (i == size())
+            return 0;
+        keys_.erase(keys_.begin() + i);
+        values_.erase(values_.begin() + i);
+        return 1;
+    }
+
+    void      clear() {
+        keys_.clear();
+        values_.clear();
+    }
+
+    // flat_map ز
+
+    iterator       find(const key_type& key)              { return make_iter(find_index(key)); }
+    const_iterator find(const key_type& key)        const { return make_iter(find_index(key)); }
+
+    size_type      count(const key_type& key)       const { return find_index(key) != size() ? 1 : 0; }
+    bool           contains(const key_type& key)    const { return find_index(key) != size(); }
+
+    iterator       lower_bound(const key_type& key)       { return make_iter(lower_bound_index(key)); }
+    const_iterator lower_bound(const key_type& key) const { return make_iter(lower_bound_index(key)); }
+
+    iterator       upper_bound(const key_type& key)       { return make_iter(upper_bound_index(key)); }
+    const_iterator upper_bound(const key_type& key) const { return make_iter(upper_bound_index(key)); }
+
+    pair<iterator, iterator>
+        equal_range(const key_type& key) {
+        const size_type i = find_index(key);
+        return pair<iterator, iterator>(make_iter(i), make_iter(i == size() ? i : i + 1));
+    }
+    pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        const size_type i = find_index(key);
+        return pair<const_iterator, const_iterator>(make_iter(i), make_iter(i == size() ? i : i + 1));
+    }
+
+    // 칹ң key_compare  is_transparent ʱã less<void>
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       find(const K& key)       { return make_iter(find_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key) const { return make_iter(find_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count(const K& key) const { return upper_bound_index(key) - lower_bound_index(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    bool           contains(const K& key) const { return find_index(key) != size(); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       lower_bound(const K& key)       { return make_iter(lower_bound_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return make_iter(lower_bound_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       upper_bound(const K& key)       { return make_iter(upper_bound_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return make_iter(upper_bound_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<iterator, iterator>
+        equal_range(const K& key) {
+        return pair<iterator, iterator>(make_iter(lower_bound_index(key)), make_iter(upper_bound_index(key)));
+    }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<const_iterator, const_iterator>
+        equal_range(const K& key) const {
+        return pair<const_iterator, const_iterator>(make_iter(lower_bound_index(key)),
+                                                    make_iter(upper_bound_index(key)));
+    }
+
+    void           swap(flat_map& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        values_.swap(rhs.values_);
+        MoperSTL::swap(comp_, rhs.comp_);
+    }
+
+public:
+    friend bool operator==(const flat_map& lhs, const flat_map& rhs) {
+        return lhs.size() == rhs.size() &&
+            MoperSTL::equal(lhs.keys_.begin(), lhs.keys_.end(), rhs.keys_.begin()) &&
+            MoperSTL::equal(lhs.values_.begin(), lhs.values_.end(), rhs.values_.begin());
+    }
+    friend bool operator< (const flat_map& lhs, const flat_map& rhs) {
+        for (size_type i = 0; i < lhs.size() && i < rhs.size(); ++i) {
+            if (lhs.keys_[i] < rhs.keys_[i]) return true;
+            if (rhs.keys_[i] < lhs.keys_[i]) return false;
+            if (lhs.values_[i] < rhs.values_[i]) return true;
+            if (rhs.values_[i] < lhs.values_[i]) return false;
+        }
+        return lhs.size() < rhs.size();
+    }
+
+private:
+    iterator       make_iter(size_type i)       noexcept { return iterator(keys_.data() + i, values_.data() + i); }
+    const_iterator make_iter(size_type i) const noexcept { return const_iterator(keys_.data() + i, values_.data() + i); }
+    size_type      index_of(const_iterator it) const noexcept { return static_cast<size_type>(it.key - keys_.data()); }
+
+    // lookupֻڼֵϲ
+
+    template <class K>
+    size_type lower_bound_index(const K& key) const {
+        return static_cast<size_type>(flat_lower_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data());
+    }
+    template <class K>
+    size_type upper_bound_index(const K& key) const {
+        return static_cast<size_type>(flat_upper_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data());
+    }
+    template <class K>
+    size_type find_index(const K& key) const {
+        const size_type i = lower_bound_index(key);
+        return (i == size() || comp_(key, keys_[i])) ? size() : i;
+    }
+
+    // insert
+
+    // ± i ֵ args ʵֵʵֵʧʱֵĲ
+    template <class K, class ...Args>
+    void insert_at(size_type i, K&& key, Args&& ...args) {
+        keys_.emplace(keys_.begin() + i, MoperSTL::forward<K>(key));
+        try {
+            values_.emplace(values_.begin() + i, MoperSTL::forward<Args>(args)...);
+        } catch (...) {
+            keys_.erase(keys_.begin() + i);
+            throw;
+        }
+    }
+
+    template <class K, class V>
+    pair<iterator, bool> insert_value(K&& key, V&& value) {
+        const size_type i = lower_bound_index(key);
+        if (i != size() && !comp_(key, keys_[i]))
+            return pair<iterator, bool>(make_iter(i), false);
+        insert_at(i, MoperSTL::forward<K>(key), MoperSTL::forward<V>(value));
+        return pair<iterator, bool>(make_iter(i), true);
+    }
+
+    // hint ǡǲλãǰһֵС key  hint ļֵ keyʱʡȥ
+    template <class K, class V>
+    iterator insert_value_use_hint(const_iterator hint, K&& key, V&& value) {
+        const size_type i = index_of(hint);
+        if ((i == 0 || comp_(keys_[i - 1], key)) && (i == size() || comp_(key, keys_[i]))) {
+            insert_at(i, MoperSTL::forward<K>(key), MoperSTL::forward<V>(value));
+            return make_iter(i);
+        }
+        return insert_value(MoperSTL::forward<K>(key), MoperSTL::forward<V>(value)).first;
+    }
+
+    // ѼֵϸȶǵݼϲظļֵȳֵǸ
+    // ԪضԭԪʱֱ׷ĩβȡԪز¸ԵĲλãٺϲµ vector н
+    // ԭԪֻһƶƶ׳쳣ʱƣ;׳쳣ʱֲ
+    template <bool Move, class InputIterator>
+    void merge_unique(InputIterator first, InputIterator last, size_type n) {
+        if (first == last)
+            return;
+        if (empty() || comp_(keys_.back(), (*first).first)) {
+            reserve(size() + n);
+            for (; first != last; ++first) {
+                auto&& value = *first;
+                if (empty() || comp_(keys_.back(), value.first))
+                    append(flat_take<Move>(value.first), flat_take<Move>(value.second));
+            }
+            return;
+        }
+        key_container_type    new_keys;
+        mapped_container_type new_values;
+        MoperSTL::vector<size_type> pos;  //  k ԪزԭԪ keys_[pos[k]] ֮ǰ
+        new_keys.reserve(n);
+        new_values.reserve(n);
+        pos.reserve(n);
+        size_type i = 0;
+        const size_type old_size = size();
+        for (; first != last; ++first) {
+            auto&& value = *first;
+            while (i < old_size && comp_(keys_[i], value.first))
+                ++i;
+            if (i < old_size && !comp_(value.first, keys_[i]))
+                continue;  // ͬļֵ
+            if (!new_keys.empty() && pos.back() == i && !comp_(new_keys.back(), value.first))
+                continue;  // һԪظ
+            new_keys.emplace_back(flat_take<Move>(value.first));
+            new_values.emplace_back(flat_take<Move>(value.second));
+            pos.push_back(i);
+        }
+        merge_at(new_keys, new_values, pos);
+    }
+
+    // ĩβ׷һԪأֵʧʱ׷ӵļֵ
+    template <class K, class V>
+    void append(K&& key, V&& value) {
+        keys_.emplace_back(MoperSTL::forward<K>(key));
+        try {
+            values_.emplace_back(MoperSTL::forward<V>(value));
+        } catch (...) {
+            keys_.pop_back();
+            throw;
+        }
+    }
+
+    void merge_at(key_container_type& new_keys, mapped_container_type& new_values,
+                  const MoperSTL::vector<size_type>& pos) {
+        constexpr bool nothrow = std::is_nothrow_move_constructible<Key>::value &&
+                                 std::is_nothrow_move_constructible<T>::value;
+        key_container_type    keys = flat_merge_at<nothrow>(keys_, new_keys, pos);
+        mapped_container_type values = flat_merge_at<nothrow>(values_, new_values, pos);
+        keys_.swap(keys);
+        values_.swap(values);
+    }
+};
+
+// رȽϲ
+template <class Key, class T, class Compare>
+bool operator!=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare>
+bool operator<=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  MoperSTL  swap
+template <class Key, class T, class Compare>
+void swap(flat_map<Key, T, Compare>& lhs, flat_map<Key, T, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// ģ flat_multimapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::less
+template <class Key, class T, class Compare = MoperSTL::less<Key>>
+class flat_multimap {
+public:
+  // flat_multimap Ƕͱ
+    typedef Key                              key_type;
+    typedef T                                mapped_type;
+    typedef MoperSTL::pair<Key, T>           value_type;
+    typedef Compare                          key_compare;
+    typedef MoperSTL::vector<Key>            key_container_type;
+    typedef MoperSTL::vector<T>              mapped_container_type;
+
+    // һ functorԪرȽ
+    class value_compare : public binary_function <value_type, value_type, bool> {
+        friend class flat_multimap<Key, T, Compare>;
+    private:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+    public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);  // ȽϼֵĴС
+        }
+    };
+
+    typedef flat_map_iterator<Key, T>                   iterator;
+    typedef flat_map_iterator<Key, const T>             const_iterator;
+    typedef typename iterator::reference                reference;
+    typedef typename const_iterator::reference          const_reference;
+    typedef MoperSTL::reverse_iterator<iterator>        reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>  const_reverse_iterator;
+    typedef typename key_container_type::size_type       size_type;
+    typedef typename key_container_type::difference_type difference_type;
+
+private:
+    key_container_type    keys_;    // ֵǵݼŵļֵȵԪذ˳
+    mapped_container_type values_;  //  keys_ һһӦʵֵ
+    key_compare           comp_;
+
+public:
+  // 졢ơƶֵ
+
+    flat_multimap() = default;
+
+    explicit flat_multimap(const key_compare& comp)
+        :keys_(), values_(), comp_(comp) {}
+
+    template <class InputIterator>
+    flat_multimap(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        :keys_(), values_(), comp_(comp) {
+        insert(first, last);
+    }
+    // Լֵǵݼ乹죬Ƚϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    flat_multimap(sorted_equivalent_t, InputIterator first, InputIterator last,
+                  const key_compare& comp = key_compare())
+        :keys_(), values_(), comp_(comp) {
+        merge_equal<false>(first, last,
+                           flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+    }
+    flat_multimap(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        :keys_(), values_(), comp_(comp) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // ӹֵܼǵݼ vector Ϊײ洢
+    flat_multimap(sorted_equivalent_t, key_container_type keys, mapped_container_type values,
+                  const key_compare& comp = key_compare())
+        :keys_(MoperSTL::move(keys)), values_(MoperSTL::move(values)), comp_(comp) {
+        MYSTL_DEBUG(keys_.size() == values_.size());
+    }
+
+    flat_multimap(const flat_multimap& rhs)
+        :keys_(rhs.keys_), values_(rhs.values_), comp_(rhs.comp_) {}
+    flat_multimap(flat_multimap&& rhs) noexcept
+        :keys_(MoperSTL::move(rhs.keys_)), values_(MoperSTL::move(rhs.values_)), comp_(rhs.comp_) {}
+
+    flat_multimap& operator=(const flat_multimap& rhs) {
+        keys_ = rhs.keys_;
+        values_ = rhs.values_;
+        comp_ = rhs.comp_;
+        return *this;
+    }
+    flat_multimap& operator=(flat_multimap&& rhs) {
+        keys_ = MoperSTL::move(rhs.keys_);
+        values_ = MoperSTL::move(rhs.values_);
+        comp_ = rhs.comp_;
+        return *this;
+    }
+    flat_multimap& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ؽӿ
+
+    key_compare                  key_comp()   const { return comp_; }
+    value_compare                value_comp() const { return value_compare(comp_); }
+
+    // ײļֵʵֵ vector
+    const key_container_type&    keys()       const noexcept { return keys_; }
+    const mapped_container_type& values()     const noexcept { return values_; }
+
+    // Լֵǵݼ vector 滻ײ洢
+    void replace(key_container_type&& keys, mapped_container_type&& values) {
+        MYSTL_DEBUG(keys.size() == values.size());
+        keys_ = MoperSTL::move(keys);
+        values_ = MoperSTL::move(values);
+    }
+
+    // 
+
+    iterator               begin()         noexcept { return make_iter(0); }
+    const_iterator         begin()   const noexcept { return make_iter(0); }
+    iterator               end()           noexcept { return make_iter(size()); }
+    const_iterator         end()     const noexcept { return make_iter(size()); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 
+    bool                   empty()    const noexcept { return keys_.empty(); }
+    size_type              size()     const noexcept { return keys_.size(); }
+    size_type              max_size() const noexcept { return keys_.max_size(); }
+    size_type              capacity() const noexcept { return keys_.capacity(); }
+
+    void reserve(size_type n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+    void shrink_to_fit() {
+        keys_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    // ɾ
+
+    template <class ...Args>
+    iterator emplace(Args&& ...args) {
+        value_type value(MoperSTL::forward<Args>(args)...);
+        return insert(MoperSTL::move(value));
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator hint, Args&& ...args) {
+        value_type value(MoperSTL::forward<Args>(args)...);
+        return insert(hint, MoperSTL::move(value));
+    }
+
+    // ԪزԪصĩβ
+    iterator insert(const value_type& value) {
+        const size_type i = upper_bound_index(value.first);
+        insert_at(i, value.first, value.second);
+        return make_iter(i);
+    }
+    iterator insert(value_type&& value) {
+        const size_type i = upper_bound_index(value.first);
+        insert_at(i, MoperSTL::move(value.first), MoperSTL::move(value.second));
+        return make_iter(i);
+    }
+
+    iterator insert(const_iterator hint, const value_type& value) {
+        const size_type i = index_of(hint);
+        if (!hint_fits(i, value.first))
+            return insert(value);
+        insert_at(i, value.first, value.second);
+        return make_iter(i);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        const size_type i = index_of(hint);
+        if (!hint_fits(i, value.first))
+            return insert(MoperSTL::move(value));
+        insert_at(i, MoperSTL::move(value.first), MoperSTL::move(value.second));
+        return make_iter(i);
+    }
+
+    // 룺Ԫȷʱ岢ȶԭԪһαϲʱ临Ӷ O(n + m log m)
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        MoperSTL::vector<value_type> buf;
+        buf.reserve(flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+        for (; first != last; ++first)
+            buf.emplace_back(*first);
+        flat_stable_sort(buf.data(), buf.data() + buf.size(), value_comp());
+        merge_equal<true>(buf.begin(), buf.end(), buf.size());
+    }
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // ֵǵݼ䣺ԭԪһαϲʱ临Ӷ O(n + m)
+    template <class InputIterator>
+    void insert(sorted_equivalent_t, InputIterator first, InputIterator last) {
+        merge_equal<false>(first, last,
+                           flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+    }
+
+    iterator  erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+    iterator  erase(const_iterator first, const_iterator last) {
+        const size_type i = index_of(first), j = index_of(last);
+        keys_.erase(keys_.begin() + i, keys_.begin() + j);
+        values_.erase(values_.begin() + i, values_.begin() + j);
+        return make_iter(i);
+    }
+    size_type erase(const key_type& key) {
+        const size_type i = lower_bound_index(key), j = upper_bound_index(key);
+        keys_.erase(keys_.begin() + i, keys_.begin() + j);
+        values_.erase(values_.begin() + i, values_.begin() + j);
+        return j - i;
+    }
+
+    void      clear() {
+        keys_.clear();
+        values_.clear();
+    }
+
+    // flat_multimap ز
+
+    iterator       find(const key_type& key)              { return make_iter(find_index(key)); }
+    const_iterator find(const key_type& key)        const { return make_iter(find_index(key)); }
+
+    size_type      count(const key_type& key)       const { return upper_bound_index(key) - lower_bound_index(key); }
+    bool           contains(const key_type& key)    const { return find_index(key) != size(); }
+
+    iterator       lower_bound(const key_type& key)       { return make_iter(lower_bound_index(key)); }
+    const_iterator lower_bound(const key_type& key) const { return make_iter(lower_bound_index(key)); }
+
+    iterator       upper_bound(const key_type& key)       { return make_iter(upper_bound_index(key)); }
+    const_iterator upper_bound(const key_type& key) const { return make_iter(upper_bound_index(key)); }
+
+    pair<iterator, iterator>
+        equal_range(const key_type& key) {
+        return pair<iterator, iterator>(make_iter(lower_bound_index(key)), make_iter(upper_bound_index(key)));
+    }
+    pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        return pair<const_iterator, const_iterator>(make_iter(lower_bound_index(key)),
+                                                    make_iter(upper_bound_index(key)));
+    }
+
+    // 칹ң key_compare  is_transparent ʱã less<void>
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       find(const K& key)       { return make_iter(find_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key) const { return make_iter(find_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count(const K& key) const { return upper_bound_index(key) - lower_bound_index(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    bool           contains(const K& key) const { return find_index(key) != size(); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       lower_bound(const K& key)       { return make_iter(lower_bound_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return make_iter(lower_bound_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       upper_bound(const K& key)       { return make_iter(upper_bound_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return make_iter(upper_bound_index(key)); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<iterator, iterator>
+        equal_range(const K& key) {
+        return pair<iterator, iterator>(make_iter(lower_bound_index(key)), make_iter(upper_bound_index(key)));
+    }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<const_iterator, const_iterator>
+        equal_range(const K& key) const {
+        return pair<const_iterator, const_iterator>(make_iter(lower_bound_index(key)),
+                                                    make_iter(upper_bound_index(key)));
+    }
+
+    void           swap(flat_multimap& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        values_.swap(rhs.values_);
+        MoperSTL::swap(comp_, rhs.comp_);
+    }
+
+public:
+    friend bool operator==(const flat_multimap& lhs, const flat_multimap& rhs) {
+        return lhs.size() == rhs.size() &&
+            MoperSTL::equal(lhs.keys_.begin(), lhs.keys_.end(), rhs.keys_.begin()) &&
+            MoperSTL::equal(lhs.values_.begin(), lhs.values_.end(), rhs.values_.begin());
+    }
+    friend bool operator< (const flat_multimap& lhs, const flat_multimap& rhs) {
+        for (size_type i = 0; i < lhs.size() && i < rhs.size(); ++i) {
+            if (lhs.keys_[i] < rhs.keys_[i]) return true;
+            if (rhs.keys_[i] < lhs.keys_[i]) return false;
+            if (lhs.values_[i] < rhs.values_[i]) return true;
+            if (rhs.values_[i] < lhs.values_[i]) return false;
+        }
+        return lhs.size() < rhs.size();
+    }
+
+private:
+    iterator       make_iter(size_type i)       noexcept { return iterator(keys_.data() + i, values_.data() + i); }
+    const_iterator make_iter(size_type i) const noexcept { return const_iterator(keys_.data() + i, values_.data() + i); }
+    size_type      index_of(const_iterator it) const noexcept { return static_cast<size_type>(it.key - keys_.data()); }
+
+    // lookupֻڼֵϲ
+
+    template <class K>
+    size_type lower_bound_index(const K& key) const {
+        return static_cast<size_type>(flat_lower_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data());
+    }
+    template <class K>
+    size_type upper_bound_index(const K& key) const {
+        return static_cast<size_type>(flat_upper_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data());
+    }
+    template <class K>
+    size_type find_index(const K& key) const {
+        const size_type i = lower_bound_index(key);
+        return (i == size() || comp_(key, keys_[i])) ? size() : i;
+    }
+
+    // insert
+
+    // hint ǺϷĲλãǰһֵ key  hint ļֵС key
+    bool hint_fits(size_type i, const key_type& key) const {
+        return (i == 0 || !comp_(key, keys_[i - 1])) && (i == size() || !comp_(keys_[i], key));
+    }
+
+    // ± i ֵ args ʵֵʵֵʧʱֵĲ
+    template <class K, class ...Args>
+    void insert_at(size_type i, K&& key, Args&& ...args) {
+        keys_.emplace(keys_.begin() + i, MoperSTL::forward<K>(key));
+        try {
+            values_.emplace(values_.begin() + i, MoperSTL::forward<Args>(args)...);
+        } catch (...) {
+            keys_.erase(keys_.begin() + i);
+            throw;
+        }
+    }
+
+    // ѼֵǵݼϲԭԪȵԪԭԪ֮
+    // ԪضСԭԪʱֱ׷ĩβȡԪز¸ԵĲλãٺϲµ vector н
+    // ԭԪֻһƶƶ׳쳣ʱƣ;׳쳣ʱֲ
+    template <bool Move, class InputIterator>
+    void merge_equal(InputIterator first, InputIterator last, size_type n) {
+        if (first == last)
+            return;
+        if (empty() || !comp_((*first).first, keys_.back())) {
+            reserve(size() + n);
+            for (; first != last; ++first) {
+                auto&& value = *first;
+                append(flat_take<Move>(value.first), flat_take<Move>(value.second));
+            }
+            return;
+        }
+        key_container_type    new_keys;
+        mapped_container_type new_values;
+        MoperSTL::vector<size_type> pos;  //  k ԪزԭԪ keys_[pos[k]] ֮ǰ
+        new_keys.reserve(n);
+        new_values.reserve(n);
+        pos.reserve(n);
+        size_type i = 0;
+        const size_type old_size = size();
+        for (; first != last; ++first) {
+            auto&& value = *first;
+            while (i < old_size && !comp_(value.first, keys_[i]))
+                ++i;
+            new_keys.emplace_back(flat_take<Move>(value.first));
+            new_values.emplace_back(flat_take<Move>(value.second));
+            pos.push_back(i);
+        }
+        merge_at(new_keys, new_values, pos);
+    }
+
+    // ĩβ׷һԪأֵʧʱ׷ӵļֵ
+    template <class K, class V>
+    void append(K&& key, V&& value) {
+        keys_.emplace_back(MoperSTL::forward<K>(key));
+        try {
+            values_.emplace_back(MoperSTL::forward<V>(value));
+        } catch (...) {
+            keys_.pop_back();
+            throw;
+        }
+    }
+
+    void merge_at(key_container_type& new_keys, mapped_container_type& new_values,
+                  const MoperSTL::vector<size_type>& pos) {
+        constexpr bool nothrow = std::is_nothrow_move_constructible<Key>::value &&
+                                 std::is_nothrow_move_constructible<T>::value;
+        key_container_type    keys = flat_merge_at<nothrow>(keys_, new_keys, pos);
+        mapped_container_type values = flat_merge_at<nothrow>(values_, new_values, pos);
+        keys_.swap(keys);
+        values_.swap(values);
+    }
+};
+
+// رȽϲ
+template <class Key, class T, class Compare>
+bool operator!=(const flat_multimap<Key, T, Compare>& lhs, const flat_multimap<Key, T, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>(const flat_multimap<Key, T, Compare>& lhs, const flat_multimap<Key, T, Compare>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare>
+bool operator<=(const flat_multimap<Key, T, Compare>& lhs, const flat_multimap<Key, T, Compare>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>=(const flat_multimap<Key, T, Compare>& lhs, const flat_multimap<Key, T, Compare>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  MoperSTL  swap
+template <class Key, class T, class Compare>
+void swap(flat_multimap<Key, T, Compare>& lhs, flat_multimap<Key, T, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_FLAT_MAP_H */
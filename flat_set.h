@@ -0,0 +1,709 @@
+#ifndef MOPER_STL_FLAT_SET_H
+#define MOPER_STL_FLAT_SET_H
+
+// ͷļģ flat_set  flat_multiset
+// Ԫذֵźһ MoperSTL::vector Уӿ set / multiset ͬ
+// Ϊ޷֧Ķֲңֻڴ棬ʺϹһΡѯεĳ
+// ԪصĲɾΪ O(n)ԪأԭԪһαϲ
+// ע⣺ɾʹеʧЧ
+
+#include <initializer_list>
+
+#include "__flat_tree.h"
+
+namespace MoperSTL {
+
+// ģ flat_setֵظ
+// һֵֵͣȽϷʽȱʡʹ MoperSTL::less
+template <class Key, class Compare = MoperSTL::less<Key>>
+class flat_set {
+public:
+    typedef Key                                            key_type;
+    typedef Key                                            value_type;
+    typedef Compare                                        key_compare;
+    typedef Compare                                        value_compare;
+    typedef MoperSTL::vector<Key>                          container_type;
+
+    typedef const Key*                                     pointer;
+    typedef const Key*                                     const_pointer;
+    typedef const Key&                                     reference;
+    typedef const Key&                                     const_reference;
+    typedef const Key*                                     iterator;
+    typedef const Key*                                     const_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>     reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef typename container_type::size_type             size_type;
+    typedef typename container_type::difference_type       difference_type;
+
+private:
+    container_type keys_;  // ֵϸŵԪ
+    key_compare    comp_;
+
+public:
+  // 졢ơƶ
+    flat_set() = default;
+
+    explicit flat_set(const key_compare& comp)
+        :keys_(), comp_(comp) {}
+
+    template <class InputIterator>
+    flat_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        :keys_(), comp_(comp) {
+        insert(first, last);
+    }
+    // ϸ乹죬Ƚϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    flat_set(sorted_unique_t, InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare())
+        :keys_(), comp_(comp) {
+        for (; first != last; ++first)
+            keys_.emplace_back(*first);
+    }
+    flat_set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        :keys_(), comp_(comp) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // ӹһ vector Ϊײ洢ȥظļֵ
+    explicit flat_set(container_type cont, const key_compare& comp = key_compare())
+        :keys_(), comp_(comp) {
+        flat_stable_sort(cont.data(), cont.data() + cont.size(), comp_);
+        merge_unique<true>(cont.begin(), cont.end(), cont.size());
+    }
+    // ӹһϸ vector Ϊײ洢
+    flat_set(sorted_unique_t, container_type cont, const key_compare& comp = key_compare())
+        :keys_(MoperSTL::move(cont)), comp_(comp) {}
+
+    flat_set(const flat_set& rhs)
+        :keys_(rhs.keys_), comp_(rhs.comp_) {}
+    flat_set(flat_set&& rhs) noexcept
+        :keys_(MoperSTL::move(rhs.keys_)), comp_(rhs.comp_) {}
+
+    flat_set& operator=(const flat_set& rhs) {
+        keys_ = rhs.keys_;
+        comp_ = rhs.comp_;
+        return *this;
+    }
+    flat_set& operator=(flat_set&& rhs) {
+        keys_ = MoperSTL::move(rhs.keys_);
+        comp_ = rhs.comp_;
+        return *this;
+    }
+    flat_set& operator=(std::initializer_list<value_type> ilist) {
+        keys_.clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ؽӿ
+
+    key_compare           key_comp()   const { return comp_; }
+    value_compare         value_comp() const { return comp_; }
+
+    // ײ vector
+    const container_type& keys()       const noexcept { return keys_; }
+
+    // ȡߵײ vectorΪ
+    container_type        extract() {
+        container_type tmp(MoperSTL::move(keys_));
+        keys_.clear();
+        return tmp;
+    }
+    // ϸ vector 滻ײ洢
+    void                  replace(container_type&& cont) {
+        keys_ = MoperSTL::move(cont);
+    }
+
+    // 
+
+    iterator               begin()         noexcept { return keys_.begin(); }
+    const_iterator         begin()   const noexcept { return keys_.begin(); }
+    iterator               end()           noexcept { return keys_.end(); }
+    const_iterator         end()     const noexcept { return keys_.end(); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 
+
+    bool                   empty()    const noexcept { return keys_.empty(); }
+    size_type              size()     const noexcept { return keys_.size(); }
+    size_type              max_size() const noexcept { return keys_.max_size(); }
+    size_type              capacity() const noexcept { return keys_.capacity(); }
+
+    void                   reserve(size_type n) { keys_.reserve(n); }
+    void                   shrink_to_fit()      { keys_.shrink_to_fit(); }
+
+    // ɾ
+
+    template <class ...Args>
+    pair<iterator, bool> emplace(Args&& ...args) {
+        value_type value(MoperSTL::forward<Args>(args)...);
+        return insert_value(MoperSTL::move(value));
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator hint, Args&& ...args) {
+        value_type value(MoperSTL::forward<Args>(args)...);
+        return insert_value_use_hint(hint, MoperSTL::move(value));
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        return insert_value(value);
+    }
+    pair<iterator, bool> insert(value_type&& value) {
+        return insert_value(MoperSTL::move(value));
+    }
+
+    iterator insert(const_iterator hint, const value_type& value) {
+        return insert_value_use_hint(hint, value);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        return insert_value_use_hint(hint, MoperSTL::move(value));
+    }
+
+    // 룺Ԫȷʱ岢ԭԪһαϲʱ临Ӷ O(n + m log m)
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        container_type buf;
+        buf.reserve(flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+        for (; first != last; ++first)
+            buf.emplace_back(*first);
+        flat_stable_sort(buf.data(), buf.data() + buf.size(), comp_);
+        merge_unique<true>(buf.begin(), buf.end(), buf.size());
+    }
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // ϸ䣺ԭԪһαϲʱ临Ӷ O(n + m)
+    template <class InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last) {
+        merge_unique<false>(first, last,
+                            flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+    }
+
+    iterator  erase(const_iterator position) { return keys_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return keys_.erase(first, last); }
+    size_type erase(const key_type& key) {
+        const_iterator it = find(key);
+        if (it == end())
+            return 0;
+        keys_.erase(it);
+        return 1;
+    }
+
+    void      clear() { keys_.clear(); }
+
+    // flat_set ز
+
+    iterator       find(const key_type& key) { return find_imp(key); }
+    const_iterator find(const key_type& key)        const { return find_imp(key); }
+
+    size_type      count(const key_type& key)       const { return find_imp(key) != end() ? 1 : 0; }
+    bool           contains(const key_type& key)    const { return find_imp(key) != end(); }
+
+    iterator       lower_bound(const key_type& key) { return lower_bound_imp(key); }
+    const_iterator lower_bound(const key_type& key) const { return lower_bound_imp(key); }
+
+    iterator       upper_bound(const key_type& key) { return upper_bound_imp(key); }
+    const_iterator upper_bound(const key_type& key) const { return upper_bound_imp(key); }
+
+    pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        const_iterator it = find_imp(key);
+        return it == end() ? pair<const_iterator, const_iterator>(it, it)
+                           : pair<const_iterator, const_iterator>(it, it + 1);
+    }
+
+    // 칹ң key_compare  is_transparent ʱã less<void>
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key)        const { return find_imp(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count(const K& key)       const {
+        return static_cast<size_type>(upper_bound_imp(key) - lower_bound_imp(key));
+    }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    bool           contains(const K& key)    const { return find_imp(key) != end(); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return lower_bound_imp(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return upper_bound_imp(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<const_iterator, const_iterator>
+        equal_range(const K& key) const {
+        return pair<const_iterator, const_iterator>(lower_bound_imp(key), upper_bound_imp(key));
+    }
+
+    void           swap(flat_set& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        MoperSTL::swap(comp_, rhs.comp_);
+    }
+
+public:
+    friend bool operator==(const flat_set& lhs, const flat_set& rhs) {
+        return lhs.size() == rhs.size() && MoperSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator< (const flat_set& lhs, const flat_set& rhs) {
+        return MoperSTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    // lookup
+
+    template <class K>
+    const_iterator lower_bound_imp(const K& key) const {
+        return flat_lower_bound(keys_.data(), keys_.size(), key, comp_);
+    }
+    template <class K>
+    const_iterator upper_bound_imp(const K& key) const {
+        return flat_upper_bound(keys_.data(), keys_.size(), key, comp_);
+    }
+    template <class K>
+    const_iterator find_imp(const K& key) const {
+        const_iterator it = lower_bound_imp(key);
+        return (it == end() || comp_(key, *it)) ? end() : it;
+    }
+
+    // insert
+
+    template <class V>
+    pair<iterator, bool> insert_value(V&& value) {
+        const_iterator pos = lower_bound_imp(value);
+        if (pos != end() && !comp_(value, *pos))
+            return pair<iterator, bool>(pos, false);
+        return pair<iterator, bool>(keys_.emplace(pos, MoperSTL::forward<V>(value)), true);
+    }
+
+    // hint ǡǲλãǰһԪС value  hint  valueʱʡȥ
+    template <class V>
+    iterator insert_value_use_hint(const_iterator hint, V&& value) {
+        if ((hint == begin() || comp_(*(hint - 1), value)) &&
+            (hint == end() || comp_(value, *hint)))
+            return keys_.emplace(hint, MoperSTL::forward<V>(value));
+        return insert_value(MoperSTL::forward<V>(value)).first;
+    }
+
+    // ϸȶǵݼϲظļֵȳֵǸ
+    // ԪضԭԪʱֱ׷ĩβȡԪز¸ԵĲλãٺϲµ vector н
+    // ԭԪֻһƶƶ׳쳣ʱƣ;׳쳣ʱֲ
+    template <bool Move, class InputIterator>
+    void merge_unique(InputIterator first, InputIterator last, size_type n) {
+        if (first == last)
+            return;
+        if (keys_.empty() || comp_(keys_.back(), *first)) {
+            keys_.reserve(keys_.size() + n);
+            for (; first != last; ++first) {
+                auto&& value = *first;
+                if (keys_.empty() || comp_(keys_.back(), value))
+                    keys_.emplace_back(flat_take<Move>(value));
+            }
+            return;
+        }
+        container_type added;
+        MoperSTL::vector<size_type> pos;  // added[k] ԭԪ keys_[pos[k]] ֮ǰ
+        added.reserve(n);
+        pos.reserve(n);
+        size_type i = 0;
+        const size_type old_size = keys_.size();
+        for (; first != last; ++first) {
+            auto&& value = *first;
+            while (i < old_size && comp_(keys_[i], value))
+                ++i;
+            if (i < old_size && !comp_(value, keys_[i]))
+                continue;  // ͬļֵ
+            if (!added.empty() && pos.back() == i && !comp_(added.back(), value))
+                continue;  // һԪظ
+            added.emplace_back(flat_take<Move>(value));
+            pos.push_back(i);
+        }
+        container_type result = flat_merge_at<std::is_nothrow_move_constructible<Key>::value>(keys_, added, pos);
+        keys_.swap(result);
+    }
+};
+
+// رȽϲ
+template <class Key, class Compare>
+bool operator!=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare>
+bool operator>(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class Compare>
+bool operator<=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class Compare>
+bool operator>=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  MoperSTL  swap
+template <class Key, class Compare>
+void swap(flat_set<Key, Compare>& lhs, flat_set<Key, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// ģ flat_multisetֵظ
+// һֵֵͣȽϷʽȱʡʹ MoperSTL::less
+template <class Key, class Compare = MoperSTL::less<Key>>
+class flat_multiset {
+public:
+    typedef Key                                            key_type;
+    typedef Key                                            value_type;
+    typedef Compare                                        key_compare;
+    typedef Compare                                        value_compare;
+    typedef MoperSTL::vector<Key>                          container_type;
+
+    typedef const Key*                                     pointer;
+    typedef const Key*                                     const_pointer;
+    typedef const Key&                                     reference;
+    typedef const Key&                                     const_reference;
+    typedef const Key*                                     iterator;
+    typedef const Key*                                     const_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>     reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef typename container_type::size_type             size_type;
+    typedef typename container_type::difference_type       difference_type;
+
+private:
+    container_type keys_;  // ֵǵݼŵԪأȵԪذ˳
+    key_compare    comp_;
+
+public:
+  // 졢ơƶ
+    flat_multiset() = default;
+
+    explicit flat_multiset(const key_compare& comp)
+        :keys_(), comp_(comp) {}
+
+    template <class InputIterator>
+    flat_multiset(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        :keys_(), comp_(comp) {
+        insert(first, last);
+    }
+    // Էǵݼ乹죬Ƚϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    flat_multiset(sorted_equivalent_t, InputIterator first, InputIterator last,
+                  const key_compare& comp = key_compare())
+        :keys_(), comp_(comp) {
+        for (; first != last; ++first)
+            keys_.emplace_back(*first);
+    }
+    flat_multiset(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        :keys_(), comp_(comp) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // ӹһ vector Ϊײ洢Ƚȶ
+    explicit flat_multiset(container_type cont, const key_compare& comp = key_compare())
+        :keys_(MoperSTL::move(cont)), comp_(comp) {
+        flat_stable_sort(keys_.data(), keys_.data() + keys_.size(), comp_);
+    }
+    // ӹһǵݼ vector Ϊײ洢
+    flat_multiset(sorted_equivalent_t, container_type cont, const key_compare& comp = key_compare())
+        :keys_(MoperSTL::move(cont)), comp_(comp) {}
+
+    flat_multiset(const flat_multiset& rhs)
+        :keys_(rhs.keys_), comp_(rhs.comp_) {}
+    flat_multiset(flat_multiset&& rhs) noexcept
+        :keys_(MoperSTL::move(rhs.keys_)), comp_(rhs.comp_) {}
+
+    flat_multiset& operator=(const flat_multiset& rhs) {
+        keys_ = rhs.keys_;
+        comp_ = rhs.comp_;
+        return *this;
+    }
+    flat_multiset& operator=(flat_multiset&& rhs) {
+        keys_ = MoperSTL::move(rhs.keys_);
+        comp_ = rhs.comp_;
+        return *this;
+    }
+    flat_multiset& operator=(std::initializer_list<value_type> ilist) {
+        keys_.clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ؽӿ
+
+    key_compare           key_comp()   const { return comp_; }
+    value_compare         value_comp() const { return comp_; }
+
+    // ײ vector
+    const container_type& keys()       const noexcept { return keys_; }
+
+    // ȡߵײ vectorΪ
+    container_type        extract() {
+        container_type tmp(MoperSTL::move(keys_));
+        keys_.clear();
+        return tmp;
+    }
+    // Էǵݼ vector 滻ײ洢
+    void                  replace(container_type&& cont) {
+        keys_ = MoperSTL::move(cont);
+    }
+
+    // 
+
+    iterator               begin()         noexcept { return keys_.begin(); }
+    const_iterator         begin()   const noexcept { return keys_.begin(); }
+    iterator               end()           noexcept { return keys_.end(); }
+    const_iterator         end()     const noexcept { return keys_.end(); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 
+
+    bool                   empty()    const noexcept { return keys_.empty(); }
+    size_type              size()     const noexcept { return keys_.size(); }
+    size_type              max_size() const noexcept { return keys_.max_size(); }
+    size_type              capacity() const noexcept { return keys_.capacity(); }
+
+    void                   reserve(size_type n) { keys_.reserve(n); }
+    void                   shrink_to_fit()      { keys_.shrink_to_fit(); }
+
+    // ɾ
+
+    template <class ...Args>
+    iterator emplace(Args&& ...args) {
+        value_type value(MoperSTL::forward<Args>(args)...);
+        return insert_value(MoperSTL::move(value));
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator hint, Args&& ...args) {
+        value_type value(MoperSTL::forward<Args>(args)...);
+        return insert_value_use_hint(hint, MoperSTL::move(value));
+    }
+
+    iterator insert(const value_type& value) {
+        return insert_value(value);
+    }
+    iterator insert(value_type&& value) {
+        return insert_value(MoperSTL::move(value));
+    }
+
+    iterator insert(const_iterator hint, const value_type& value) {
+        return insert_value_use_hint(hint, value);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        return insert_value_use_hint(hint, MoperSTL::move(value));
+    }
+
+    // 룺Ԫȷʱ岢ȶԭԪһαϲʱ临Ӷ O(n + m log m)
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        container_type buf;
+        buf.reserve(flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+        for (; first != last; ++first)
+            buf.emplace_back(*first);
+        flat_stable_sort(buf.data(), buf.data() + buf.size(), comp_);
+        merge_equal<true>(buf.begin(), buf.end(), buf.size());
+    }
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // ǵݼ䣺ԭԪһαϲʱ临Ӷ O(n + m)
+    template <class InputIterator>
+    void insert(sorted_equivalent_t, InputIterator first, InputIterator last) {
+        merge_equal<false>(first, last,
+                           flat_range_size(first, last, MoperSTL::__iterator_category(first)));
+    }
+
+    iterator  erase(const_iterator position) { return keys_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return keys_.erase(first, last); }
+    size_type erase(const key_type& key) {
+        const_iterator first = lower_bound_imp(key), last = upper_bound_imp(key);
+        const size_type n = static_cast<size_type>(last - first);
+        keys_.erase(first, last);
+        return n;
+    }
+
+    void      clear() { keys_.clear(); }
+
+    // flat_multiset ز
+
+    iterator       find(const key_type& key) { return find_imp(key); }
+    const_iterator find(const key_type& key)        const { return find_imp(key); }
+
+    size_type      count(const key_type& key)       const {
+        return static_cast<size_type>(upper_bound_imp(key) - lower_bound_imp(key));
+    }
+    bool           contains(const key_type& key)    const { return find_imp(key) != end(); }
+
+    iterator       lower_bound(const key_type& key) { return lower_bound_imp(key); }
+    const_iterator lower_bound(const key_type& key) const { return lower_bound_imp(key); }
+
+    iterator       upper_bound(const key_type& key) { return upper_bound_imp(key); }
+    const_iterator upper_bound(const key_type& key) const { return upper_bound_imp(key); }
+
+    pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        return pair<const_iterator, const_iterator>(lower_bound_imp(key), upper_bound_imp(key));
+    }
+
+    // 칹ң key_compare  is_transparent ʱã less<void>
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key)        const { return find_imp(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count(const K& key)       const {
+        return static_cast<size_type>(upper_bound_imp(key) - lower_bound_imp(key));
+    }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    bool           contains(const K& key)    const { return find_imp(key) != end(); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return lower_bound_imp(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return upper_bound_imp(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<const_iterator, const_iterator>
+        equal_range(const K& key) const {
+        return pair<const_iterator, const_iterator>(lower_bound_imp(key), upper_bound_imp(key));
+    }
+
+    void           swap(flat_multiset& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        MoperSTL::swap(comp_, rhs.comp_);
+    }
+
+public:
+    friend bool operator==(const flat_multiset& lhs, const flat_multiset& rhs) {
+        return lhs.size() == rhs.size() && MoperSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator< (const flat_multiset& lhs, const flat_multiset& rhs) {
+        return MoperSTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    // lookup
+
+    template <class K>
+    const_iterator lower_bound_imp(const K& key) const {
+        return flat_lower_bound(keys_.data(), keys_.size(), key, comp_);
+    }
+    template <class K>
+    const_iterator upper_bound_imp(const K& key) const {
+        return flat_upper_bound(keys_.data(), keys_.size(), key, comp_);
+    }
+    template <class K>
+    const_iterator find_imp(const K& key) const {
+        const_iterator it = lower_bound_imp(key);
+        return (it == end() || comp_(key, *it)) ? end() : it;
+    }
+
+    // insert
+
+    // ԪزԪصĩβ
+    template <class V>
+    iterator insert_value(V&& value) {
+        return keys_.emplace(upper_bound_imp(value), MoperSTL::forward<V>(value));
+    }
+
+    // hint ǺϷĲλãǰһԪز value  hint С valueʱʡȥ
+    template <class V>
+    iterator insert_value_use_hint(const_iterator hint, V&& value) {
+        if ((hint == begin() || !comp_(value, *(hint - 1))) &&
+            (hint == end() || !comp_(*hint, value)))
+            return keys_.emplace(hint, MoperSTL::forward<V>(value));
+        return insert_value(MoperSTL::forward<V>(value));
+    }
+
+    // ѷǵݼϲԭԪȵԪԭԪ֮
+    // ԪضСԭԪʱֱ׷ĩβȡԪز¸ԵĲλãٺϲµ vector н
+    // ԭԪֻһƶƶ׳쳣ʱƣ;׳쳣ʱֲ
+    template <bool Move, class InputIterator>
+    void merge_equal(InputIterator first, InputIterator last, size_type n) {
+        if (first == last)
+            return;
+        if (keys_.empty() || !comp_(*first, keys_.back())) {
+            keys_.reserve(keys_.size() + n);
+            for (; first != last; ++first) {
+                auto&& value = *first;
+                keys_.emplace_back(flat_take<Move>(value));
+            }
+            return;
+        }
+        container_type added;
+        MoperSTL::vector<size_type> pos;  // added[k] ԭԪ keys_[pos[k]] ֮ǰ
+        added.reserve(n);
+        pos.reserve(n);
+        size_type i = 0;
+        const size_type old_size = keys_.size();
+        for (; first != last; ++first) {
+            auto&& value = *first;
+            while (i < old_size && !comp_(value, keys_[i]))
+                ++i;
+            added.emplace_back(flat_take<Move>(value));
+            pos.push_back(i);
+        }
+        container_type result = flat_merge_at<std::is_nothrow_move_constructible<Key>::value>(keys_, added, pos);
+        keys_.swap(result);
+    }
+};
+
+// رȽϲ
+template <class Key, class Compare>
+bool operator!=(const flat_multiset<Key, Compare>& lhs, const flat_multiset<Key, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare>
+bool operator>(const flat_multiset<Key, Compare>& lhs, const flat_multiset<Key, Compare>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class Compare>
+bool operator<=(const flat_multiset<Key, Compare>& lhs, const flat_multiset<Key, Compare>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class Compare>
+bool operator>=(const flat_multiset<Key, Compare>& lhs, const flat_multiset<Key, Compare>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  MoperSTL  swap
+template <class Key, class Compare>
+void swap(flat_multiset<Key, Compare>& lhs, flat_multiset<Key, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_FLAT_SET_H */
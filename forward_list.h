@@ -0,0 +1,790 @@
+#ifndef MOPER_STL_FORWARD_LIST_H
+#define MOPER_STL_FORWARD_LIST_H
+
+// ÿڵֻһ next ָ
+// ڵ㾭 MoperSTL::allocator ڴط䣻next λڽڵʼ
+//  clear  erase_after ԰ڵֱӽڴ
+
+#include <initializer_list>
+#include "iterator.h"
+#include "memory.h"
+#include "exceptdef.h"
+#include "algorithm.h"
+#include "functional.h"
+
+namespace MoperSTL {
+
+template <class T> struct forward_list_node_base;
+template <class T> struct forward_list_node;
+
+template <class T>
+struct forward_list_node_traits {
+    typedef forward_list_node_base<T>* base_ptr;
+    typedef forward_list_node<T>*      node_ptr;
+};
+
+// forward_list Ľڵṹ
+
+template <class T>
+struct forward_list_node_base {
+    typedef typename forward_list_node_traits<T>::base_ptr base_ptr;
+    typedef typename forward_list_node_traits<T>::node_ptr node_ptr;
+
+    base_ptr next;  // һڵ
+
+    forward_list_node_base() = default;
+
+    node_ptr as_node() {
+        return static_cast<node_ptr>(this);
+    }
+};
+
+template <class T>
+struct forward_list_node : public forward_list_node_base<T> {
+    typedef typename forward_list_node_traits<T>::base_ptr base_ptr;
+
+    T value;  // 
+
+    base_ptr as_base() {
+        return static_cast<base_ptr>(this);
+    }
+};
+
+// forward_list ĵ
+template <class T>
+struct forward_list_iterator : public MoperSTL::iterator<MoperSTL::forward_iterator_tag, T> {
+    typedef T                                               value_type;
+    typedef T*                                              pointer;
+    typedef T&                                              reference;
+    typedef typename forward_list_node_traits<T>::base_ptr  base_ptr;
+    typedef typename forward_list_node_traits<T>::node_ptr  node_ptr;
+    typedef forward_list_iterator<T>                        self;
+
+    base_ptr node_;  // ָǰڵ
+
+    forward_list_iterator() = default;
+    forward_list_iterator(base_ptr x) :node_(x) {}
+
+    reference operator*()  const { return node_->as_node()->value; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+template <class T>
+struct forward_list_const_iterator : public MoperSTL::iterator<MoperSTL::forward_iterator_tag, T> {
+    typedef T                                               value_type;
+    typedef const T*                                        pointer;
+    typedef const T&                                        reference;
+    typedef typename forward_list_node_traits<T>::base_ptr  base_ptr;
+    typedef typename forward_list_node_traits<T>::node_ptr  node_ptr;
+    typedef forward_list_const_iterator<T>                  self;
+
+    base_ptr node_;
+
+    forward_list_const_iterator() = default;
+    forward_list_const_iterator(base_ptr x) :node_(x) {}
+    forward_list_const_iterator(const forward_list_iterator<T>& rhs) :node_(rhs.node_) {}
+
+    reference operator*()  const { return node_->as_node()->value; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// ģ: forward_list
+// ģ T 
+template <class T>
+class forward_list {
+public:
+    // forward_list Ƕͱ
+    typedef MoperSTL::allocator<T>                      allocator_type;
+    typedef MoperSTL::allocator<T>                      data_allocator;
+    typedef MoperSTL::allocator<forward_list_node<T>>   node_allocator;
+
+    typedef typename allocator_type::value_type      value_type;
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::size_type       size_type;
+    typedef typename allocator_type::difference_type difference_type;
+
+    typedef forward_list_iterator<T>                 iterator;
+    typedef forward_list_const_iterator<T>           const_iterator;
+
+    typedef typename forward_list_node_traits<T>::base_ptr base_ptr;
+    typedef typename forward_list_node_traits<T>::node_ptr node_ptr;
+
+    allocator_type get_allocator() { return allocator_type(); }
+
+private:
+    forward_list_node_base<T> head_;  // Ԫ֮ǰڱڵ㣬head_.next ΪձʾΪ
+    size_type                 size_;  // С
+
+public:
+    // 졢ơƶ
+    forward_list() noexcept :size_(0) {
+        head_.next = nullptr;
+    }
+
+    explicit forward_list(size_type n) :forward_list() {
+        insert_after(cbefore_begin(), n, value_type());
+    }
+
+    forward_list(size_type n, const T& value) :forward_list() {
+        insert_after(cbefore_begin(), n, value);
+    }
+
+    template <class Iter, typename std::enable_if<
+        std::is_convertible_v<
+        typename MoperSTL::iterator_traits<Iter>::iterator_category, MoperSTL::input_iterator_tag>
+        , int>::type = 0>
+    forward_list(Iter first, Iter last) :forward_list() {
+        insert_after(cbefore_begin(), first, last);
+    }
+
+    forward_list(std::initializer_list<T> ilist) :forward_list() {
+        insert_after(cbefore_begin(), ilist.begin(), ilist.end());
+    }
+
+    forward_list(const forward_list& rhs) :forward_list() {
+        insert_after(cbefore_begin(), rhs.cbegin(), rhs.cend());
+    }
+
+    forward_list(forward_list&& rhs) noexcept :size_(rhs.size_) {
+        head_.next = rhs.head_.next;
+        rhs.head_.next = nullptr;
+        rhs.size_ = 0;
+    }
+
+    forward_list& operator=(const forward_list& rhs) {
+        if (this != &rhs) {
+            assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    forward_list& operator=(forward_list&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    forward_list& operator=(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~forward_list() {
+        clear();
+    }
+
+public:
+    // ز
+    iterator       before_begin()        noexcept {
+        return &head_;
+    }
+    const_iterator before_begin()  const noexcept {
+        return const_cast<base_ptr>(&head_);
+    }
+    iterator       begin()               noexcept {
+        return head_.next;
+    }
+    const_iterator begin()         const noexcept {
+        return head_.next;
+    }
+    iterator       end()                 noexcept {
+        return nullptr;
+    }
+    const_iterator end()           const noexcept {
+        return nullptr;
+    }
+
+    const_iterator cbefore_begin() const noexcept {
+        return before_begin();
+    }
+    const_iterator cbegin()        const noexcept {
+        return begin();
+    }
+    const_iterator cend()          const noexcept {
+        return end();
+    }
+
+    // ز
+    bool      empty()    const noexcept {
+        return head_.next == nullptr;
+    }
+
+    size_type size()     const noexcept {
+        return size_;
+    }
+
+    size_type max_size() const noexcept {
+        return static_cast<size_type>(-1);
+    }
+
+    // Ԫز
+    reference       front() {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    // ز
+
+    // assign
+
+    void     assign(size_type n, const value_type& value);
+
+    template <class Iter, typename std::enable_if<
+        std::is_convertible_v<
+        typename MoperSTL::iterator_traits<Iter>::iterator_category, MoperSTL::input_iterator_tag>
+        , int>::type = 0>
+    void     assign(Iter first, Iter last) {
+        copy_assign(first, last);
+    }
+
+    void     assign(std::initializer_list<T> ilist) {
+        copy_assign(ilist.begin(), ilist.end());
+    }
+
+    // emplace_front / emplace_after
+
+    template <class ...Args>
+    void     emplace_front(Args&& ...args) {
+        emplace_after(cbefore_begin(), MoperSTL::forward<Args>(args)...);
+    }
+
+    template <class ...Args>
+    iterator emplace_after(const_iterator pos, Args&& ...args) {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "forward_list<T>'s size too big");
+        auto node = create_node(MoperSTL::forward<Args>(args)...);
+        link_after(pos.node_, node->as_base(), node->as_base());
+        ++size_;
+        return iterator(node->as_base());
+    }
+
+    // insert_after
+
+    iterator insert_after(const_iterator pos, const value_type& value) {
+        return emplace_after(pos, value);
+    }
+
+    iterator insert_after(const_iterator pos, value_type&& value) {
+        return emplace_after(pos, MoperSTL::move(value));
+    }
+
+    iterator insert_after(const_iterator pos, size_type n, const value_type& value);
+
+    template <class Iter, typename std::enable_if<
+        std::is_convertible_v<typename MoperSTL::iterator_traits<Iter>::iterator_category, MoperSTL::input_iterator_tag>
+        , int>::type = 0>
+    iterator insert_after(const_iterator pos, Iter first, Iter last);
+
+    iterator insert_after(const_iterator pos, std::initializer_list<T> ilist) {
+        return insert_after(pos, ilist.begin(), ilist.end());
+    }
+
+    // push_front / pop_front
+
+    void     push_front(const value_type& value) {
+        emplace_after(cbefore_begin(), value);
+    }
+
+    void     push_front(value_type&& value) {
+        emplace_after(cbefore_begin(), MoperSTL::move(value));
+    }
+
+    void     pop_front() {
+        MYSTL_DEBUG(!empty());
+        erase_after(cbefore_begin());
+    }
+
+    // erase_after / clear
+
+    iterator erase_after(const_iterator pos);
+    iterator erase_after(const_iterator first, const_iterator last);
+
+    void     clear() {
+        erase_after(cbefore_begin(), cend());
+    }
+
+    // resize
+
+    void     resize(size_type new_size) { resize(new_size, value_type()); }
+    void     resize(size_type new_size, const value_type& value);
+
+    void     swap(forward_list& rhs) noexcept {
+        MoperSTL::swap(head_.next, rhs.head_.next);
+        MoperSTL::swap(size_, rhs.size_);
+    }
+
+    // forward_list ز
+
+    void splice_after(const_iterator pos, forward_list& other);
+    void splice_after(const_iterator pos, forward_list& other, const_iterator it);
+    void splice_after(const_iterator pos, forward_list& other, const_iterator first, const_iterator last);
+
+    void remove(const value_type& value) {
+        remove_if([&](const value_type& v) {return v == value; });
+    }
+    template <class UnaryPredicate>
+    void remove_if(UnaryPredicate pred);
+
+    void unique() {
+        unique(MoperSTL::equal_to<T>());
+    }
+    template <class BinaryPredicate>
+    void unique(BinaryPredicate pred);
+
+    void merge(forward_list& x) {
+        merge(x, MoperSTL::less<T>());
+    }
+    template <class Compare>
+    void merge(forward_list& x, Compare comp);
+
+    void sort() {
+        sort(MoperSTL::less<T>());
+    }
+    template <class Compared>
+    void sort(Compared comp);
+
+    void reverse() noexcept;
+
+private:
+    // helper functions
+
+    // create / destroy node
+    template <class ...Args>
+    node_ptr create_node(Args&& ...args);
+    void     destroy_node(node_ptr p);
+    void     destroy_nodes(base_ptr first, base_ptr last);
+
+    // link
+    static void link_after(base_ptr pos, base_ptr first, base_ptr last) noexcept;
+
+    // assign
+    template <class Iter>
+    void     copy_assign(Iter first, Iter last);
+
+    // merge
+    template <class Compare>
+    static base_ptr merge_nodes(base_ptr a, base_ptr b, Compare& comp);
+};
+
+/*****************************************************************************************/
+
+//  n ԪΪֵ
+template <class T>
+void forward_list<T>::assign(size_type n, const value_type& value) {
+    auto prev = before_begin();
+    auto i = begin();
+    auto e = end();
+    for (; n > 0 && i != e; --n, ++i, ++prev) {
+        *i = value;
+    }
+    if (n > 0) {
+        insert_after(prev, n, value);
+    } else {
+        erase_after(prev, e);
+    }
+}
+
+//  pos ֮ n Ԫ
+// ½ڵⲿãȫɹһӣʧʱ
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::insert_after(const_iterator pos, size_type n, const value_type& value) {
+    if (n == 0)
+        return iterator(pos.node_);
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "forward_list<T>'s size too big");
+    const auto add_size = n;
+    auto first = create_node(value)->as_base();
+    auto last = first;
+    try {
+        for (--n; n > 0; --n) {
+            last->next = create_node(value)->as_base();
+            last = last->next;
+        }
+    } catch (...) {
+        destroy_nodes(first, last);
+        throw;
+    }
+    link_after(pos.node_, first, last);
+    size_ += add_size;
+    return iterator(last);
+}
+
+//  pos ֮ [first, last) Ԫ
+template <class T>
+template <class Iter, typename std::enable_if<
+    std::is_convertible_v<typename MoperSTL::iterator_traits<Iter>::iterator_category, MoperSTL::input_iterator_tag>
+    , int>::type>
+typename forward_list<T>::iterator
+forward_list<T>::insert_after(const_iterator pos, Iter first, Iter last) {
+    if (first == last)
+        return iterator(pos.node_);
+    size_type n = 1;
+    auto f = create_node(*first)->as_base();
+    auto l = f;
+    try {
+        for (++first; first != last; ++first, ++n) {
+            l->next = create_node(*first)->as_base();
+            l = l->next;
+        }
+    } catch (...) {
+        destroy_nodes(f, l);
+        throw;
+    }
+    link_after(pos.node_, f, l);
+    size_ += n;
+    return iterator(l);
+}
+
+// ɾ pos ֮Ԫ
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::erase_after(const_iterator pos) {
+    auto p = pos.node_;
+    MYSTL_DEBUG(p != nullptr && p->next != nullptr);
+    auto n = p->next;
+    p->next = n->next;
+    destroy_node(n->as_node());
+    --size_;
+    return iterator(p->next);
+}
+
+// ɾ (first, last) ڵԪ
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::erase_after(const_iterator first, const_iterator last) {
+    auto p = first.node_;
+    if (p->next != last.node_) {
+        auto f = p->next;
+        auto l = f;
+        size_type n = 1;
+        for (; l->next != last.node_; l = l->next)
+            ++n;
+        p->next = last.node_;
+        size_ -= n;
+        destroy_nodes(f, l);
+    }
+    return iterator(last.node_);
+}
+
+// С
+template <class T>
+void forward_list<T>::resize(size_type new_size, const value_type& value) {
+    auto prev = before_begin();
+    size_type len = 0;
+    while (prev.node_->next != nullptr && len < new_size) {
+        ++prev;
+        ++len;
+    }
+    if (len == new_size) {
+        erase_after(prev, end());
+    } else {
+        insert_after(prev, new_size - len, value);
+    }
+}
+
+//  forward_list x Ӻ pos ֮
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list& x) {
+    MYSTL_DEBUG(this != &x);
+    if (!x.empty()) {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_, "forward_list<T>'s size too big");
+        auto f = x.head_.next;
+        auto l = f;
+        while (l->next != nullptr)
+            l = l->next;
+        x.head_.next = nullptr;
+        link_after(pos.node_, f, l);
+        size_ += x.size_;
+        x.size_ = 0;
+    }
+}
+
+//  it ֮һڵӺ pos ֮
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list& x, const_iterator it) {
+    auto n = it.node_->next;
+    if (pos.node_ != it.node_ && pos.node_ != n) {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "forward_list<T>'s size too big");
+        it.node_->next = n->next;
+        link_after(pos.node_, n, n);
+        ++size_;
+        --x.size_;
+    }
+}
+
+//  x  (first, last) ڵĽڵӺ pos ֮
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list& x,
+                                   const_iterator first, const_iterator last) {
+    auto f = first.node_->next;
+    if (f == last.node_)
+        return;
+    size_type n = 1;
+    auto l = f;
+    for (; l->next != last.node_; l = l->next)
+        ++n;
+    if (this != &x) {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "forward_list<T>'s size too big");
+        size_ += n;
+        x.size_ -= n;
+    }
+    first.node_->next = last.node_;
+    link_after(pos.node_, f, l);
+}
+
+// һԪ pred Ϊ true ԪƳ
+template <class T>
+template <class UnaryPredicate>
+void forward_list<T>::remove_if(UnaryPredicate pred) {
+    base_ptr prev = &head_;
+    while (prev->next != nullptr) {
+        if (pred(prev->next->as_node()->value)) {
+            erase_after(prev);
+        } else {
+            prev = prev->next;
+        }
+    }
+}
+
+// Ƴ forward_list  pred Ϊ true ظԪ
+template <class T>
+template <class BinaryPredicate>
+void forward_list<T>::unique(BinaryPredicate pred) {
+    auto i = head_.next;
+    if (i == nullptr)
+        return;
+    while (i->next != nullptr) {
+        if (pred(i->as_node()->value, i->next->as_node()->value)) {
+            erase_after(i);
+        } else {
+            i = i->next;
+        }
+    }
+}
+
+// һ forward_list ϲ comp Ϊ true ˳ֻıָ룬Ԫ
+template <class T>
+template <class Compare>
+void forward_list<T>::merge(forward_list& x, Compare comp) {
+    if (this != &x) {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_, "forward_list<T>'s size too big");
+        head_.next = merge_nodes(head_.next, x.head_.next, comp);
+        x.head_.next = nullptr;
+        size_ += x.size_;
+        x.size_ = 0;
+    }
+}
+
+// ԵϵĹ鲢򣺵 i λųΪ 2^i  list_sort ͬΪȶ
+// ҪռҲݹ飬ֻıڵ next ָ
+template <class T>
+template <class Compared>
+void forward_list<T>::sort(Compared comp) {
+    if (size_ < 2)
+        return;
+    base_ptr bins[64] = {};
+    size_type fill = 0;
+    auto cur = head_.next;
+    while (cur != nullptr) {
+        auto carry = cur;
+        cur = cur->next;
+        carry->next = nullptr;
+        size_type i = 0;
+        for (; i < fill && bins[i] != nullptr; ++i) {
+            carry = merge_nodes(bins[i], carry, comp);
+            bins[i] = nullptr;
+        }
+        bins[i] = carry;
+        if (i == fill)
+            ++fill;
+    }
+    base_ptr result = nullptr;
+    for (size_type i = 0; i < fill; ++i) {
+        if (bins[i] != nullptr)
+            result = merge_nodes(bins[i], result, comp);
+    }
+    head_.next = result;
+}
+
+//  forward_list ת
+template <class T>
+void forward_list<T>::reverse() noexcept {
+    base_ptr prev = nullptr;
+    auto cur = head_.next;
+    while (cur != nullptr) {
+        auto next = cur->next;
+        cur->next = prev;
+        prev = cur;
+        cur = next;
+    }
+    head_.next = prev;
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 
+template <class T>
+template <class ...Args>
+typename forward_list<T>::node_ptr
+forward_list<T>::create_node(Args&& ...args) {
+    node_ptr p = node_allocator().allocate(1);
+    try {
+        data_allocator().construct(MoperSTL::addressof(p->value), MoperSTL::forward<Args>(args)...);
+        p->next = nullptr;
+    } catch (...) {
+        node_allocator().deallocate(p, 1);
+        throw;
+    }
+    return p;
+}
+
+// ٽ
+template <class T>
+void forward_list<T>::destroy_node(node_ptr p) {
+    data_allocator().destroy(MoperSTL::addressof(p->value));
+    node_allocator().deallocate(p, 1);
+}
+
+//  next  [first, last] 
+// next ڵ׸֣ڵ´һνڴ
+template <class T>
+void forward_list<T>::destroy_nodes(base_ptr first, base_ptr last) {
+    if (!std::is_trivially_destructible<T>::value) {
+        for (auto cur = first; ; cur = cur->next) {
+            data_allocator().destroy(MoperSTL::addressof(cur->as_node()->value));
+            if (cur == last)
+                break;
+        }
+    }
+    node_allocator().deallocate_chain(first->as_node(), last->as_node(), 1);
+}
+
+//  pos ֮ [first, last] Ľ
+template <class T>
+void forward_list<T>::link_after(base_ptr pos, base_ptr first, base_ptr last) noexcept {
+    last->next = pos->next;
+    pos->next = first;
+}
+
+// [f2, l2)Ϊֵ
+template <class T>
+template <class Iter>
+void forward_list<T>::copy_assign(Iter f2, Iter l2) {
+    auto prev = before_begin();
+    auto f1 = begin();
+    auto l1 = end();
+    for (; f1 != l1 && f2 != l2; ++f1, ++f2, ++prev) {
+        *f1 = *f2;
+    }
+    if (f2 == l2) {
+        erase_after(prev, l1);
+    } else {
+        insert_after(prev, f2, l2);
+    }
+}
+
+// ϲԿָβʱ a еԪǰغϲ׽ڵ
+template <class T>
+template <class Compare>
+typename forward_list<T>::base_ptr
+forward_list<T>::merge_nodes(base_ptr a, base_ptr b, Compare& comp) {
+    forward_list_node_base<T> head;
+    base_ptr tail = &head;
+    while (a != nullptr && b != nullptr) {
+        if (comp(b->as_node()->value, a->as_node()->value)) {
+            tail->next = b;
+            b = b->next;
+        } else {
+            tail->next = a;
+            a = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = (a != nullptr) ? a : b;
+    return head.next;
+}
+
+// رȽϲ
+template <class T>
+bool operator==(const forward_list<T>& lhs, const forward_list<T>& rhs) {
+    auto f1 = lhs.cbegin();
+    auto f2 = rhs.cbegin();
+    auto l1 = lhs.cend();
+    auto l2 = rhs.cend();
+    for (; f1 != l1 && f2 != l2 && *f1 == *f2; ++f1, ++f2)
+        ;
+    return f1 == l1 && f2 == l2;
+}
+
+template <class T>
+bool operator<(const forward_list<T>& lhs, const forward_list<T>& rhs) {
+    return MoperSTL::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <class T>
+bool operator!=(const forward_list<T>& lhs, const forward_list<T>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T>
+bool operator>(const forward_list<T>& lhs, const forward_list<T>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T>
+bool operator<=(const forward_list<T>& lhs, const forward_list<T>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T>
+bool operator>=(const forward_list<T>& lhs, const forward_list<T>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  MoperSTL  swap
+template <class T>
+void swap(forward_list<T>& lhs, forward_list<T>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_FORWARD_LIST_H */
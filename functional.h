@@ -1,7 +1,14 @@
 #ifndef MOPER_STL_FUNCTIONAL_H
 #define MOPER_STL_FUNCTIONAL_H
 
+#include <cstdint> // uint64_t
+#include <cstring> // memcpy()
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h> // _umul128()
+#endif
+
 #include "type_traits.h"
+#include "utility.h"
 
 namespace MoperSTL {
 
@@ -73,11 +80,23 @@ struct negate :public unarg_function<T, T> {
 //*******************************************************************
 
 // 󣺵
-template < class T>
+template <class T = void>
 struct equal_to : binary_function<T, T, bool> {
 	constexpr bool operator() (const T& lhs, const T& rhs) const { return lhs == rhs; }
 };
 
+// ͸ĵڣ == ȽϵĶ󣬲ת
+template <>
+struct equal_to<void> {
+	typedef int is_transparent;
+
+	template <class T, class U>
+	constexpr auto operator()(T&& lhs, U&& rhs) const
+		-> decltype(MoperSTL::forward<T>(lhs) == MoperSTL::forward<U>(rhs)) {
+		return MoperSTL::forward<T>(lhs) == MoperSTL::forward<U>(rhs);
+	}
+};
+
 // 󣺲
 template <class T>
 struct not_equal_to :public binary_function<T, T, bool> {
@@ -85,17 +104,41 @@ struct not_equal_to :public binary_function<T, T, bool> {
 };
 
 // 󣺴
-template <class T>
+template <class T = void>
 struct greater :public binary_function<T, T, bool> {
 	constexpr bool operator()(const T& x, const T& y) const { return x > y; }
 };
 
+// ͸Ĵ
+template <>
+struct greater<void> {
+	typedef int is_transparent;
+
+	template <class T, class U>
+	constexpr auto operator()(T&& x, U&& y) const
+		-> decltype(MoperSTL::forward<T>(x) > MoperSTL::forward<U>(y)) {
+		return MoperSTL::forward<T>(x) > MoperSTL::forward<U>(y);
+	}
+};
+
 // С
 template <class T = void>
 struct less :public binary_function<T, T, bool> {
 	constexpr bool operator()(const T& x, const T& y) const { return x < y; }
 };
 
+// ͸СڣıȽʱfind / count / lower_bound ȿֱӽֵͲͬĲ
+template <>
+struct less<void> {
+	typedef int is_transparent;
+
+	template <class T, class U>
+	constexpr auto operator()(T&& x, U&& y) const
+		-> decltype(MoperSTL::forward<T>(x) < MoperSTL::forward<U>(y)) {
+		return MoperSTL::forward<T>(x) < MoperSTL::forward<U>(y);
+	}
+};
+
 // 󣺴ڵ
 template <class T>
 struct greater_equal :public binary_function<T, T, bool> {
@@ -167,162 +210,299 @@ struct bit_not : public unarg_function<T, T> {
 };
 
 
+
+//*******************************************************************
+//
+// ֤ͬ
+// 
+//*******************************************************************
+
+// ֤ͬز
+template <class T>
+struct identity : public unarg_function<T, T> {
+	constexpr const T& operator()(const T& x) const { return x; }
+};
+
+
 //*******************************************************************
 //
 // hash 
 // 
 //*******************************************************************
 
-template <class Key>
+// ֽеĹϣFNV-1aֽڴ
+inline std::size_t bitwise_hash(const unsigned char* first, std::size_t count) {
+	#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) &&__SIZEOF_POINTER__ == 8)
+	const std::size_t fnv_offset = 14695981039346656037ull;
+	const std::size_t fnv_prime = 1099511628211ull;
+	#else
+	const std::size_t fnv_offset = 2166136261u;
+	const std::size_t fnv_prime = 16777619u;
+	#endif
+	std::size_t result = fnv_offset;
+	for (std::size_t i = 0; i < count; ++i) {
+		result ^= (std::size_t)first[i];
+		result *= fnv_prime;
+	}
+	return result;
+}
+
+// 64 λ˷ĵ 64 λ a 64 λ b
+inline void hash_mum(std::uint64_t& a, std::uint64_t& b) noexcept {
+	#if defined(__SIZEOF_INT128__)
+	const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+	a = static_cast<std::uint64_t>(r);
+	b = static_cast<std::uint64_t>(r >> 64);
+	#elif defined(_MSC_VER) && defined(_M_X64)
+	a = _umul128(a, b, &b);
+	#else
+	const std::uint64_t ha = a >> 32, la = static_cast<std::uint32_t>(a);
+	const std::uint64_t hb = b >> 32, lb = static_cast<std::uint32_t>(b);
+	const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	const std::uint64_t t = rl + (rm0 << 32);
+	const std::uint64_t lo = t + (rm1 << 32);
+	const std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+	a = lo;
+	b = hi;
+	#endif
+}
+
+//  64 λĳ˻ߵ򣬳˻ÿһλλ
+inline std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b) noexcept {
+	hash_mum(a, b);
+	return a ^ b;
+}
+
+inline std::uint64_t hash_read8(const unsigned char* p) noexcept {
+	std::uint64_t v;
+	std::memcpy(&v, p, 8);
+	return v;
+}
+
+inline std::uint64_t hash_read4(const unsigned char* p) noexcept {
+	std::uint32_t v;
+	std::memcpy(&v, p, 4);
+	return v;
+}
+
+// ֽеĹϣwyhashÿֶ 16 ֽڣ 48 ֽʱ·Уÿ 48 ֽڣ
+inline std::size_t wy_hash(const unsigned char* p, std::size_t count) noexcept {
+	const std::uint64_t s0 = 0x2d358dccaa6c78a5ull, s1 = 0x8bb84b93962eacc9ull;
+	const std::uint64_t s2 = 0x4b33a62ed433d4a3ull, s3 = 0x4d5a2da51de1aa47ull;
+	std::uint64_t seed = hash_mix(s0, s1);
+	std::uint64_t a, b;
+	if (count <= 16) {
+		if (count >= 4) {
+			// 4~16 ֽڣβ 4 ֽڣص
+			const std::size_t d = (count >> 3) << 2;
+			a = (hash_read4(p) << 32) | hash_read4(p + d);
+			b = (hash_read4(p + count - 4) << 32) | hash_read4(p + count - 4 - d);
+		}
+		else if (count > 0) {
+			a = (static_cast<std::uint64_t>(p[0]) << 16) |
+			    (static_cast<std::uint64_t>(p[count >> 1]) << 8) | p[count - 1];
+			b = 0;
+		}
+		else {
+			a = b = 0;
+		}
+	}
+	else {
+		std::size_t i = count;
+		if (i > 48) {
+			std::uint64_t see1 = seed, see2 = seed;
+			do {
+				seed = hash_mix(hash_read8(p) ^ s1, hash_read8(p + 8) ^ seed);
+				see1 = hash_mix(hash_read8(p + 16) ^ s2, hash_read8(p + 24) ^ see1);
+				see2 = hash_mix(hash_read8(p + 32) ^ s3, hash_read8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16) {
+			seed = hash_mix(hash_read8(p) ^ s1, hash_read8(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		//  16 ֽڴĩβȡѴĲص
+		a = hash_read8(p + i - 16);
+		b = hash_read8(p + i - 8);
+	}
+	a ^= s1;
+	b ^= seed;
+	hash_mum(a, b);
+	return static_cast<std::size_t>(hash_mix(a ^ s0 ^ count, b ^ s1));
+}
+
+// Ĺϣһ 64 λ˷ʹλı仯ҲӰλ
+inline std::size_t wy_hash_integer(std::uint64_t val) noexcept {
+	return static_cast<std::size_t>(hash_mix(val ^ 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull));
+}
+
+// ϣԣ hash ֽУַָ룩Ĵʽ
+//   hash_bytes(first, count)ֽеĹϣ
+//   hash_integer(val)Ĺϣ
+// fnv_hash_policy Ϊֽڵ FNV-1a ӳ䣬wy_hash_policy Ϊ wyhash һγ˷
+// ֻϣֵμ㣻ϣֵ bucket ӳ __hash_table.h е bucket_policy 
+struct fnv_hash_policy {
+	static std::size_t hash_bytes(const unsigned char* first, std::size_t count) noexcept {
+		return bitwise_hash(first, count);
+	}
+	static std::size_t hash_integer(std::uint64_t val) noexcept {
+		return static_cast<std::size_t>(val);
+	}
+};
+
+struct wy_hash_policy {
+	static std::size_t hash_bytes(const unsigned char* first, std::size_t count) noexcept {
+		return wy_hash(first, count);
+	}
+	static std::size_t hash_integer(std::uint64_t val) noexcept {
+		return wy_hash_integer(val);
+	}
+};
+
+// hash ȱʡԣڰļǰ MYSTL_HASH_POLICY 滻
+#ifndef MYSTL_HASH_POLICY
+#define MYSTL_HASH_POLICY MoperSTL::wy_hash_policy
+#endif
+typedef MYSTL_HASH_POLICY default_hash_policy;
+
+// Ϊϣԣ hash<string, fnv_hash_policy>
+template <class Key, class Policy = default_hash_policy>
 struct hash {};
 
-template <class T>
-struct hash<T*> {
+template <class T, class Policy>
+struct hash<T*, Policy> {
 	std::size_t operator()(T* p) const noexcept {
-		return reinterpret_cast<std::size_t>(p);
+		return Policy::hash_integer(reinterpret_cast<std::uintptr_t>(p));
 	}
 };
 
-template<>
-struct hash<bool> {
+template <class Policy>
+struct hash<bool, Policy> {
 	std::size_t operator()(bool val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<char> {
+template <class Policy>
+struct hash<char, Policy> {
 	std::size_t operator()(char val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<signed char> {
+template <class Policy>
+struct hash<signed char, Policy> {
 	std::size_t operator()(signed char val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<unsigned char> {
+template <class Policy>
+struct hash<unsigned char, Policy> {
 	std::size_t operator()(unsigned char val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<wchar_t> {
+template <class Policy>
+struct hash<wchar_t, Policy> {
 	std::size_t operator()(wchar_t val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<char16_t> {
+template <class Policy>
+struct hash<char16_t, Policy> {
 	std::size_t operator()(char16_t val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<char32_t> {
+template <class Policy>
+struct hash<char32_t, Policy> {
 	std::size_t operator()(char32_t val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<short> {
+template <class Policy>
+struct hash<short, Policy> {
 	std::size_t operator()(short val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<unsigned short> {
+template <class Policy>
+struct hash<unsigned short, Policy> {
 	std::size_t operator()(unsigned short val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<int> {
+template <class Policy>
+struct hash<int, Policy> {
 	std::size_t operator()(int val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<unsigned int> {
+template <class Policy>
+struct hash<unsigned int, Policy> {
 	std::size_t operator()(unsigned int val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<long> {
+template <class Policy>
+struct hash<long, Policy> {
 	std::size_t operator()(long val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<unsigned long> {
+template <class Policy>
+struct hash<unsigned long, Policy> {
 	std::size_t operator()(unsigned long val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<long long> {
+template <class Policy>
+struct hash<long long, Policy> {
 	std::size_t operator()(long long val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-template<>
-struct hash<unsigned long long> {
+template <class Policy>
+struct hash<unsigned long long, Policy> {
 	std::size_t operator()(unsigned long long val) const noexcept {
-		return static_cast<std::size_t>(val);
+		return Policy::hash_integer(static_cast<std::uint64_t>(val));
 	}
 };
 
-// ڸλϣ
-inline std::size_t bitwise_hash(const unsigned char* first, std::size_t count) {
-	#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) &&__SIZEOF_POINTER__ == 8)
-	const std::size_t fnv_offset = 14695981039346656037ull;
-	const std::size_t fnv_prime = 1099511628211ull;
-	#else
-	const std::size_t fnv_offset = 2166136261u;
-	const std::size_t fnv_prime = 16777619u;
-	#endif
-	std::size_t result = fnv_offset;
-	for (std::size_t i = 0; i < count; ++i) {
-		result ^= (std::size_t)first[i];
-		result *= fnv_prime;
-	}
-	return result;
-}
-
-template <>
-struct hash<float> {
-	std::size_t operator()(const float& val) {
-		return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(float));
+template <class Policy>
+struct hash<float, Policy> {
+	std::size_t operator()(const float& val) const noexcept {
+		return val == 0.0f ? 0 : Policy::hash_bytes((const unsigned char*)&val, sizeof(float));
 	}
 };
 
-template <>
-struct hash<double> {
-	std::size_t operator()(const double& val) {
-		return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(double));
+template <class Policy>
+struct hash<double, Policy> {
+	std::size_t operator()(const double& val) const noexcept {
+		return val == 0.0f ? 0 : Policy::hash_bytes((const unsigned char*)&val, sizeof(double));
 	}
 };
 
-template <>
-struct hash<long double> {
-	std::size_t operator()(const long double& val) {
-		return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(long double));
+template <class Policy>
+struct hash<long double, Policy> {
+	std::size_t operator()(const long double& val) const noexcept {
+		return val == 0.0f ? 0 : Policy::hash_bytes((const unsigned char*)&val, sizeof(long double));
 	}
 };
 
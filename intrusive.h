@@ -0,0 +1,979 @@
+#ifndef MOPER_STL_INTRUSIVE_H
+#define MOPER_STL_INTRUSIVE_H
+
+// ʽǶҹhookֻӣҲٶ
+//  public ʽ̳ɸ Tag ͬĹҹ󣬿ͬʱλڶ
+// תƽֱӸ list.h  __rb_tree.h е㷨
+
+#include <type_traits>
+#include <utility>
+#include "list.h"
+#include "__rb_tree.h"
+#include "__hash_table.h"
+#include "functional.h"
+#include "vector.h"
+#include "exceptdef.h"
+
+namespace MoperSTL {
+
+// ȱʡĹҹǩ
+struct intrusive_default_tag {};
+
+// ͨ KeyOfValue Ӷȡõļֵͱ
+template <class T, class KeyOfValue>
+struct intrusive_key_of {
+    typedef typename std::decay<
+        decltype(std::declval<const KeyOfValue&>()(std::declval<const T&>()))>::type type;
+};
+
+/*****************************************************************************************/
+// intrusive_list
+
+// ҹnext Ϊձʾδӣƶʱӹϵ
+template <class Tag = intrusive_default_tag>
+struct intrusive_list_hook : public list_node_base<Tag> {
+    intrusive_list_hook() noexcept { this->prev = this->next = nullptr; }
+    intrusive_list_hook(const intrusive_list_hook&) noexcept { this->prev = this->next = nullptr; }
+    intrusive_list_hook& operator=(const intrusive_list_hook&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return this->next != nullptr; }
+};
+
+// intrusive_list ĵ
+template <class T, class Tag, class Ref, class Ptr>
+struct intrusive_list_iterator : public MoperSTL::iterator<MoperSTL::bidirectional_iterator_tag, T> {
+    typedef intrusive_list_iterator<T, Tag, T&, T*>             iterator;
+    typedef intrusive_list_iterator<T, Tag, const T&, const T*> const_iterator;
+    typedef intrusive_list_iterator                             self;
+
+    typedef T                    value_type;
+    typedef Ptr                  pointer;
+    typedef Ref                  reference;
+    typedef list_node_base<Tag>* base_ptr;
+
+    base_ptr node_;  // ָǰĹҹ
+
+    intrusive_list_iterator() noexcept :node_(nullptr) {}
+    intrusive_list_iterator(base_ptr x) noexcept :node_(x) {}
+    intrusive_list_iterator(const iterator& rhs) noexcept :node_(rhs.node_) {}
+
+    reference operator*()  const {
+        return *static_cast<T*>(static_cast<intrusive_list_hook<Tag>*>(node_));
+    }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->prev;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// ģ intrusive_list
+// һ̳ͣ intrusive_list_hook<Tag>ʹùҹıǩ
+template <class T, class Tag = intrusive_default_tag>
+class intrusive_list {
+public:
+    typedef intrusive_list_hook<Tag>                          hook_type;
+    typedef list_node_base<Tag>*                              base_ptr;
+
+    typedef T                                                 value_type;
+    typedef T*                                                pointer;
+    typedef const T*                                          const_pointer;
+    typedef T&                                                reference;
+    typedef const T&                                          const_reference;
+    typedef std::size_t                                       size_type;
+    typedef std::ptrdiff_t                                    difference_type;
+
+    typedef intrusive_list_iterator<T, Tag, T&, T*>             iterator;
+    typedef intrusive_list_iterator<T, Tag, const T&, const T*> const_iterator;
+    typedef MoperSTL::reverse_iterator<iterator>                reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>          const_reverse_iterator;
+
+private:
+    list_node_base<Tag> node_;  // ڱڵ
+    size_type           size_;  // С
+
+public:
+    // 졢ڱڵǶɸƻƶ
+
+    intrusive_list() noexcept :size_(0) {
+        node_.prev = node_.next = sentinel();
+    }
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    ~intrusive_list() { clear(); }
+
+public:
+    // ز
+
+    iterator               begin()         noexcept { return node_.next; }
+    const_iterator         begin()   const noexcept { return node_.next; }
+    iterator               end()           noexcept { return sentinel(); }
+    const_iterator         end()     const noexcept { return sentinel(); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+
+    // ɶȡָĵO(1)
+    static iterator        iterator_to(reference value) noexcept { return to_base(value); }
+
+    // ز
+
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size()  const noexcept { return size_; }
+
+    // Ԫز
+
+    reference       front()       { MYSTL_DEBUG(!empty()); return *begin(); }
+    const_reference front() const { MYSTL_DEBUG(!empty()); return *begin(); }
+    reference       back()        { MYSTL_DEBUG(!empty()); return *(--end()); }
+    const_reference back()  const { MYSTL_DEBUG(!empty()); return *(--end()); }
+
+    // ޸ز
+
+    iterator insert(const_iterator pos, reference value);
+
+    void     push_front(reference value) { insert(begin(), value); }
+    void     push_back(reference value)  { insert(end(), value); }
+
+    iterator erase(const_iterator pos);
+    //  value ƳO(1)
+    void     erase(reference value) { erase(iterator_to(value)); }
+
+    void     pop_front() { MYSTL_DEBUG(!empty()); erase(begin()); }
+    void     pop_back()  { MYSTL_DEBUG(!empty()); erase(--end()); }
+
+    void     clear() noexcept;
+
+    //  other жӺ pos ֮ǰ
+    void     splice(const_iterator pos, intrusive_list& other);
+
+    template <class UnaryPredicate>
+    void     remove_if(UnaryPredicate pred);
+
+private:
+    // helper functions
+
+    base_ptr sentinel() const noexcept {
+        return const_cast<base_ptr>(&node_);
+    }
+    static base_ptr to_base(reference value) noexcept {
+        return static_cast<base_ptr>(static_cast<hook_type*>(MoperSTL::addressof(value)));
+    }
+};
+
+/*****************************************************************************************/
+
+//  pos ֮ǰ value
+template <class T, class Tag>
+typename intrusive_list<T, Tag>::iterator
+intrusive_list<T, Tag>::insert(const_iterator pos, reference value) {
+    auto n = to_base(value);
+    MYSTL_DEBUG(!static_cast<hook_type*>(n)->is_linked());
+    MoperSTL::list_link_nodes(pos.node_, n, n);
+    ++size_;
+    return iterator(n);
+}
+
+// Ƴ pos Ķ󣬷һλ
+template <class T, class Tag>
+typename intrusive_list<T, Tag>::iterator
+intrusive_list<T, Tag>::erase(const_iterator pos) {
+    MYSTL_DEBUG(pos != cend());
+    auto n = pos.node_;
+    auto next = n->next;
+    MoperSTL::list_unlink_nodes(n, n);
+    n->prev = n->next = nullptr;
+    --size_;
+    return iterator(next);
+}
+
+// ֻӹϵ
+template <class T, class Tag>
+void intrusive_list<T, Tag>::clear() noexcept {
+    auto cur = node_.next;
+    while (cur != sentinel()) {
+        auto next = cur->next;
+        cur->prev = cur->next = nullptr;
+        cur = next;
+    }
+    node_.prev = node_.next = sentinel();
+    size_ = 0;
+}
+
+template <class T, class Tag>
+void intrusive_list<T, Tag>::splice(const_iterator pos, intrusive_list& other) {
+    if (this != &other && !other.empty()) {
+        auto f = other.node_.next;
+        auto l = other.node_.prev;
+        MoperSTL::list_unlink_nodes(f, l);
+        MoperSTL::list_link_nodes(pos.node_, f, l);
+        size_ += other.size_;
+        other.size_ = 0;
+    }
+}
+
+template <class T, class Tag>
+template <class UnaryPredicate>
+void intrusive_list<T, Tag>::remove_if(UnaryPredicate pred) {
+    for (auto it = begin(); it != end();) {
+        if (pred(*it))
+            it = erase(it);
+        else
+            ++it;
+    }
+}
+
+/*****************************************************************************************/
+// intrusive_rb_tree
+
+// ҹparent Ϊձʾδ
+template <class Tag = intrusive_default_tag>
+struct intrusive_rb_tree_hook : public rb_tree_node_base<Tag> {
+    intrusive_rb_tree_hook() noexcept { reset(); }
+    intrusive_rb_tree_hook(const intrusive_rb_tree_hook&) noexcept { reset(); }
+    intrusive_rb_tree_hook& operator=(const intrusive_rb_tree_hook&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return this->get_parent() != nullptr; }
+
+    void reset() noexcept {
+        this->parent_color = 0;  // ڵΪգɫΪ
+        this->left = this->right = nullptr;
+    }
+};
+
+// intrusive_rb_tree ĵƣǰ˸ rb_tree_iterator_base
+template <class T, class Tag, class Ref, class Ptr>
+struct intrusive_rb_tree_iterator : public rb_tree_iterator_base<Tag> {
+    typedef intrusive_rb_tree_iterator<T, Tag, T&, T*>             iterator;
+    typedef intrusive_rb_tree_iterator<T, Tag, const T&, const T*> const_iterator;
+    typedef intrusive_rb_tree_iterator                             self;
+
+    typedef T                      value_type;
+    typedef Ptr                    pointer;
+    typedef Ref                    reference;
+    typedef rb_tree_node_base<Tag>* base_ptr;
+
+    using rb_tree_iterator_base<Tag>::node;
+
+    intrusive_rb_tree_iterator() {}
+    intrusive_rb_tree_iterator(base_ptr x) { node = x; }
+    intrusive_rb_tree_iterator(const iterator& rhs) { node = rhs.node; }
+
+    reference operator*()  const {
+        return *static_cast<T*>(static_cast<intrusive_rb_tree_hook<Tag>*>(node));
+    }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        this->inc();
+        return *this;
+    }
+    self operator++(int) {
+        self tmp(*this);
+        this->inc();
+        return tmp;
+    }
+    self& operator--() {
+        this->dec();
+        return *this;
+    }
+    self operator--(int) {
+        self tmp(*this);
+        this->dec();
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node == rhs.node; }
+    bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// ģ intrusive_rb_tree
+// һ̳ͣ intrusive_rb_tree_hook<Tag>Ӷȡüֵĺ
+// ֵȽͣĴʹùҹıǩ
+template <class T,
+          class KeyOfValue = MoperSTL::identity<T>,
+          class Compare = MoperSTL::less<typename intrusive_key_of<T, KeyOfValue>::type>,
+          class Tag = intrusive_default_tag>
+class intrusive_rb_tree {
+public:
+    typedef intrusive_rb_tree_hook<Tag>                           hook_type;
+    typedef rb_tree_node_base<Tag>*                               base_ptr;
+
+    typedef typename intrusive_key_of<T, KeyOfValue>::type        key_type;
+    typedef T                                                     value_type;
+    typedef Compare                                               key_compare;
+    typedef T*                                                    pointer;
+    typedef const T*                                              const_pointer;
+    typedef T&                                                    reference;
+    typedef const T&                                              const_reference;
+    typedef std::size_t                                           size_type;
+    typedef std::ptrdiff_t                                        difference_type;
+
+    typedef intrusive_rb_tree_iterator<T, Tag, T&, T*>             iterator;
+    typedef intrusive_rb_tree_iterator<T, Tag, const T&, const T*> const_iterator;
+    typedef MoperSTL::reverse_iterator<iterator>                   reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>             const_reverse_iterator;
+
+    key_compare key_comp() const { return key_comp_; }
+
+private:
+    rb_tree_node_base<Tag> header_;      // Ƕͷڵ㣬ڵ㻥ΪԷĸڵ
+    size_type              node_count_;  // ڵ
+    key_compare            key_comp_;    // ڵֵȽϵ׼
+    KeyOfValue             get_key_;     // Ӷȡüֵ
+
+    base_ptr  root()      const { return header()->get_parent(); }
+    base_ptr& leftmost()  const { return header()->left; }
+    base_ptr& rightmost() const { return header()->right; }
+
+public:
+    // 졢ͷڵǶɸƻƶ
+
+    intrusive_rb_tree() :node_count_(0), key_comp_(), get_key_() { init(); }
+    explicit intrusive_rb_tree(const key_compare& comp, const KeyOfValue& kov = KeyOfValue())
+        :node_count_(0), key_comp_(comp), get_key_(kov) { init(); }
+
+    intrusive_rb_tree(const intrusive_rb_tree&) = delete;
+    intrusive_rb_tree& operator=(const intrusive_rb_tree&) = delete;
+
+    ~intrusive_rb_tree() { clear(); }
+
+public:
+    // ز
+
+    iterator               begin()         noexcept { return leftmost(); }
+    const_iterator         begin()   const noexcept { return leftmost(); }
+    iterator               end()           noexcept { return header(); }
+    const_iterator         end()     const noexcept { return header(); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+
+    static iterator        iterator_to(reference value) noexcept { return to_base(value); }
+
+    // ز
+
+    bool      empty() const noexcept { return node_count_ == 0; }
+    size_type size()  const noexcept { return node_count_; }
+
+    // ɾز
+
+    MoperSTL::pair<iterator, bool> insert_unique(reference value);
+    iterator                       insert_multi(reference value);
+
+    iterator  erase(iterator pos);
+    void      erase(reference value) { erase(iterator_to(value)); }
+    size_type erase(const key_type& key);
+
+    void      clear() noexcept;
+
+    // ز
+
+    iterator       find(const key_type& key);
+    const_iterator find(const key_type& key) const;
+
+    size_type      count(const key_type& key) const {
+        auto p = equal_range(key);
+        return static_cast<size_type>(MoperSTL::distance(p.first, p.second));
+    }
+
+    iterator       lower_bound(const key_type& key);
+    const_iterator lower_bound(const key_type& key) const;
+    iterator       upper_bound(const key_type& key);
+    const_iterator upper_bound(const key_type& key) const;
+
+    MoperSTL::pair<iterator, iterator>
+        equal_range(const key_type& key) {
+        return MoperSTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+    MoperSTL::pair<const_iterator, const_iterator>
+        equal_range(const key_type& key) const {
+        return MoperSTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+private:
+    // helper functions
+
+    base_ptr header() const noexcept {
+        return const_cast<base_ptr>(&header_);
+    }
+    static base_ptr to_base(reference value) noexcept {
+        return static_cast<base_ptr>(static_cast<hook_type*>(MoperSTL::addressof(value)));
+    }
+    // ԭת KeyOfValue ķֵֵصļֵ
+    decltype(auto) key_of(base_ptr x) const {
+        return get_key_(*static_cast<const T*>(static_cast<hook_type*>(x)));
+    }
+
+    void init() noexcept;
+    void reset_since(base_ptr x) noexcept;
+};
+
+/*****************************************************************************************/
+
+// 󣬼ֵظ
+template <class T, class KeyOfValue, class Compare, class Tag>
+MoperSTL::pair<typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator, bool>
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::insert_unique(reference value) {
+    auto z = to_base(value);
+    MYSTL_DEBUG(!static_cast<hook_type*>(z)->is_linked());
+    const key_type& key = get_key_(value);
+    auto x = root();
+    auto y = header();
+    bool add_to_left = true;
+    while (x != nullptr) {
+        y = x;
+        add_to_left = key_comp_(key, key_of(x));
+        x = add_to_left ? x->left : x->right;
+    }
+    iterator j(y);
+    if (add_to_left) {
+        if (y == header() || j == begin()) {
+            MoperSTL::rb_tree_link_and_rebalance(z, y, true, header());
+            ++node_count_;
+            return MoperSTL::make_pair(iterator(z), true);
+        }
+        --j;
+    }
+    if (key_comp_(key_of(j.node), key)) {
+        MoperSTL::rb_tree_link_and_rebalance(z, y, add_to_left, header());
+        ++node_count_;
+        return MoperSTL::make_pair(iterator(z), true);
+    }
+    return MoperSTL::make_pair(j, false);
+}
+
+// 󣬼ֵظ¶λڵֵ֮
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::insert_multi(reference value) {
+    auto z = to_base(value);
+    MYSTL_DEBUG(!static_cast<hook_type*>(z)->is_linked());
+    const key_type& key = get_key_(value);
+    auto x = root();
+    auto y = header();
+    bool add_to_left = true;
+    while (x != nullptr) {
+        y = x;
+        add_to_left = key_comp_(key, key_of(x));
+        x = add_to_left ? x->left : x->right;
+    }
+    MoperSTL::rb_tree_link_and_rebalance(z, y, add_to_left, header());
+    ++node_count_;
+    return iterator(z);
+}
+
+// Ƴ pos Ķ󣬷һλ
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::erase(iterator pos) {
+    iterator next = pos;
+    ++next;
+    auto z = MoperSTL::rb_tree_erase_rebalance(pos.node, header());
+    static_cast<hook_type*>(z)->reset();
+    --node_count_;
+    return next;
+}
+
+// Ƴֵ key ж󣬷Ƴĸ
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::size_type
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::erase(const key_type& key) {
+    auto p = equal_range(key);
+    size_type n = 0;
+    while (p.first != p.second) {
+        p.first = erase(p.first);
+        ++n;
+    }
+    return n;
+}
+
+// ֻӹϵ
+template <class T, class KeyOfValue, class Compare, class Tag>
+void intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::clear() noexcept {
+    if (node_count_ != 0) {
+        reset_since(root());
+        init();
+    }
+}
+
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::find(const key_type& key) {
+    iterator j = lower_bound(key);
+    return (j == end() || key_comp_(key, key_of(j.node))) ? end() : j;
+}
+
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::const_iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::find(const key_type& key) const {
+    const_iterator j = lower_bound(key);
+    return (j == end() || key_comp_(key, key_of(j.node))) ? end() : j;
+}
+
+// ֵС key ĵһλ
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::lower_bound(const key_type& key) {
+    auto y = header();
+    auto x = root();
+    while (x != nullptr) {
+        if (!key_comp_(key_of(x), key)) {
+            y = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    return iterator(y);
+}
+
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::const_iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::lower_bound(const key_type& key) const {
+    auto y = header();
+    auto x = root();
+    while (x != nullptr) {
+        if (!key_comp_(key_of(x), key)) {
+            y = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    return const_iterator(y);
+}
+
+// ֵ key ĵһλ
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::upper_bound(const key_type& key) {
+    auto y = header();
+    auto x = root();
+    while (x != nullptr) {
+        if (key_comp_(key, key_of(x))) {
+            y = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    return iterator(y);
+}
+
+template <class T, class KeyOfValue, class Compare, class Tag>
+typename intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::const_iterator
+intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::upper_bound(const key_type& key) const {
+    auto y = header();
+    auto x = root();
+    while (x != nullptr) {
+        if (key_comp_(key, key_of(x))) {
+            y = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    return const_iterator(y);
+}
+
+// ʼͷڵ
+template <class T, class KeyOfValue, class Compare, class Tag>
+void intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::init() noexcept {
+    header_.parent_color = 0;  // ڵΪգheader_ ڵɫΪ죬 root 
+    header_.left = header();
+    header_.right = header();
+    node_count_ = 0;
+}
+
+//  x ڵ㿪ʼøýڵ㼰Ĺҹ
+template <class T, class KeyOfValue, class Compare, class Tag>
+void intrusive_rb_tree<T, KeyOfValue, Compare, Tag>::reset_since(base_ptr x) noexcept {
+    while (x != nullptr) {
+        reset_since(x->right);
+        auto y = x->left;
+        static_cast<hook_type*>(x)->reset();
+        x = y;
+    }
+}
+
+/*****************************************************************************************/
+// intrusive_hash
+
+// ϣҹnext ָʾδ
+template <class Tag = intrusive_default_tag>
+struct intrusive_hash_hook {
+    intrusive_hash_hook* next;
+
+    intrusive_hash_hook() noexcept :next(this) {}
+    intrusive_hash_hook(const intrusive_hash_hook&) noexcept :next(this) {}
+    intrusive_hash_hook& operator=(const intrusive_hash_hook&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return next != this; }
+};
+
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+class intrusive_hash;
+
+// intrusive_hash ĵƣ¼ڵͰԱǰһǿͰ
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag, class Ref, class Ptr>
+struct intrusive_hash_iterator : public MoperSTL::iterator<MoperSTL::forward_iterator_tag, T> {
+    typedef intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>                       table_type;
+    typedef intrusive_hash_iterator<T, KeyOfValue, Hash, KeyEqual, Tag, T&, T*>       iterator;
+    typedef intrusive_hash_iterator                                                   self;
+
+    typedef T                         value_type;
+    typedef Ptr                       pointer;
+    typedef Ref                       reference;
+    typedef intrusive_hash_hook<Tag>* hook_ptr;
+    typedef std::size_t               size_type;
+
+    hook_ptr          node;    // ǰĹҹ
+    size_type         bucket;  // ǰڵͰ
+    const table_type* ht;      // 
+
+    intrusive_hash_iterator() noexcept :node(nullptr), bucket(0), ht(nullptr) {}
+    intrusive_hash_iterator(hook_ptr n, size_type b, const table_type* t) noexcept
+        :node(n), bucket(b), ht(t) {}
+    intrusive_hash_iterator(const iterator& rhs) noexcept
+        :node(rhs.node), bucket(rhs.bucket), ht(rhs.ht) {}
+
+    reference operator*()  const { return *static_cast<T*>(node); }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node != nullptr);
+        node = node->next;
+        while (node == nullptr && ++bucket < ht->buckets_.size())
+            node = ht->buckets_[bucket];
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node == rhs.node; }
+    bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// ģ intrusive_hash
+// һ̳ͣ intrusive_hash_hook<Tag>Ӷȡüֵĺ
+// ϣĴֵȵıȽϺʹùҹıǩ
+// ͰĿȡ ht_prime_listӳ 1 ʱԶ rehash
+template <class T,
+          class KeyOfValue = MoperSTL::identity<T>,
+          class Hash = MoperSTL::hash<typename intrusive_key_of<T, KeyOfValue>::type>,
+          class KeyEqual = MoperSTL::equal_to<typename intrusive_key_of<T, KeyOfValue>::type>,
+          class Tag = intrusive_default_tag>
+class intrusive_hash {
+
+    template <class, class, class, class, class, class, class>
+    friend struct MoperSTL::intrusive_hash_iterator;
+
+public:
+    typedef intrusive_hash_hook<Tag>                                 hook_type;
+    typedef hook_type*                                               hook_ptr;
+
+    typedef typename intrusive_key_of<T, KeyOfValue>::type           key_type;
+    typedef T                                                        value_type;
+    typedef Hash                                                     hasher;
+    typedef KeyEqual                                                 key_equal;
+    typedef T*                                                       pointer;
+    typedef const T*                                                 const_pointer;
+    typedef T&                                                       reference;
+    typedef const T&                                                 const_reference;
+    typedef std::size_t                                              size_type;
+    typedef std::ptrdiff_t                                           difference_type;
+
+    typedef intrusive_hash_iterator<T, KeyOfValue, Hash, KeyEqual, Tag, T&, T*>             iterator;
+    typedef intrusive_hash_iterator<T, KeyOfValue, Hash, KeyEqual, Tag, const T&, const T*> const_iterator;
+
+private:
+    MoperSTL::vector<hook_ptr> buckets_;  // ÿͰΪ next ĵ
+    size_type                  size_;
+    hasher                     hash_;
+    key_equal                  equal_;
+    KeyOfValue                 get_key_;
+
+public:
+    // 졢ж˲ɸ
+
+    explicit intrusive_hash(size_type bucket_count = 101,
+                            const Hash& hash = Hash(),
+                            const KeyEqual& equal = KeyEqual(),
+                            const KeyOfValue& kov = KeyOfValue())
+        :buckets_(MoperSTL::ht_next_prime(bucket_count), nullptr),
+        size_(0), hash_(hash), equal_(equal), get_key_(kov) {}
+
+    intrusive_hash(const intrusive_hash&) = delete;
+    intrusive_hash& operator=(const intrusive_hash&) = delete;
+
+    ~intrusive_hash() { clear(); }
+
+public:
+    // ز
+
+    iterator       begin()        noexcept { return first_node(); }
+    const_iterator begin()  const noexcept { return first_node(); }
+    iterator       end()          noexcept { return iterator(nullptr, buckets_.size(), this); }
+    const_iterator end()    const noexcept { return const_iterator(nullptr, buckets_.size(), this); }
+
+    // ɶȡָĵҪ¼һιϣֵ
+    iterator       iterator_to(reference value) {
+        return iterator(to_hook(value), bucket_index(get_key_(value)), this);
+    }
+
+    // ز
+
+    bool      empty()        const noexcept { return size_ == 0; }
+    size_type size()         const noexcept { return size_; }
+    size_type bucket_count() const noexcept { return buckets_.size(); }
+    float     load_factor()  const noexcept {
+        return static_cast<float>(size_) / static_cast<float>(buckets_.size());
+    }
+
+    // ɾز
+
+    MoperSTL::pair<iterator, bool> insert_unique(reference value);
+    iterator                       insert_multi(reference value);
+
+    iterator  erase(const_iterator pos);
+    void      erase(reference value) { erase(const_iterator(iterator_to(value))); }
+    size_type erase(const key_type& key);
+
+    void      clear() noexcept;
+
+    // ز
+
+    iterator       find(const key_type& key);
+    const_iterator find(const key_type& key) const;
+    size_type      count(const key_type& key) const;
+
+    // ͰĿΪС n ·ֲж
+    void           rehash(size_type n);
+
+private:
+    // helper functions
+
+    static hook_ptr to_hook(reference value) noexcept {
+        return static_cast<hook_ptr>(MoperSTL::addressof(value));
+    }
+    decltype(auto) key_of(hook_ptr x) const {
+        return get_key_(*static_cast<const T*>(x));
+    }
+    size_type bucket_index(const key_type& key) const {
+        return hash_(key) % buckets_.size();
+    }
+
+    iterator  first_node() const;
+    void      rehash_if_need(size_type n);
+};
+
+/*****************************************************************************************/
+
+// 󣬼ֵظ
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+MoperSTL::pair<typename intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::iterator, bool>
+intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::insert_unique(reference value) {
+    auto z = to_hook(value);
+    MYSTL_DEBUG(!z->is_linked());
+    const key_type& key = get_key_(value);
+    auto n = bucket_index(key);
+    for (auto cur = buckets_[n]; cur != nullptr; cur = cur->next) {
+        if (equal_(key_of(cur), key))
+            return MoperSTL::make_pair(iterator(cur, n, this), false);
+    }
+    if (size_ + 1 > buckets_.size()) {
+        rehash_if_need(1);
+        n = bucket_index(key);
+    }
+    z->next = buckets_[n];
+    buckets_[n] = z;
+    ++size_;
+    return MoperSTL::make_pair(iterator(z, n, this), true);
+}
+
+// 󣬼ֵظ¶ڵһֵ֮
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+typename intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::iterator
+intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::insert_multi(reference value) {
+    auto z = to_hook(value);
+    MYSTL_DEBUG(!z->is_linked());
+    rehash_if_need(1);
+    const key_type& key = get_key_(value);
+    const auto n = bucket_index(key);
+    for (auto cur = buckets_[n]; cur != nullptr; cur = cur->next) {
+        if (equal_(key_of(cur), key)) {
+            z->next = cur->next;
+            cur->next = z;
+            ++size_;
+            return iterator(z, n, this);
+        }
+    }
+    z->next = buckets_[n];
+    buckets_[n] = z;
+    ++size_;
+    return iterator(z, n, this);
+}
+
+// Ƴ pos Ķ󣬷һλ
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+typename intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::iterator
+intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::erase(const_iterator pos) {
+    auto p = pos.node;
+    iterator next(p, pos.bucket, this);
+    ++next;
+    hook_ptr* link = &buckets_[pos.bucket];
+    while (*link != p)
+        link = &(*link)->next;
+    *link = p->next;
+    p->next = p;
+    --size_;
+    return next;
+}
+
+// Ƴֵ key ж󣬷Ƴĸ
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+typename intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::size_type
+intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::erase(const key_type& key) {
+    size_type erased = 0;
+    hook_ptr* link = &buckets_[bucket_index(key)];
+    while (*link != nullptr) {
+        auto cur = *link;
+        if (equal_(key_of(cur), key)) {
+            *link = cur->next;
+            cur->next = cur;
+            ++erased;
+        } else {
+            link = &cur->next;
+        }
+    }
+    size_ -= erased;
+    return erased;
+}
+
+// ֻӹϵ
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+void intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::clear() noexcept {
+    for (size_type i = 0; i < buckets_.size(); ++i) {
+        auto cur = buckets_[i];
+        while (cur != nullptr) {
+            auto next = cur->next;
+            cur->next = cur;
+            cur = next;
+        }
+        buckets_[i] = nullptr;
+    }
+    size_ = 0;
+}
+
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+typename intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::iterator
+intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::find(const key_type& key) {
+    const auto n = bucket_index(key);
+    for (auto cur = buckets_[n]; cur != nullptr; cur = cur->next) {
+        if (equal_(key_of(cur), key))
+            return iterator(cur, n, this);
+    }
+    return end();
+}
+
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+typename intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::const_iterator
+intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::find(const key_type& key) const {
+    const auto n = bucket_index(key);
+    for (auto cur = buckets_[n]; cur != nullptr; cur = cur->next) {
+        if (equal_(key_of(cur), key))
+            return const_iterator(cur, n, this);
+    }
+    return end();
+}
+
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+typename intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::size_type
+intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::count(const key_type& key) const {
+    size_type result = 0;
+    for (auto cur = buckets_[bucket_index(key)]; cur != nullptr; cur = cur->next) {
+        if (equal_(key_of(cur), key))
+            ++result;
+    }
+    return result;
+}
+
+// ·ֲʱֻƶҹָ룬ֵ󱣳
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+void intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::rehash(size_type n) {
+    const auto bucket_count = MoperSTL::ht_next_prime(n);
+    if (bucket_count == buckets_.size())
+        return;
+    MoperSTL::vector<hook_ptr> new_buckets(bucket_count, nullptr);
+    for (size_type i = 0; i < buckets_.size(); ++i) {
+        auto cur = buckets_[i];
+        while (cur != nullptr) {
+            // һΰһμֵȵĶ
+            auto last = cur;
+            while (last->next != nullptr && equal_(key_of(last->next), key_of(cur)))
+                last = last->next;
+            auto next = last->next;
+            const auto b = hash_(key_of(cur)) % bucket_count;
+            last->next = new_buckets[b];
+            new_buckets[b] = cur;
+            cur = next;
+        }
+    }
+    buckets_.swap(new_buckets);
+}
+
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+typename intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::iterator
+intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::first_node() const {
+    for (size_type i = 0; i < buckets_.size(); ++i) {
+        if (buckets_[i] != nullptr)
+            return iterator(buckets_[i], i, this);
+    }
+    return iterator(nullptr, buckets_.size(), this);
+}
+
+template <class T, class KeyOfValue, class Hash, class KeyEqual, class Tag>
+void intrusive_hash<T, KeyOfValue, Hash, KeyEqual, Tag>::rehash_if_need(size_type n) {
+    if (size_ + n > buckets_.size())
+        rehash(size_ + n);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_INTRUSIVE_H */
@@ -136,8 +136,11 @@ public:
         Iterator tmp = current;
         return *(--tmp);
     }
+    // ײ operator-> ÷شĵ flat_map ĵҲʹ
     constexpr pointer operator->() const {
-        return &(operator*());
+        Iterator tmp = current;
+        --tmp;
+        return __arrow(tmp, std::is_pointer<Iterator>());
     }
 
     constexpr reverse_iterator& operator++() {
@@ -177,6 +180,10 @@ public:
     constexpr reference operator[](difference_type n) const {
         return *(*this + n);
     }
+
+private:
+    static constexpr pointer __arrow(Iterator it, std::true_type) { return it; }
+    static constexpr pointer __arrow(const Iterator& it, std::false_type) { return it.operator->(); }
 };
 
 
@@ -9,6 +9,16 @@
 
 namespace MoperSTL {
 
+// ÿ list ȱʡĿнڵΪ 0 ʱ
+#ifndef LIST_NODE_CACHE_SIZE
+#define LIST_NODE_CACHE_SIZE 0
+#endif
+
+// Ԫظڴֵʱsort ȰѽڵָռĻһ
+#ifndef LIST_SORT_BUFFER_THRESHOLD
+#define LIST_SORT_BUFFER_THRESHOLD 64
+#endif
+
 template <class T> struct list_node_base;
 template <class T> struct list_node;
 
@@ -62,6 +72,24 @@ struct list_node : public list_node_base<T> {
     }
 };
 
+// list 㷨
+
+//  pos ֮ǰ [first, last] Ľ
+template <class BasePtr>
+void list_link_nodes(BasePtr pos, BasePtr first, BasePtr last) noexcept {
+    pos->prev->next = first;
+    first->prev = pos->prev;
+    pos->prev = last;
+    last->next = pos;
+}
+
+//  [first, last] ĽжϿ
+template <class BasePtr>
+void list_unlink_nodes(BasePtr first, BasePtr last) noexcept {
+    first->prev->next = last->next;
+    last->next->prev = first->prev;
+}
+
 // list ĵ
 template <class T>
 struct list_iterator : public MoperSTL::iterator<MoperSTL::bidirectional_iterator_tag, T> {
@@ -189,6 +217,11 @@ private:
     base_ptr  node_;  // ָĩβڵ
     size_type size_;  // С
 
+    // ڵ㻺棺ɾĽڵ next ɵ֮Ĳ븴
+    base_ptr  free_ = nullptr;                     // нڵ
+    size_type free_size_ = 0;                      // нڵ
+    size_type free_cap_ = LIST_NODE_CACHE_SIZE;    // ໺Ľڵ
+
 public:
   // 졢ơƶ
     list() {
@@ -251,6 +284,8 @@ public:
             node_ = nullptr;
             size_ = 0;
         }
+        // ߵûڱڵ㣬ԻŽڵ
+        release_node_cache();
     }
 
 public:
@@ -307,6 +342,17 @@ public:
         return static_cast<size_type>(-1);
     }
 
+// ڵ㻺ز
+    // ໺ĿнڵĻڵ黹
+    void      node_cache_limit(size_type n);
+    size_type node_cache_limit() const noexcept {
+        return free_cap_;
+    }
+    size_type node_cache_size()  const noexcept {
+        return free_size_;
+    }
+    void      release_node_cache();
+
 // Ԫز
     reference       front() {
         MYSTL_DEBUG(!empty());
@@ -489,11 +535,12 @@ public:
     void merge(list& x, Compare comp);
 
     void sort() {
-        list_sort(begin(), end(), size(), MoperSTL::less<T>());
+        sort(MoperSTL::less<T>());
     }
     template <class Compared>
     void sort(Compared comp) {
-        list_sort(begin(), end(), size(), comp);
+        if (size_ < LIST_SORT_BUFFER_THRESHOLD || !buffer_sort(comp))
+            list_sort(begin(), end(), size(), comp);
     }
 
     void reverse();
@@ -505,6 +552,8 @@ private:
     template <class ...Args>
     node_ptr create_node(Args&& ...agrs);
     void     destroy_node(node_ptr p);
+    size_type destroy_nodes(base_ptr first, base_ptr last);
+    void     put_node(base_ptr p);
 
     // initialize
     void      fill_init(size_type n, const value_type& value);
@@ -531,6 +580,8 @@ private:
     // sort
     template <class Compared>
     iterator  list_sort(iterator first, iterator last, size_type n, Compared comp);
+    template <class Compared>
+    bool      buffer_sort(Compared comp);
 
 };
 
@@ -554,13 +605,10 @@ template <class T>
 typename list<T>::iterator
 list<T>::erase(const_iterator first, const_iterator last) {
     if (first != last) {
-        unlink_nodes(first.node_, last.node_->prev);
-        while (first != last) {
-            auto cur = first.node_;
-            ++first;
-            destroy_node(cur->as_node());
-            --size_;
-        }
+        auto f = first.node_;
+        auto l = last.node_->prev;
+        unlink_nodes(f, l);
+        size_ -= destroy_nodes(f, l);
     }
     return iterator(last.node_);
 }
@@ -569,12 +617,37 @@ list<T>::erase(const_iterator first, const_iterator last) {
 template <class T>
 void list<T>::clear() {
     if (size_ != 0) {
-        auto cur = node_->next;
-        for (base_ptr next = cur->next; cur != node_; cur = next, next = cur->next) {
-            destroy_node(cur->as_node());
-        }
+        auto f = node_->next;
+        auto l = node_->prev;
         node_->unlink();
         size_ = 0;
+        destroy_nodes(f, l);
+    }
+}
+
+// ýڵ㻺
+template <class T>
+void list<T>::node_cache_limit(size_type n) {
+    free_cap_ = n;
+    while (free_size_ > free_cap_) {
+        auto p = free_;
+        free_ = free_->next;
+        --free_size_;
+        node_allocator::deallocate(p->as_node());
+    }
+}
+
+// 黹лĽڵ
+template <class T>
+void list<T>::release_node_cache() {
+    if (free_ != nullptr) {
+        // ׸ָprevڴ
+        auto l = free_;
+        for (; l->next != nullptr; l = l->next)
+            l->prev = l->next;
+        node_allocator::deallocate_chain(free_->as_node(), l->as_node(), 1);
+        free_ = nullptr;
+        free_size_ = 0;
     }
 }
 
@@ -745,13 +818,20 @@ template <class T>
 template <class ...Args>
 typename list<T>::node_ptr
 list<T>::create_node(Args&& ...args) {
-    node_ptr p = node_allocator::allocate(1);
+    node_ptr p;
+    if (free_ != nullptr) {  // ȸûĽڵ
+        p = free_->as_node();
+        free_ = free_->next;
+        --free_size_;
+    } else {
+        p = node_allocator::allocate(1);
+    }
     try {
         data_allocator::construct(MoperSTL::addressof(p->value), MoperSTL::forward<Args>(args)...);
         p->prev = nullptr;
         p->next = nullptr;
     } catch (...) {
-        node_allocator::deallocate(p);
+        put_node(p->as_base());
         throw;
     }
     return p;
@@ -761,7 +841,47 @@ list<T>::create_node(Args&& ...args) {
 template <class T>
 void list<T>::destroy_node(node_ptr p) {
     data_allocator::destroy(MoperSTL::addressof(p->value));
-    node_allocator::deallocate(p);
+    put_node(p->as_base());
+}
+
+// ѶϿ [first, last] 㣬ؽ
+// ֻһΣÿͷĽ㲹ڵ㻺棻ʣĽ last ׸ָprev
+// ǡôصһδĽ㣬ڴҪĵظдһν
+template <class T>
+typename list<T>::size_type list<T>::destroy_nodes(base_ptr first, base_ptr last) {
+    size_type n = 0;
+    base_ptr  rest = first;  // һδ뻺Ľ
+    for (base_ptr cur = first; ; ) {
+        const base_ptr next = cur->next;
+        if (!std::is_trivially_destructible<T>::value)
+            data_allocator::destroy(MoperSTL::addressof(cur->as_node()->value));
+        ++n;
+        const bool end = cur == last;
+        if (free_size_ < free_cap_) {
+            cur->next = free_;
+            free_ = cur;
+            ++free_size_;
+            rest = end ? nullptr : next;
+        }
+        if (end)
+            break;
+        cur = next;
+    }
+    if (rest != nullptr)
+        node_allocator::deallocate_chain(last->as_node(), rest->as_node(), 1);
+    return n;
+}
+
+// 黹һĽ㣺δʱ뻺棬򽻻ڴ
+template <class T>
+void list<T>::put_node(base_ptr p) {
+    if (free_size_ < free_cap_) {
+        p->next = free_;
+        free_ = p;
+        ++free_size_;
+    } else {
+        node_allocator::deallocate(p->as_node());
+    }
 }
 
 //  n Ԫسʼ
@@ -821,10 +941,7 @@ list<T>::link_iter_node(const_iterator pos, base_ptr link_node) {
 //  pos  [first, last] Ľ
 template <class T>
 void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
-    pos->prev->next = first;
-    first->prev = pos->prev;
-    pos->prev = last;
-    last->next = pos;
+    MoperSTL::list_link_nodes(pos, first, last);
 }
 
 // ͷ [first, last] 
@@ -848,8 +965,7 @@ void list<T>::link_nodes_at_back(base_ptr first, base_ptr last) {
 //  [first, last] Ͽ
 template <class T>
 void list<T>::unlink_nodes(base_ptr first, base_ptr last) {
-    first->prev->next = last->next;
-    last->next->prev = first->prev;
+    MoperSTL::list_unlink_nodes(first, last);
 }
 
 //  n ԪΪֵ
@@ -1020,6 +1136,47 @@ list<T>::list_sort(iterator f1, iterator l2, size_type n, Compared comp) {
     return result;
 }
 
+// нڵָռʱȶ˳
+// ڵ㱾ƶ˵Чʧʱ false
+// 벿Ϊ鲢ĸռ䣬 holder Уcomp ׳쳣ʱճ黹
+// ǰδ޸ģԱԭ˳
+template <class T>
+template <class Compared>
+bool list<T>::buffer_sort(Compared comp) {
+    struct buffer_holder {
+        MoperSTL::pair<base_ptr*, std::ptrdiff_t> buffer;
+        ~buffer_holder() {
+            if (buffer.first != nullptr)
+                MoperSTL::return_temporary_buffer(buffer.first);
+        }
+    };
+    const std::ptrdiff_t len = static_cast<std::ptrdiff_t>(size_);
+    const std::ptrdiff_t half = (len + 1) / 2;
+    buffer_holder holder{ MoperSTL::get_temporary_buffer<base_ptr>(len + half) };
+    if (holder.buffer.first == nullptr || holder.buffer.second < len + half)
+        return false;
+
+    base_ptr* nodes = holder.buffer.first;
+    size_type n = 0;
+    for (auto cur = node_->next; cur != node_; cur = cur->next)
+        nodes[n++] = cur;
+
+    MoperSTL::__stable_sort_adaptive(nodes, nodes + n, nodes + n, half, [&comp](base_ptr a, base_ptr b) {
+        return comp(a->as_node()->value, b->as_node()->value);
+    });
+
+    // 
+    auto prev = node_;
+    for (size_type i = 0; i < n; ++i) {
+        prev->next = nodes[i];
+        nodes[i]->prev = prev;
+        prev = nodes[i];
+    }
+    prev->next = node_;
+    node_->prev = prev;
+    return true;
+}
+
 // رȽϲ
 template <class T>
 bool operator==(const list<T>& lhs, const list<T>& rhs) {
@@ -0,0 +1,398 @@
+#ifndef MOPER_STL_LOCKFREE_QUEUE_H
+#define MOPER_STL_LOCKFREE_QUEUE_H
+
+#include <atomic>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+#include "exceptdef.h"
+#include "utility.h"
+#include "circular_buffer.h"
+
+namespace MoperSTL {
+
+// дСڸ߸޸ĵݣα
+#ifndef MOPER_STL_CACHE_LINE_SIZE
+#define MOPER_STL_CACHE_LINE_SIZE 64
+#endif
+
+//  n  T ġжδʼռ
+// ڶ̼߳乲 memory_pool ̰߳ȫҲ֤룬ֱʹö operator new
+template <class T>
+T* __lf_allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T),
+        std::align_val_t(MOPER_STL_CACHE_LINE_SIZE)));
+}
+
+template <class T>
+void __lf_deallocate(T* ptr) {
+    ::operator delete(static_cast<void*>(ptr), std::align_val_t(MOPER_STL_CACHE_LINE_SIZE));
+}
+
+// ģ spsc_queue
+// нУһ߳һ߳ͬʱ
+// head_ ֻдtail_ ֻд߾Ϊδȡģ߼±ꣻ
+// ˫ԻԷ±ֻ꣬ڻֵգʱ¶ȡԷԭӱ
+template <class T>
+class spsc_queue {
+public:
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+
+private:
+    // ֻ
+    alignas(MOPER_STL_CACHE_LINE_SIZE) T* buf_;  // 
+    size_type                            mask_; //  - 1
+
+    // 
+    alignas(MOPER_STL_CACHE_LINE_SIZE) std::atomic<size_type> head_;
+    size_type                                               cached_tail_;
+
+    // 
+    alignas(MOPER_STL_CACHE_LINE_SIZE) std::atomic<size_type> tail_;
+    size_type                                               cached_head_;
+
+public:
+    // 졢ȡΪ 2 
+
+    explicit spsc_queue(size_type n)
+        :head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+        THROW_LENGTH_ERROR_IF(n > static_cast<size_type>(-1) / 2 / sizeof(T),
+                              "spsc_queue<T>'s size too big");
+        const size_type cap = MoperSTL::__cb_round_up_pow2(n);
+        buf_ = MoperSTL::__lf_allocate<T>(cap);
+        mask_ = cap - 1;
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() {
+        if (!std::is_trivially_destructible<T>::value) {
+            const size_type t = tail_.load(std::memory_order_relaxed);
+            for (size_type h = head_.load(std::memory_order_relaxed); h != t; ++h)
+                buf_[h & mask_].~T();
+        }
+        MoperSTL::__lf_deallocate(buf_);
+    }
+
+public:
+    // زsize  empty ڲֻǽֵ
+
+    size_type capacity() const noexcept { return mask_ + 1; }
+    size_type size() const noexcept {
+        // ȶ head_ ٶ tail_tail_ ֻ t Сǰ h
+        const size_type h = head_.load(std::memory_order_acquire);
+        const size_type t = tail_.load(std::memory_order_acquire);
+        return t > h ? t - h : 0;
+    }
+    bool      empty() const noexcept { return size() == 0; }
+
+    // ߲ʱ false
+
+    template <class ...Args>
+    bool try_emplace(Args&& ...args);
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+    bool try_push(value_type&& value)      { return try_emplace(MoperSTL::move(value)); }
+
+    // д [first, first + n) оܶԪأֻһ tail_дĸ
+    template <class Iter>
+    size_type push_n(Iter first, size_type n);
+
+    // ߲Ϊʱ false
+
+    bool try_pop(value_type& out);
+
+    //  n Ԫд outֻһ head_صĸ
+    template <class OIter>
+    size_type pop_n(OIter out, size_type n);
+
+private:
+    // helper functions
+
+    size_type free_slots(size_type t);
+    size_type ready_slots(size_type h);
+};
+
+/*****************************************************************************************/
+
+// ӽµĿвλ
+template <class T>
+typename spsc_queue<T>::size_type spsc_queue<T>::free_slots(size_type t) {
+    size_type free = capacity() - (t - cached_head_);
+    if (free == 0) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        free = capacity() - (t - cached_head_);
+    }
+    return free;
+}
+
+// ӽµĿɶԪ
+template <class T>
+typename spsc_queue<T>::size_type spsc_queue<T>::ready_slots(size_type h) {
+    size_type ready = cached_tail_ - h;
+    if (ready == 0) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        ready = cached_tail_ - h;
+    }
+    return ready;
+}
+
+template <class T>
+template <class ...Args>
+bool spsc_queue<T>::try_emplace(Args&& ...args) {
+    const size_type t = tail_.load(std::memory_order_relaxed);
+    if (free_slots(t) == 0)
+        return false;
+    ::new (static_cast<void*>(buf_ + (t & mask_))) T(MoperSTL::forward<Args>(args)...);
+    tail_.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+template <class Iter>
+typename spsc_queue<T>::size_type spsc_queue<T>::push_n(Iter first, size_type n) {
+    const size_type t = tail_.load(std::memory_order_relaxed);
+    size_type free = free_slots(t);
+    if (n > free) {
+        // ֵѹʱٶȡһ
+        cached_head_ = head_.load(std::memory_order_acquire);
+        free = capacity() - (t - cached_head_);
+        if (n > free)
+            n = free;
+    }
+    size_type i = 0;
+    try {
+        for (; i < n; ++i, ++first)
+            ::new (static_cast<void*>(buf_ + ((t + i) & mask_))) T(*first);
+    }
+    catch (...) {
+        // ѹԪȻ
+        tail_.store(t + i, std::memory_order_release);
+        throw;
+    }
+    tail_.store(t + n, std::memory_order_release);
+    return n;
+}
+
+template <class T>
+bool spsc_queue<T>::try_pop(value_type& out) {
+    const size_type h = head_.load(std::memory_order_relaxed);
+    if (ready_slots(h) == 0)
+        return false;
+    T* p = buf_ + (h & mask_);
+    out = MoperSTL::move(*p);
+    p->~T();
+    head_.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+template <class OIter>
+typename spsc_queue<T>::size_type spsc_queue<T>::pop_n(OIter out, size_type n) {
+    const size_type h = head_.load(std::memory_order_relaxed);
+    size_type ready = ready_slots(h);
+    if (n > ready) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        ready = cached_tail_ - h;
+        if (n > ready)
+            n = ready;
+    }
+    for (size_type i = 0; i < n; ++i, ++out) {
+        T* p = buf_ + ((h + i) & mask_);
+        *out = MoperSTL::move(*p);
+        p->~T();
+    }
+    head_.store(h + n, std::memory_order_release);
+    return n;
+}
+
+/*****************************************************************************************/
+
+// ģ mpmc_queue
+// нУ߳ͬʱ
+// ÿλһ seqseq == pos ʾòλɹ߼± pos д룬
+// seq == pos + 1 ʾд롢ɹ߼± pos ߶ȡȡ seq Ϊ pos + capacity һ
+// ߷ֱͨ enqueue_pos_ / dequeue_pos_  CAS ȡ±ꣻһ CAS ȡһ±
+template <class T>
+class mpmc_queue {
+public:
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+
+private:
+    struct slot {
+        std::atomic<size_type>                                     seq;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* value_ptr() noexcept { return reinterpret_cast<T*>(&storage); }
+    };
+
+    // ֻ
+    alignas(MOPER_STL_CACHE_LINE_SIZE) slot* slots_;
+    size_type                              mask_;
+
+    // ߹
+    alignas(MOPER_STL_CACHE_LINE_SIZE) std::atomic<size_type> enqueue_pos_;
+
+    // ߹
+    alignas(MOPER_STL_CACHE_LINE_SIZE) std::atomic<size_type> dequeue_pos_;
+
+public:
+    // 졢ȡΪ 2 ݣΪ 2
+
+    explicit mpmc_queue(size_type n)
+        :enqueue_pos_(0), dequeue_pos_(0) {
+        THROW_LENGTH_ERROR_IF(n > static_cast<size_type>(-1) / 2 / sizeof(slot),
+                              "mpmc_queue<T>'s size too big");
+        const size_type cap = MoperSTL::__cb_round_up_pow2(n < 2 ? 2 : n);
+        slots_ = MoperSTL::__lf_allocate<slot>(cap);
+        mask_ = cap - 1;
+        for (size_type i = 0; i < cap; ++i)
+            ::new (static_cast<void*>(&slots_[i].seq)) std::atomic<size_type>(i);
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue() {
+        if (!std::is_trivially_destructible<T>::value) {
+            const size_type t = enqueue_pos_.load(std::memory_order_relaxed);
+            for (size_type h = dequeue_pos_.load(std::memory_order_relaxed); h != t; ++h)
+                slots_[h & mask_].value_ptr()->~T();
+        }
+        MoperSTL::__lf_deallocate(slots_);
+    }
+
+public:
+    // زsize  empty ڲֻǽֵ
+
+    size_type capacity() const noexcept { return mask_ + 1; }
+    size_type size() const noexcept {
+        const size_type h = dequeue_pos_.load(std::memory_order_acquire);
+        const size_type t = enqueue_pos_.load(std::memory_order_acquire);
+        return t > h ? t - h : 0;
+    }
+    bool      empty() const noexcept { return size() == 0; }
+
+    // ߲ʱ false
+    // λһȡ޷黹ԪصĹ첻Ӧ׳쳣
+
+    template <class ...Args>
+    bool try_emplace(Args&& ...args);
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+    bool try_push(value_type&& value)      { return try_emplace(MoperSTL::move(value)); }
+
+    // һȡ n λд [first, first + n) ǰԪأдĸ
+    template <class Iter>
+    size_type push_n(Iter first, size_type n);
+
+    // ߲Ϊʱ false
+
+    bool try_pop(value_type& out);
+
+    // һȡ n дλƶ outصĸ
+    template <class OIter>
+    size_type pop_n(OIter out, size_type n);
+
+private:
+    // helper functions
+
+    size_type claim(std::atomic<size_type>& pos_ref, size_type n, size_type ready_offset, size_type& pos);
+};
+
+/*****************************************************************************************/
+
+template <class T>
+template <class ...Args>
+bool mpmc_queue<T>::try_emplace(Args&& ...args) {
+    size_type pos;
+    if (claim(enqueue_pos_, 1, 0, pos) == 0)
+        return false;
+    slot& s = slots_[pos & mask_];
+    ::new (static_cast<void*>(&s.storage)) T(MoperSTL::forward<Args>(args)...);
+    s.seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+template <class Iter>
+typename mpmc_queue<T>::size_type mpmc_queue<T>::push_n(Iter first, size_type n) {
+    size_type pos;
+    n = claim(enqueue_pos_, n, 0, pos);
+    for (size_type i = 0; i < n; ++i, ++first) {
+        slot& s = slots_[(pos + i) & mask_];
+        ::new (static_cast<void*>(&s.storage)) T(*first);
+        s.seq.store(pos + i + 1, std::memory_order_release);
+    }
+    return n;
+}
+
+template <class T>
+bool mpmc_queue<T>::try_pop(value_type& out) {
+    size_type pos;
+    if (claim(dequeue_pos_, 1, 1, pos) == 0)
+        return false;
+    slot& s = slots_[pos & mask_];
+    out = MoperSTL::move(*s.value_ptr());
+    s.value_ptr()->~T();
+    s.seq.store(pos + capacity(), std::memory_order_release);
+    return true;
+}
+
+template <class T>
+template <class OIter>
+typename mpmc_queue<T>::size_type mpmc_queue<T>::pop_n(OIter out, size_type n) {
+    size_type pos;
+    n = claim(dequeue_pos_, n, 1, pos);
+    for (size_type i = 0; i < n; ++i, ++out) {
+        slot& s = slots_[(pos + i) & mask_];
+        *out = MoperSTL::move(*s.value_ptr());
+        s.value_ptr()->~T();
+        s.seq.store(pos + i + capacity(), std::memory_order_release);
+    }
+    return n;
+}
+
+/*****************************************************************************************/
+// helper function
+
+//  pos_ref ȡ n ±꣬ʼ±д posȡĸΪ 0 ʾգ
+// λΪ seq == ± + ready_offsetΪ 0Ϊ 1
+// ѾĲλ±걻ȡǰᱻ߳޸ģ˿ȼһǰ׺һ CAS ȡ
+template <class T>
+typename mpmc_queue<T>::size_type
+mpmc_queue<T>::claim(std::atomic<size_type>& pos_ref, size_type n, size_type ready_offset, size_type& pos) {
+    if (n == 0)
+        return 0;
+    pos = pos_ref.load(std::memory_order_relaxed);
+    for (;;) {
+        const size_type seq = slots_[pos & mask_].seq.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + ready_offset));
+        if (diff == 0) {
+            size_type k = 1;
+            while (k < n && slots_[(pos + k) & mask_].seq.load(std::memory_order_acquire)
+                   == pos + k + ready_offset)
+                ++k;
+            if (pos_ref.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                return k;
+            // CAS ʧʱ pos ѸΪֵ
+        }
+        else if (diff < 0) {
+            return 0;
+        }
+        else {
+            pos = pos_ref.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_LOCKFREE_QUEUE_H */
@@ -6,9 +6,14 @@
 
 namespace MoperSTL {
 
+// forward declaration
+template <class Key, class T, class Compare, bool OrderStatistic>
+class multimap;
+
 // ģ mapֵظ
-// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::less
-template <class Key, class T, class Compare = MoperSTL::less<Key>>
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::less
+// Ϊ true ʱṩ nthrank  O(log n) ˳ͳƲ
+template <class Key, class T, class Compare = MoperSTL::less<Key>, bool OrderStatistic = false>
 class map {
 public:
   // map Ƕͱ
@@ -19,7 +24,7 @@ public:
 
     // һ functorԪرȽ
     class value_compare : public binary_function <value_type, value_type, bool> {
-        friend class map<Key, T, Compare>;
+        friend class map<Key, T, Compare, OrderStatistic>;
     private:
         Compare comp;
         value_compare(Compare c) : comp(c) {}
@@ -31,12 +36,16 @@ public:
 
 private:
   //  MoperSTL::rb_tree Ϊײ
-    typedef MoperSTL::rb_tree<value_type, key_compare>  base_type;
+    typedef MoperSTL::rb_tree<value_type, key_compare, OrderStatistic>  base_type;
     base_type tree_;
 
+    // merge Ҫͬĵײ rb_tree
+    template <class, class, class, bool> friend class map;
+    template <class, class, class, bool> friend class multimap;
+
 public:
   // ʹ rb_tree ͱ
-    typedef typename base_type::node_type              node_type;
+    typedef typename base_type::node_handle_type       node_type;
     typedef typename base_type::pointer                pointer;
     typedef typename base_type::const_pointer          const_pointer;
     typedef typename base_type::reference              reference;
@@ -47,6 +56,7 @@ public:
     typedef typename base_type::const_reverse_iterator const_reverse_iterator;
     typedef typename base_type::size_type              size_type;
     typedef typename base_type::difference_type        difference_type;
+    typedef node_insert_return<iterator, node_type>    insert_return_type;
     typedef typename base_type::allocator_type         allocator_type;
 
 public:
@@ -59,6 +69,12 @@ public:
         :tree_() {
         tree_.insert_unique(first, last);
     }
+    // 乹죬Ƚϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    map(from_sorted_range_t, InputIterator first, InputIterator last)
+        :tree_() {
+        tree_.assign_sorted(first, last);
+    }
 
     map(std::initializer_list<value_type> ilist)
         :tree_() {
@@ -201,12 +217,49 @@ public:
         tree_.insert_unique(first, last);
     }
 
+    // ڵеĽڵ㣬ڴ棻ֵѴʱڵڷֵ node 
+    insert_return_type insert(node_type&& nh) {
+        auto res = tree_.insert_unique(MoperSTL::move(nh));
+        return insert_return_type{ res.first, res.second, MoperSTL::move(nh) };
+    }
+    iterator insert(iterator hint, node_type&& nh) {
+        return tree_.insert_unique(hint, MoperSTL::move(nh));
+    }
+
     void      erase(iterator position) { tree_.erase(position); }
     size_type erase(const key_type& key) { return tree_.erase_unique(key); }
     void      erase(iterator first, iterator last) { tree_.erase(first, last); }
 
     void      clear() { tree_.clear(); }
 
+    // ժԪڵĽڵ㽻ڵͷڴ
+    node_type extract(iterator position) { return tree_.extract(position); }
+    node_type extract(const key_type& key) { return tree_.extract(key); }
+
+    //  src Ľڵ뱾Ԫءڴ棻ֵѴڵԪ src 
+    template <class C2>
+    void merge(map<Key, T, C2, OrderStatistic>& src) { tree_.merge_unique(src.tree_); }
+    template <class C2>
+    void merge(map<Key, T, C2, OrderStatistic>&& src) { tree_.merge_unique(src.tree_); }
+    template <class C2>
+    void merge(multimap<Key, T, C2, OrderStatistic>& src) { tree_.merge_unique(src.tree_); }
+    template <class C2>
+    void merge(multimap<Key, T, C2, OrderStatistic>&& src) { tree_.merge_unique(src.tree_); }
+
+    // ƴָֻ޸ָ룬Ԫ
+    // joinrhs Ԫر붼ڱԪ֮ǰrhs ΪգO(log n)
+    void join(map& rhs) { tree_.join(rhs.tree_); }
+    // splitֵС key Ԫ rightOrderStatistic Ϊ true ʱ O(log n)
+    // ڵ㲻¼СҪһԪأΪ O(log n + min(k, n - k))k ΪµԪظ
+    void split(const key_type& key, map& right) { tree_.split(key, right.tree_); }
+
+    // 㣬O(m log(n/m + 1))mn ΪнСϴԪظ
+    // union_with  other ȫڵ㣬ֵѴʱԪ
+    void union_with(map& other) { tree_.union_unique(other.tree_); }
+    void union_with(map&& other) { tree_.union_unique(other.tree_); }
+    void intersection_with(const map& other) { tree_.intersection_unique(other.tree_); }
+    void difference_with(const map& other) { tree_.difference_unique(other.tree_); }
+
     // map ز
 
     iterator       find(const key_type& key) { return tree_.find(key); }
@@ -230,6 +283,54 @@ public:
         return tree_.equal_range_unique(key);
     }
 
+    // 칹ң key_compare  is_transparent ʱã less<void>
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       find(const K& key)       { return tree_.find(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key) const { return tree_.find(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count(const K& key) const { return tree_.count_unique(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       lower_bound(const K& key)       { return tree_.lower_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return tree_.lower_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       upper_bound(const K& key)       { return tree_.upper_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return tree_.upper_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<iterator, iterator>
+        equal_range(const K& key) {
+        return tree_.equal_range_unique(key);
+    }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<const_iterator, const_iterator>
+        equal_range(const K& key) const {
+        return tree_.equal_range_unique(key);
+    }
+
+    // ˳ͳƲ OrderStatistic Ϊ true ʱãʱ临ӶȾΪ O(log n)
+
+    iterator        nth(size_type k) { return tree_.nth(k); }
+    const_iterator  nth(size_type k)                                  const { return tree_.nth(k); }
+    size_type       rank(const key_type& key)                         const { return tree_.rank(key); }
+    size_type       index_of(const_iterator it)                       const { return tree_.index_of(it); }
+    size_type       count_range(const key_type& low, const key_type& high) const {
+        return tree_.count_range(low, high);
+    }
+    difference_type distance(const_iterator first, const_iterator last) const {
+        return tree_.distance(first, last);
+    }
+
     void           swap(map& rhs) noexcept {
         tree_.swap(rhs.tree_);
     }
@@ -240,47 +341,48 @@ public:
 };
 
 // رȽϲ
-template <class Key, class T, class Compare>
-bool operator==(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator==(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator<(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator!=(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator>(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator<=(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator>=(const map<Key, T, Compare, OrderStatistic>& lhs, const map<Key, T, Compare, OrderStatistic>& rhs) {
     return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <class Key, class T, class Compare>
-void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept {
+template <class Key, class T, class Compare, bool OrderStatistic>
+void swap(map<Key, T, Compare, OrderStatistic>& lhs, map<Key, T, Compare, OrderStatistic>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 /*****************************************************************************************/
 
 // ģ multimapֵظ
-// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::less
-template <class Key, class T, class Compare = MoperSTL::less<Key>>
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::less
+// Ϊ true ʱṩ nthrank  O(log n) ˳ͳƲ
+template <class Key, class T, class Compare = MoperSTL::less<Key>, bool OrderStatistic = false>
 class multimap {
 public:
   // multimap ͱ
@@ -291,7 +393,7 @@ public:
 
     // һ functorԪرȽ
     class value_compare : public binary_function <value_type, value_type, bool> {
-        friend class multimap<Key, T, Compare>;
+        friend class multimap<Key, T, Compare, OrderStatistic>;
     private:
         Compare comp;
         value_compare(Compare c) : comp(c) {}
@@ -303,12 +405,16 @@ public:
 
 private:
   //  MoperSTL::rb_tree Ϊײ
-    typedef MoperSTL::rb_tree<value_type, key_compare>  base_type;
+    typedef MoperSTL::rb_tree<value_type, key_compare, OrderStatistic>  base_type;
     base_type tree_;
 
+    // merge Ҫͬĵײ rb_tree
+    template <class, class, class, bool> friend class map;
+    template <class, class, class, bool> friend class multimap;
+
 public:
   // ʹ rb_tree ͱ
-    typedef typename base_type::node_type              node_type;
+    typedef typename base_type::node_handle_type       node_type;
     typedef typename base_type::pointer                pointer;
     typedef typename base_type::const_pointer          const_pointer;
     typedef typename base_type::reference              reference;
@@ -331,6 +437,12 @@ public:
         :tree_() {
         tree_.insert_multi(first, last);
     }
+    // 乹죬Ƚϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    multimap(from_sorted_range_t, InputIterator first, InputIterator last)
+        :tree_() {
+        tree_.assign_sorted(first, last);
+    }
     multimap(std::initializer_list<value_type> ilist)
         :tree_() {
         tree_.insert_multi(ilist.begin(), ilist.end());
@@ -439,12 +551,41 @@ public:
         tree_.insert_multi(first, last);
     }
 
+    // ڵеĽڵ㣬ڴ
+    iterator insert(node_type&& nh) {
+        return tree_.insert_multi(MoperSTL::move(nh));
+    }
+    iterator insert(iterator hint, node_type&& nh) {
+        return tree_.insert_multi(hint, MoperSTL::move(nh));
+    }
+
     void           erase(iterator position) { tree_.erase(position); }
     size_type      erase(const key_type& key) { return tree_.erase_multi(key); }
     void           erase(iterator first, iterator last) { tree_.erase(first, last); }
 
     void           clear() { tree_.clear(); }
 
+    // ժԪڵĽڵ㽻ڵͷڴ
+    node_type extract(iterator position) { return tree_.extract(position); }
+    node_type extract(const key_type& key) { return tree_.extract(key); }
+
+    //  src Ľڵ뱾Ԫءڴ
+    template <class C2>
+    void merge(map<Key, T, C2, OrderStatistic>& src) { tree_.merge_multi(src.tree_); }
+    template <class C2>
+    void merge(map<Key, T, C2, OrderStatistic>&& src) { tree_.merge_multi(src.tree_); }
+    template <class C2>
+    void merge(multimap<Key, T, C2, OrderStatistic>& src) { tree_.merge_multi(src.tree_); }
+    template <class C2>
+    void merge(multimap<Key, T, C2, OrderStatistic>&& src) { tree_.merge_multi(src.tree_); }
+
+    // ƴָֻ޸ָ룬Ԫ
+    // joinrhs Ԫر붼ڱԪ֮ǰrhs ΪգO(log n)
+    void join(multimap& rhs) { tree_.join(rhs.tree_); }
+    // splitֵС key Ԫ rightOrderStatistic Ϊ true ʱ O(log n)
+    // ڵ㲻¼СҪһԪأΪ O(log n + min(k, n - k))k ΪµԪظ
+    void split(const key_type& key, multimap& right) { tree_.split(key, right.tree_); }
+
     // multimap ز
 
     iterator       find(const key_type& key) { return tree_.find(key); }
@@ -468,6 +609,54 @@ public:
         return tree_.equal_range_multi(key);
     }
 
+    // 칹ң key_compare  is_transparent ʱã less<void>
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       find(const K& key)       { return tree_.find(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key) const { return tree_.find(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count(const K& key) const { return tree_.count_multi(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       lower_bound(const K& key)       { return tree_.lower_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return tree_.lower_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    iterator       upper_bound(const K& key)       { return tree_.upper_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return tree_.upper_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<iterator, iterator>
+        equal_range(const K& key) {
+        return tree_.equal_range_multi(key);
+    }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<const_iterator, const_iterator>
+        equal_range(const K& key) const {
+        return tree_.equal_range_multi(key);
+    }
+
+    // ˳ͳƲ OrderStatistic Ϊ true ʱãʱ临ӶȾΪ O(log n)
+
+    iterator        nth(size_type k) { return tree_.nth(k); }
+    const_iterator  nth(size_type k)                                  const { return tree_.nth(k); }
+    size_type       rank(const key_type& key)                         const { return tree_.rank(key); }
+    size_type       index_of(const_iterator it)                       const { return tree_.index_of(it); }
+    size_type       count_range(const key_type& low, const key_type& high) const {
+        return tree_.count_range(low, high);
+    }
+    difference_type distance(const_iterator first, const_iterator last) const {
+        return tree_.distance(first, last);
+    }
+
     void swap(multimap& rhs) noexcept {
         tree_.swap(rhs.tree_);
     }
@@ -478,39 +667,39 @@ public:
 };
 
 // رȽϲ
-template <class Key, class T, class Compare>
-bool operator==(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator==(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator<(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator!=(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator>(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator<=(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, bool OrderStatistic>
+bool operator>=(const multimap<Key, T, Compare, OrderStatistic>& lhs, const multimap<Key, T, Compare, OrderStatistic>& rhs) {
     return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <class Key, class T, class Compare>
-void swap(multimap<Key, T, Compare>& lhs, multimap<Key, T, Compare>& rhs) noexcept {
+template <class Key, class T, class Compare, bool OrderStatistic>
+void swap(multimap<Key, T, Compare, OrderStatistic>& lhs, multimap<Key, T, Compare, OrderStatistic>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
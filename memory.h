@@ -454,6 +454,18 @@ struct allocator {
 		memory_pool.deallocate(static_cast<void*>(ptr), sizeof(T) * n);
 	}
 
+	/* deallocate_chain()
+	 *
+	 * @brief һԽһ allocate(n) õĴ洢
+	 * @param first һ洢ÿ洢ʼ뱣ָһ洢ָ
+	 * @param last һ洢
+	 * @param n ڶԭЩ洢 allocate() õײ
+	 */
+	void deallocate_chain(T* first, T* last, std::size_t n) {
+		if (n == 0) return;
+		memory_pool.deallocate_chain(static_cast<void*>(first), static_cast<void*>(last), sizeof(T) * n);
+	}
+
 	/* construct()
 	 *
 	 * @brief  p ָδʼ洢й
@@ -30,6 +30,7 @@ private: // 
 	using data_address = unsigned char*; // ڱʾַһҪʹunsigned charֻҪСΪ1Bͼɣ
 	static const std::size_t INITIAL_SIZE = 8; // FreeSpaceеһFreeSpaceHeadersize
 	static const std::size_t ALIGN_SIZE = 4; // FreeSpaceFreeSpceHeader֮sizeĲֵ
+	static const std::size_t MAX_POOLED_SIZE = 4096; // ôСֱͨmalloc()free()ɣFreeSpace
 private: // Ա 
 	// Block
 	BlockHeader* current_block; // ָǰBlockںʵ
@@ -144,6 +145,13 @@ public: // 
 	 * @return ظδʼ洢ռ׵ַ
 	 */
 	void* allocate(std::size_t n) {
+		// 洢vectorhashtablebucket飩FreeSpaceHeaderּҪn / ALIGN_SIZEͷ
+		if (n > MAX_POOLED_SIZE) {
+			void* p = std::malloc(n);
+			if (p == NULL) throw __memory_error::CREATE_MEMORY_ERROR;
+			return p;
+		}
+
 		ExtendFreeSpaceHeaders(n);
 
 		FreeSpaceHeader* header = FindFreeSpaceHeader(n);
@@ -164,12 +172,42 @@ public: // 
 	 * ע⣺߱Ƿȷ˱֤ڴ氲ȫûԼ
 	 */
 	void deallocate(void* p, std::size_t n) {
+		if (n > MAX_POOLED_SIZE) {
+			std::free(p);
+			return;
+		}
+
 		FreeSpaceHeader* header = free_space_head;
 		while (header->size < n) header = header->next_header;
 
 		reinterpret_cast<FreeSpace*>(p)->next_free = header->next_free;
 		header->next_free = reinterpret_cast<FreeSpace*>(p);
 	}
+
+	/* deallocate_chain()
+	 *
+	 * @brief һԽһСΪ n Ĵ洢ռ
+	 * @param first һ洢ռ䣬ÿ洢ռʼ뱣ָһָ
+	 * @param last һ洢ռ䣬ʼָ뽫
+	 * ע⣺ deallocate() ֻͬһ FreeSpaceHeader
+	 */
+	void deallocate_chain(void* first, void* last, std::size_t n) {
+		if (n > MAX_POOLED_SIZE) {
+			for (void* p = first; p != last;) {
+				void* next = reinterpret_cast<FreeSpace*>(p)->next_free;
+				std::free(p);
+				p = next;
+			}
+			std::free(last);
+			return;
+		}
+
+		FreeSpaceHeader* header = free_space_head;
+		while (header->size < n) header = header->next_header;
+
+		reinterpret_cast<FreeSpace*>(last)->next_free = header->next_free;
+		header->next_free = reinterpret_cast<FreeSpace*>(first);
+	}
 };
 
 /* memory_pool
@@ -0,0 +1,618 @@
+#ifndef MOPER_STL_PERSISTENT_MAP_H
+#define MOPER_STL_PERSISTENT_MAP_H
+
+// ͷļģ persistent_mapһɱ䣨־ûӳ
+// ײΪ AVL ÿθֻƴӸ޸λõһ·path copyingһ°汾
+// ڵ¾ɰ汾һθµʱռ䶼 O(log n)һ汾գ O(1)
+// ڵԭӵüٸڵ persistent_map УʱԪأ
+// ͨ MoperSTL::allocator ͷŽڵ
+// Ѿɵİ汾Զٱ޸ģͬһ汾ڶ߳ͬʱȡ
+//  MoperSTL::allocator ײ memory_pool ̰߳ȫģ°汾ԼͷŽڵ븳ֵ
+// Ҫ֮߳以
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+
+#include "algorithm.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "utility.h"
+#include "exceptdef.h"
+
+namespace MoperSTL {
+
+// persistent_map Ľڵ
+// ڵһϵĳ߹Ͳ޸ģֻüΪ 1 Ľڵ㣨θ½Ľڵ㣩Żᱻԭظд
+template <class T>
+struct persistent_map_node {
+    std::atomic<std::size_t> refs;   // ü
+    persistent_map_node*     left;
+    persistent_map_node*     right;
+    int                      height; // ԸýڵΪ߶ȣҶڵΪ 1
+    T                        value;
+};
+
+// persistent_map ĵֻܶȡԪ
+// ڵûиָ룬һ¼Ӹǰڵ··Ϊձʾ end()
+template <class T>
+struct persistent_map_iterator {
+    typedef MoperSTL::bidirectional_iterator_tag iterator_category;
+    typedef T                                    value_type;
+    typedef std::ptrdiff_t                       difference_type;
+    typedef const T*                             pointer;
+    typedef const T&                             reference;
+
+    typedef persistent_map_node<T>               node_type;
+    typedef persistent_map_iterator<T>           self;
+
+    // ڵ 2^64 ʱAVL ĸ߶С 1.44 * 64
+    static constexpr int max_height = 96;
+
+    const node_type* root;              // 汾ĸڵ㣬ڴ end() ǰƶ
+    const node_type* path[max_height];  // path[0] Ϊpath[depth - 1] Ϊǰڵ
+    int              depth;
+
+    persistent_map_iterator() :root(nullptr), depth(0) {}
+    explicit persistent_map_iterator(const node_type* r) :root(r), depth(0) {}
+
+    reference operator*()  const { return path[depth - 1]->value; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(depth > 0);
+        const node_type* x = path[depth - 1];
+        if (x->right != nullptr) {  // Сڵ
+            push_min(x->right);
+            return *this;
+        }
+        while (--depth > 0 && path[depth - 1]->right == x)  // ݵһص
+            x = path[depth - 1];
+        return *this;
+    }
+    self operator++(int) {
+        self tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() {
+        if (depth == 0) {  // end() ǰһΪڵ
+            push_max(root);
+            return *this;
+        }
+        const node_type* x = path[depth - 1];
+        if (x->left != nullptr) {  // ڵ
+            push_max(x->left);
+            return *this;
+        }
+        while (--depth > 0 && path[depth - 1]->left == x)  // ݵһص
+            x = path[depth - 1];
+        return *this;
+    }
+    self operator--(int) {
+        self tmp(*this);
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node() == rhs.node(); }
+    bool operator!=(const self& rhs) const { return node() != rhs.node(); }
+
+    const node_type* node() const { return depth == 0 ? nullptr : path[depth - 1]; }
+
+    void push_min(const node_type* x) {
+        for (; x != nullptr; x = x->left)
+            path[depth++] = x;
+    }
+    void push_max(const node_type* x) {
+        for (; x != nullptr; x = x->right)
+            path[depth++] = x;
+    }
+};
+
+// ģ persistent_mapֵظ
+// һֵͣʵֵֵͣıȽϷʽȱʡʹ MoperSTL::less
+// insert / insert_or_assign / erase ޸ *thisǷظº°汾
+//   auto v2 = v1.insert_or_assign(k, x);  // v1 䣬v2  v1 һ·ȫڵ
+template <class Key, class T, class Compare = MoperSTL::less<Key>>
+class persistent_map {
+public:
+  // persistent_map Ƕͱ
+    typedef Key                                         key_type;
+    typedef T                                           mapped_type;
+    typedef MoperSTL::pair<const Key, T>                value_type;
+    typedef Compare                                     key_compare;
+
+    typedef MoperSTL::allocator<value_type>             allocator_type;
+    typedef MoperSTL::allocator<value_type>             data_allocator;
+    typedef persistent_map_node<value_type>             node_type;
+    typedef MoperSTL::allocator<node_type>              node_allocator;
+
+    typedef const value_type*                           pointer;
+    typedef const value_type*                           const_pointer;
+    typedef const value_type&                           reference;
+    typedef const value_type&                           const_reference;
+    typedef persistent_map_iterator<value_type>         iterator;
+    typedef persistent_map_iterator<value_type>         const_iterator;
+    typedef MoperSTL::reverse_iterator<iterator>        reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>  const_reverse_iterator;
+    typedef std::size_t                                 size_type;
+    typedef std::ptrdiff_t                              difference_type;
+
+private:
+    typedef node_type* node_ptr;
+
+    node_ptr    root_;  // иڵһ
+    size_type   size_;
+    key_compare comp_;
+
+public:
+  // 졢ơƶֵ
+
+    persistent_map() noexcept :root_(nullptr), size_(0), comp_() {}
+
+    explicit persistent_map(const key_compare& comp)
+        :root_(nullptr), size_(0), comp_(comp) {}
+
+    template <class InputIterator>
+    persistent_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        :root_(nullptr), size_(0), comp_(comp) {
+        for (; first != last; ++first)
+            *this = insert(*first);
+    }
+    persistent_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        :root_(nullptr), size_(0), comp_(comp) {
+        for (auto& value : ilist)
+            *this = insert(value);
+    }
+
+    // ֻӸڵüO(1)
+    persistent_map(const persistent_map& rhs) noexcept
+        :root_(retain(rhs.root_)), size_(rhs.size_), comp_(rhs.comp_) {}
+    persistent_map(persistent_map&& rhs) noexcept
+        :root_(rhs.root_), size_(rhs.size_), comp_(rhs.comp_) {
+        rhs.root_ = nullptr;
+        rhs.size_ = 0;
+    }
+
+    persistent_map& operator=(const persistent_map& rhs) noexcept {
+        node_ptr old = root_;
+        root_ = retain(rhs.root_);  // ͷţԸֵʱǰ
+        size_ = rhs.size_;
+        comp_ = rhs.comp_;
+        release(old);
+        return *this;
+    }
+    persistent_map& operator=(persistent_map&& rhs) noexcept {
+        if (this != &rhs) {
+            release(root_);
+            root_ = rhs.root_;
+            size_ = rhs.size_;
+            comp_ = rhs.comp_;
+            rhs.root_ = nullptr;
+            rhs.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~persistent_map() { release(root_); }
+
+public:
+  // ؽӿ
+
+    key_compare    key_comp()      const { return comp_; }
+    allocator_type get_allocator() const { return allocator_type(); }
+
+    // 
+
+    const_iterator         begin()   const noexcept {
+        const_iterator it(root_);
+        it.push_min(root_);
+        return it;
+    }
+    const_iterator         end()     const noexcept { return const_iterator(root_); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 
+
+    bool      empty()    const noexcept { return size_ == 0; }
+    size_type size()     const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(node_type); }
+
+    // أֻȡڵ㣬޸ü
+
+    // ָʵֵָ룬ֵʱؿָ룻Ҫʺֻ·ϵĲ
+    const mapped_type* get(const key_type& key) const {
+        const node_type* x = find_node(key);
+        return x == nullptr ? nullptr : &x->value.second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        const node_type* x = find_node(key);
+        THROW_OUT_OF_RANGE_IF(x == nullptr, "persistent_map<Key, T> no such element exists");
+        return x->value.second;
+    }
+
+    size_type count(const key_type& key)    const { return find_node(key) != nullptr ? 1 : 0; }
+    bool      contains(const key_type& key) const { return find_node(key) != nullptr; }
+
+    const_iterator find(const key_type& key) const {
+        const_iterator it(root_);
+        for (const node_type* x = root_; x != nullptr;) {
+            it.path[it.depth++] = x;
+            if (comp_(key, x->value.first))
+                x = x->left;
+            else if (comp_(x->value.first, key))
+                x = x->right;
+            else
+                return it;
+        }
+        return end();
+    }
+
+    // һС key Ԫ
+    const_iterator lower_bound(const key_type& key) const {
+        const_iterator it(root_);
+        int keep = 0;  // ѡڵ·еȣ·ǰ׺Ǻѡڵ
+        for (const node_type* x = root_; x != nullptr;) {
+            it.path[it.depth++] = x;
+            if (!comp_(x->value.first, key)) {
+                keep = it.depth;
+                x = x->left;
+            } else {
+                x = x->right;
+            }
+        }
+        it.depth = keep;
+        return it;
+    }
+
+    // һ key Ԫ
+    const_iterator upper_bound(const key_type& key) const {
+        const_iterator it(root_);
+        int keep = 0;
+        for (const node_type* x = root_; x != nullptr;) {
+            it.path[it.depth++] = x;
+            if (comp_(key, x->value.first)) {
+                keep = it.depth;
+                x = x->left;
+            } else {
+                x = x->right;
+            }
+        }
+        it.depth = keep;
+        return it;
+    }
+
+    MoperSTL::pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const {
+        return MoperSTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    // أ°汾*this 
+
+    // ֵѴʱ *this ͬİ汾
+    persistent_map insert(const value_type& value) const {
+        return update<false>(value.first, value);
+    }
+    persistent_map insert(value_type&& value) const {
+        return update<false>(value.first, MoperSTL::move(value));
+    }
+
+    // ֵѴʱ obj 滻ʵֵ
+    template <class M>
+    persistent_map insert_or_assign(const key_type& key, M&& obj) const {
+        return update<true>(key, key, MoperSTL::forward<M>(obj));
+    }
+
+    // ֵʱ *this ͬİ汾
+    persistent_map erase(const key_type& key) const {
+        bool found = false;
+        node_ptr root = erase_node(root_, key, found);
+        if (!found)
+            return *this;
+        return persistent_map(root, size_ - 1, comp_);
+    }
+
+    // ֻѱΪհ汾汾Ӱ
+    void clear() noexcept {
+        release(root_);
+        root_ = nullptr;
+        size_ = 0;
+    }
+
+    void swap(persistent_map& rhs) noexcept {
+        MoperSTL::swap(root_, rhs.root_);
+        MoperSTL::swap(size_, rhs.size_);
+        MoperSTL::swap(comp_, rhs.comp_);
+    }
+
+    // Ƿͬһ汾ڵ㣩O(1)
+    bool same_version(const persistent_map& rhs) const noexcept { return root_ == rhs.root_; }
+
+public:
+    friend bool operator==(const persistent_map& lhs, const persistent_map& rhs) {
+        if (lhs.size_ != rhs.size_)
+            return false;
+        return lhs.root_ == rhs.root_ || MoperSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator<(const persistent_map& lhs, const persistent_map& rhs) {
+        return MoperSTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    // ӹܸڵһ
+    persistent_map(node_ptr root, size_type size, const key_compare& comp) noexcept
+        :root_(root), size_(size), comp_(comp) {}
+
+    // ü
+
+    static node_ptr retain(node_ptr x) noexcept {
+        if (x != nullptr)
+            x->refs.fetch_add(1, std::memory_order_relaxed);
+        return x;
+    }
+
+    // üʱٽڵ㲢ͷӽڵ
+    static void release(node_ptr x) noexcept {
+        while (x != nullptr && x->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            node_ptr next = x->left;
+            release(x->right);
+            data_allocator::destroy(MoperSTL::addressof(x->value));
+            node_allocator::deallocate(x);
+            x = next;
+        }
+    }
+
+    static bool unique(node_ptr x) noexcept {
+        return x->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    static int height(const node_type* x) noexcept { return x == nullptr ? 0 : x->height; }
+
+    static void fix_height(node_ptr x) noexcept {
+        const int hl = height(x->left), hr = height(x->right);
+        x->height = (hl > hr ? hl : hr) + 1;
+    }
+
+    // һüΪ 1 Ľڵ㣬ӹ l  r 
+    template <class ...Args>
+    static node_ptr create_node(node_ptr l, node_ptr r, Args&&... args) {
+        node_ptr tmp = node_allocator::allocate(1);
+        try {
+            data_allocator::construct(MoperSTL::addressof(tmp->value), MoperSTL::forward<Args>(args)...);
+        } catch (...) {
+            node_allocator::deallocate(tmp);
+            throw;
+        }
+        ::new (static_cast<void*>(MoperSTL::addressof(tmp->refs))) std::atomic<std::size_t>(1);
+        tmp->left = l;
+        tmp->right = r;
+        fix_height(tmp);
+        return tmp;
+    }
+
+    //  k Ԫءl  r Ϊһڵ㣬ӹ klr ã׳쳣ʱȫͷţ
+    // k ֻθ³ʱԭظд k Ԫ
+    static node_ptr rebuild(node_ptr k, node_ptr l, node_ptr r) {
+        if (unique(k)) {
+            node_ptr old_l = k->left, old_r = k->right;
+            k->left = l;
+            k->right = r;
+            fix_height(k);
+            release(old_l);
+            release(old_r);
+            return k;
+        }
+        node_ptr x;
+        try {
+            x = create_node(l, r, k->value);
+        } catch (...) {
+            release(l);
+            release(r);
+            release(k);
+            throw;
+        }
+        release(k);
+        return x;
+    }
+
+    // k  l Ϊµĸӹ klr 
+    static node_ptr rotate_right(node_ptr k, node_ptr l, node_ptr r) {
+        node_ptr ll = retain(l->left), lr = retain(l->right);
+        node_ptr nk;
+        try {
+            nk = rebuild(k, lr, r);
+        } catch (...) {
+            release(ll);
+            release(l);
+            throw;
+        }
+        return rebuild(l, ll, nk);
+    }
+
+    // k  r Ϊµĸӹ klr 
+    static node_ptr rotate_left(node_ptr k, node_ptr l, node_ptr r) {
+        node_ptr rl = retain(r->left), rr = retain(r->right);
+        node_ptr nk;
+        try {
+            nk = rebuild(k, l, rl);
+        } catch (...) {
+            release(rr);
+            release(r);
+            throw;
+        }
+        return rebuild(r, nk, rr);
+    }
+
+    //  k ԪӸ߶Ȳ 2  l  rҪʱתӹ klr 
+    static node_ptr balance(node_ptr k, node_ptr l, node_ptr r) {
+        const int hl = height(l), hr = height(r);
+        if (hl > hr + 1) {
+            if (height(l->left) < height(l->right)) {  // ȶ l 
+                try {
+                    l = rotate_left(l, retain(l->left), retain(l->right));
+                } catch (...) {
+                    release(k);
+                    release(r);
+                    throw;
+                }
+            }
+            return rotate_right(k, l, r);
+        }
+        if (hr > hl + 1) {
+            if (height(r->right) < height(r->left)) {  // ȶ r 
+                try {
+                    r = rotate_right(r, retain(r->left), retain(r->right));
+                } catch (...) {
+                    release(k);
+                    release(l);
+                    throw;
+                }
+            }
+            return rotate_left(k, l, r);
+        }
+        return rebuild(k, l, r);
+    }
+
+    const node_type* find_node(const key_type& key) const {
+        const node_type* x = root_;
+        while (x != nullptr) {
+            if (comp_(key, x->value.first))
+                x = x->left;
+            else if (comp_(x->value.first, key))
+                x = x->right;
+            else
+                return x;
+        }
+        return nullptr;
+    }
+
+    template <bool Assign, class ...Args>
+    persistent_map update(const key_type& key, Args&&... args) const {
+        bool inserted = false;
+        node_ptr root = insert_node<Assign>(root_, key, inserted, MoperSTL::forward<Args>(args)...);
+        if (root == nullptr)
+            return *this;
+        if (inserted)
+            THROW_LENGTH_ERROR_IF(size_ == max_size(), "persistent_map<Key, T>'s size too big");
+        return persistent_map(root, inserted ? size_ + 1 : size_, comp_);
+    }
+
+    //  t в keyt ֻȡһã
+    // ֵѴ Assign Ϊ false ʱؿָ룬ʾ
+    // Assign Ϊ true ʱ args ΪֵʵֵΪԪ
+    template <bool Assign, class ...Args>
+    node_ptr insert_node(node_ptr t, const key_type& key, bool& inserted, Args&&... args) const {
+        if (t == nullptr) {
+            inserted = true;
+            return create_node(nullptr, nullptr, MoperSTL::forward<Args>(args)...);
+        }
+        if (comp_(key, t->value.first)) {
+            node_ptr l = insert_node<Assign>(t->left, key, inserted, MoperSTL::forward<Args>(args)...);
+            if (l == nullptr)
+                return nullptr;
+            return balance(retain(t), l, retain(t->right));
+        }
+        if (comp_(t->value.first, key)) {
+            node_ptr r = insert_node<Assign>(t->right, key, inserted, MoperSTL::forward<Args>(args)...);
+            if (r == nullptr)
+                return nullptr;
+            return balance(retain(t), retain(t->left), r);
+        }
+        if (!Assign)
+            return nullptr;
+        // 滻ʵֵƸýڵ㣬
+        node_ptr l = retain(t->left), r = retain(t->right);
+        try {
+            return create_node(l, r, MoperSTL::forward<Args>(args)...);
+        } catch (...) {
+            release(l);
+            release(r);
+            throw;
+        }
+    }
+
+    //  t ɾ keyt ֻȡһãfound Ϊ false ʱֵ
+    node_ptr erase_node(node_ptr t, const key_type& key, bool& found) const {
+        if (t == nullptr) {
+            found = false;
+            return nullptr;
+        }
+        if (comp_(key, t->value.first)) {
+            node_ptr l = erase_node(t->left, key, found);
+            if (!found)
+                return nullptr;
+            return balance(retain(t), l, retain(t->right));
+        }
+        if (comp_(t->value.first, key)) {
+            node_ptr r = erase_node(t->right, key, found);
+            if (!found)
+                return nullptr;
+            return balance(retain(t), retain(t->left), r);
+        }
+        found = true;
+        if (t->left == nullptr)
+            return retain(t->right);
+        if (t->right == nullptr)
+            return retain(t->left);
+        // Сڵ t
+        node_ptr m = nullptr;
+        node_ptr r;
+        try {
+            r = erase_min(t->right, m);
+        } catch (...) {
+            release(m);
+            throw;
+        }
+        return balance(m, retain(t->left), r);
+    }
+
+    // ɾ t Сڵ㣬m иýڵһã
+    static node_ptr erase_min(node_ptr t, node_ptr& m) {
+        if (t->left == nullptr) {
+            m = retain(t);
+            return retain(t->right);
+        }
+        node_ptr l = erase_min(t->left, m);
+        return balance(retain(t), l, retain(t->right));
+    }
+};
+
+// رȽϲ
+template <class Key, class T, class Compare>
+bool operator!=(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare>
+bool operator<=(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>=(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  MoperSTL  swap
+template <class Key, class T, class Compare>
+void swap(persistent_map<Key, T, Compare>& lhs, persistent_map<Key, T, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_PERSISTENT_MAP_H */
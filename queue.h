@@ -2,6 +2,7 @@
 #define MOPER_STL_QUEUE_H
 
 #include "deque.h"
+#include "circular_buffer.h"
 #include "vector.h"
 #include "functional.h"
 #include "algorithm.h"
@@ -146,6 +147,12 @@ void swap(queue<T, Container>& lhs, queue<T, Container>& rhs) noexcept(noexcept(
     lhs.swap(rhs);
 }
 
+//  circular_buffer ΪײĶ
+// ̶Ϊ 2 ݣٷڴ棻queue::push ûзֵȱʡڶʱ׳ length_error
+// Ԫʽָ cb_overwrite
+template <class T, circular_buffer_policy Policy = circular_buffer_policy::cb_throw>
+using circular_queue = queue<T, MoperSTL::circular_buffer<T, Policy>>;
+
 /*****************************************************************************************/
 
 // ģ priority_queue
@@ -6,9 +6,14 @@
 
 namespace MoperSTL {
 
+// forward declaration
+template <class Key, class Compare, bool OrderStatistic>
+class multiset;
+
 // ģ setֵظ
-// һֵֵͣȽϷʽȱʡʹ MoperSTL::less 
-template <class Key, class Compare = MoperSTL::less<Key>>
+// һֵֵͣȽϷʽȱʡʹ MoperSTL::less
+// Ϊ true ʱṩ nthrank  O(log n) ˳ͳƲ
+template <class Key, class Compare = MoperSTL::less<Key>, bool OrderStatistic = false>
 class set {
 public:
     typedef Key        key_type;
@@ -18,12 +23,16 @@ public:
 
 private:
   //  MoperSTL::rb_tree Ϊײ
-    typedef MoperSTL::rb_tree<value_type, key_compare>  base_type;
+    typedef MoperSTL::rb_tree<value_type, key_compare, OrderStatistic>  base_type;
     base_type tree_;
 
+    // merge Ҫͬĵײ rb_tree
+    template <class, class, bool> friend class set;
+    template <class, class, bool> friend class multiset;
+
 public:
   // ʹ rb_tree ͱ
-    typedef typename base_type::node_type              node_type;
+    typedef typename base_type::node_handle_type       node_type;
     typedef typename base_type::const_pointer          pointer;
     typedef typename base_type::const_pointer          const_pointer;
     typedef typename base_type::const_reference        reference;
@@ -34,6 +43,7 @@ public:
     typedef typename base_type::const_reverse_iterator const_reverse_iterator;
     typedef typename base_type::size_type              size_type;
     typedef typename base_type::difference_type        difference_type;
+    typedef node_insert_return<iterator, node_type>    insert_return_type;
     typedef typename base_type::allocator_type         allocator_type;
 
 public:
@@ -45,6 +55,12 @@ public:
         :tree_() {
         tree_.insert_unique(first, last);
     }
+    // 乹죬Ƚϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    set(from_sorted_range_t, InputIterator first, InputIterator last)
+        :tree_() {
+        tree_.assign_sorted(first, last);
+    }
     set(std::initializer_list<value_type> ilist)
         :tree_() {
         tree_.insert_unique(ilist.begin(), ilist.end());
@@ -152,12 +168,49 @@ public:
         tree_.insert_unique(first, last);
     }
 
+    // ڵеĽڵ㣬ڴ棻ֵѴʱڵڷֵ node 
+    insert_return_type insert(node_type&& nh) {
+        auto res = tree_.insert_unique(MoperSTL::move(nh));
+        return insert_return_type{ res.first, res.second, MoperSTL::move(nh) };
+    }
+    iterator insert(iterator hint, node_type&& nh) {
+        return tree_.insert_unique(hint, MoperSTL::move(nh));
+    }
+
     void      erase(iterator position) { tree_.erase(position); }
     size_type erase(const key_type& key) { return tree_.erase_unique(key); }
     void      erase(iterator first, iterator last) { tree_.erase(first, last); }
 
     void      clear() { tree_.clear(); }
 
+    // ժԪڵĽڵ㽻ڵͷڴ
+    node_type extract(iterator position) { return tree_.extract(position); }
+    node_type extract(const key_type& key) { return tree_.extract(key); }
+
+    //  src Ľڵ뱾Ԫءڴ棻ֵѴڵԪ src 
+    template <class C2>
+    void merge(set<Key, C2, OrderStatistic>& src) { tree_.merge_unique(src.tree_); }
+    template <class C2>
+    void merge(set<Key, C2, OrderStatistic>&& src) { tree_.merge_unique(src.tree_); }
+    template <class C2>
+    void merge(multiset<Key, C2, OrderStatistic>& src) { tree_.merge_unique(src.tree_); }
+    template <class C2>
+    void merge(multiset<Key, C2, OrderStatistic>&& src) { tree_.merge_unique(src.tree_); }
+
+    // ƴָֻ޸ָ룬Ԫ
+    // joinrhs Ԫر붼ڱԪ֮ǰrhs ΪգO(log n)
+    void join(set& rhs) { tree_.join(rhs.tree_); }
+    // splitֵС key Ԫ rightOrderStatistic Ϊ true ʱ O(log n)
+    // ڵ㲻¼СҪһԪأΪ O(log n + min(k, n - k))k ΪµԪظ
+    void split(const key_type& key, set& right) { tree_.split(key, right.tree_); }
+
+    // 㣬O(m log(n/m + 1))mn ΪнСϴԪظ
+    // union_with  other ȫڵ㣬ֵѴʱԪ
+    void union_with(set& other) { tree_.union_unique(other.tree_); }
+    void union_with(set&& other) { tree_.union_unique(other.tree_); }
+    void intersection_with(const set& other) { tree_.intersection_unique(other.tree_); }
+    void difference_with(const set& other) { tree_.difference_unique(other.tree_); }
+
     // set ز
 
     iterator       find(const key_type& key) { return tree_.find(key); }
@@ -181,6 +234,39 @@ public:
         return tree_.equal_range_unique(key);
     }
 
+    // 칹ң key_compare  is_transparent ʱã less<void>
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key)        const { return tree_.find(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count(const K& key)       const { return tree_.count_unique(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return tree_.lower_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return tree_.upper_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<const_iterator, const_iterator>
+        equal_range(const K& key) const {
+        return tree_.equal_range_unique(key);
+    }
+
+    // ˳ͳƲ OrderStatistic Ϊ true ʱãʱ临ӶȾΪ O(log n)
+
+    iterator        nth(size_type k) { return tree_.nth(k); }
+    const_iterator  nth(size_type k)                                  const { return tree_.nth(k); }
+    size_type       rank(const key_type& key)                         const { return tree_.rank(key); }
+    size_type       index_of(const_iterator it)                       const { return tree_.index_of(it); }
+    size_type       count_range(const key_type& low, const key_type& high) const {
+        return tree_.count_range(low, high);
+    }
+    difference_type distance(const_iterator first, const_iterator last) const {
+        return tree_.distance(first, last);
+    }
+
     void swap(set& rhs) noexcept {
         tree_.swap(rhs.tree_);
     }
@@ -191,47 +277,48 @@ public:
 };
 
 // رȽϲ
-template <class Key, class Compare>
-bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator==(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class Compare>
-bool operator<(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator<(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class Compare>
-bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator!=(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class Compare>
-bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator>(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class Compare>
-bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator<=(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class Compare>
-bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator>=(const set<Key, Compare, OrderStatistic>& lhs, const set<Key, Compare, OrderStatistic>& rhs) {
     return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <class Key, class Compare>
-void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept {
+template <class Key, class Compare, bool OrderStatistic>
+void swap(set<Key, Compare, OrderStatistic>& lhs, set<Key, Compare, OrderStatistic>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 /*****************************************************************************************/
 
 // ģ multisetֵظ
-// һֵֵͣȽϷʽȱʡʹ MoperSTL::less 
-template <class Key, class Compare = MoperSTL::less<Key>>
+// һֵֵͣȽϷʽȱʡʹ MoperSTL::less
+// Ϊ true ʱṩ nthrank  O(log n) ˳ͳƲ
+template <class Key, class Compare = MoperSTL::less<Key>, bool OrderStatistic = false>
 class multiset {
 public:
     typedef Key        key_type;
@@ -241,12 +328,16 @@ public:
 
 private:
   //  MoperSTL::rb_tree Ϊײ
-    typedef MoperSTL::rb_tree<value_type, key_compare>  base_type;
+    typedef MoperSTL::rb_tree<value_type, key_compare, OrderStatistic>  base_type;
     base_type tree_;  //  rb_tree  multiset
 
+    // merge Ҫͬĵײ rb_tree
+    template <class, class, bool> friend class set;
+    template <class, class, bool> friend class multiset;
+
 public:
   // ʹ rb_tree ͱ
-    typedef typename base_type::node_type              node_type;
+    typedef typename base_type::node_handle_type       node_type;
     typedef typename base_type::const_pointer          pointer;
     typedef typename base_type::const_pointer          const_pointer;
     typedef typename base_type::const_reference        reference;
@@ -268,6 +359,12 @@ public:
         :tree_() {
         tree_.insert_multi(first, last);
     }
+    // 乹죬Ƚϣʱ临Ӷ O(n)
+    template <class InputIterator>
+    multiset(from_sorted_range_t, InputIterator first, InputIterator last)
+        :tree_() {
+        tree_.assign_sorted(first, last);
+    }
     multiset(std::initializer_list<value_type> ilist)
         :tree_() {
         tree_.insert_multi(ilist.begin(), ilist.end());
@@ -375,12 +472,41 @@ public:
         tree_.insert_multi(first, last);
     }
 
+    // ڵеĽڵ㣬ڴ
+    iterator insert(node_type&& nh) {
+        return tree_.insert_multi(MoperSTL::move(nh));
+    }
+    iterator insert(iterator hint, node_type&& nh) {
+        return tree_.insert_multi(hint, MoperSTL::move(nh));
+    }
+
     void           erase(iterator position) { tree_.erase(position); }
     size_type      erase(const key_type& key) { return tree_.erase_multi(key); }
     void           erase(iterator first, iterator last) { tree_.erase(first, last); }
 
     void           clear() { tree_.clear(); }
 
+    // ժԪڵĽڵ㽻ڵͷڴ
+    node_type extract(iterator position) { return tree_.extract(position); }
+    node_type extract(const key_type& key) { return tree_.extract(key); }
+
+    //  src Ľڵ뱾Ԫءڴ
+    template <class C2>
+    void merge(set<Key, C2, OrderStatistic>& src) { tree_.merge_multi(src.tree_); }
+    template <class C2>
+    void merge(set<Key, C2, OrderStatistic>&& src) { tree_.merge_multi(src.tree_); }
+    template <class C2>
+    void merge(multiset<Key, C2, OrderStatistic>& src) { tree_.merge_multi(src.tree_); }
+    template <class C2>
+    void merge(multiset<Key, C2, OrderStatistic>&& src) { tree_.merge_multi(src.tree_); }
+
+    // ƴָֻ޸ָ룬Ԫ
+    // joinrhs Ԫر붼ڱԪ֮ǰrhs ΪգO(log n)
+    void join(multiset& rhs) { tree_.join(rhs.tree_); }
+    // splitֵС key Ԫ rightOrderStatistic Ϊ true ʱ O(log n)
+    // ڵ㲻¼СҪһԪأΪ O(log n + min(k, n - k))k ΪµԪظ
+    void split(const key_type& key, multiset& right) { tree_.split(key, right.tree_); }
+
     // multiset ز
 
     iterator       find(const key_type& key) { return tree_.find(key); }
@@ -404,6 +530,39 @@ public:
         return tree_.equal_range_multi(key);
     }
 
+    // 칹ң key_compare  is_transparent ʱã less<void>
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K& key)        const { return tree_.find(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    size_type      count(const K& key)       const { return tree_.count_multi(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K& key) const { return tree_.lower_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K& key) const { return tree_.upper_bound(key); }
+    template <class K, class C = key_compare, typename std::enable_if<
+        MoperSTL::is_transparent<C>::value, int>::type = 0>
+    pair<const_iterator, const_iterator>
+        equal_range(const K& key) const {
+        return tree_.equal_range_multi(key);
+    }
+
+    // ˳ͳƲ OrderStatistic Ϊ true ʱãʱ临ӶȾΪ O(log n)
+
+    iterator        nth(size_type k) { return tree_.nth(k); }
+    const_iterator  nth(size_type k)                                  const { return tree_.nth(k); }
+    size_type       rank(const key_type& key)                         const { return tree_.rank(key); }
+    size_type       index_of(const_iterator it)                       const { return tree_.index_of(it); }
+    size_type       count_range(const key_type& low, const key_type& high) const {
+        return tree_.count_range(low, high);
+    }
+    difference_type distance(const_iterator first, const_iterator last) const {
+        return tree_.distance(first, last);
+    }
+
     void swap(multiset& rhs) noexcept {
         tree_.swap(rhs.tree_);
     }
@@ -414,39 +573,39 @@ public:
 };
 
 // رȽϲ
-template <class Key, class Compare>
-bool operator==(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator==(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class Compare>
-bool operator<(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator<(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class Compare>
-bool operator!=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator!=(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class Compare>
-bool operator>(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator>(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class Compare>
-bool operator<=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator<=(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class Compare>
-bool operator>=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, bool OrderStatistic>
+bool operator>=(const multiset<Key, Compare, OrderStatistic>& lhs, const multiset<Key, Compare, OrderStatistic>& rhs) {
     return !(lhs < rhs);
 }
 
 //  mystl  swap
-template <class Key, class Compare>
-void swap(multiset<Key, Compare>& lhs, multiset<Key, Compare>& rhs) noexcept {
+template <class Key, class Compare, bool OrderStatistic>
+void swap(multiset<Key, Compare, OrderStatistic>& lhs, multiset<Key, Compare, OrderStatistic>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
@@ -32,6 +32,20 @@ struct is_iterator<_Iterator,
 	using reference = typename _Iterator::reference;
 };
 
+/* is_transparent<>
+ * 
+ * @brief 
+ * жϺǷ is_transparent 
+ * ˸͵ıȽϣֱӽֵͲͬĲݴṩ칹
+ * 
+ * ͨis_transparent<Func>::valueõжϽ
+ */
+template < typename _Func, typename = std::void_t<> >
+struct is_transparent : public std::false_type {};
+
+template <typename _Func>
+struct is_transparent<_Func, std::void_t<typename _Func::is_transparent>> : std::true_type {};
+
 
 
 }; /* MoperSTL */
@@ -5,6 +5,10 @@
 
 namespace MoperSTL {
 
+// forward declaration
+template <class Key, class T, class Hash, class KeyEqual>
+class unordered_multimap;
+
 // ģ unordered_mapֵظ
 // һֵͣʵֵͣϣȱʡʹ MoperSTL::hash
 // ĴֵȽϷʽȱʡʹ MoperSTL::equal_to
@@ -15,6 +19,10 @@ private:
     typedef hashtable<MoperSTL::pair<const Key, T>, Hash, KeyEqual> base_type;
     base_type ht_;
 
+    // merge Ҫͬĵײ hashtable
+    template <class, class, class, class> friend class unordered_map;
+    template <class, class, class, class> friend class unordered_multimap;
+
 public:
   // ʹ hashtable ͱ  
 
@@ -37,6 +45,9 @@ public:
     typedef typename base_type::local_iterator       local_iterator;
     typedef typename base_type::const_local_iterator const_local_iterator;
 
+    typedef typename base_type::node_handle_type     node_type;
+    typedef node_insert_return<iterator, node_type> insert_return_type;
+
     allocator_type get_allocator() const { return ht_.get_allocator(); }
 
 public:
@@ -156,6 +167,15 @@ public:
         ht_.insert_unique(first, last);
     }
 
+    // ڵеĽڵ㣬ڵ㣻ֵѴʱڵڷֵ node 
+    insert_return_type insert(node_type&& nh) {
+        auto res = ht_.insert_unique(MoperSTL::move(nh));
+        return insert_return_type{ res.first, res.second, MoperSTL::move(nh) };
+    }
+    iterator insert(const_iterator hint, node_type&& nh) {
+        return ht_.insert_unique_use_hint(hint, MoperSTL::move(nh));
+    }
+
 // erase / clear
 
     void      erase(iterator it) {
@@ -173,6 +193,32 @@ public:
         ht_.clear();
     }
 
+    // ժԪڵĽڵ㽻ڵͷŽڵ
+    node_type extract(const_iterator position) {
+        return ht_.extract(position);
+    }
+    node_type extract(const key_type& key) {
+        return ht_.extract(key);
+    }
+
+    //  src Ľڵ뱾Ԫءڵ㣻ֵѴڵԪ src 
+    template <class H2, class E2>
+    void merge(unordered_map<Key, T, H2, E2>& src) {
+        ht_.merge_unique(src.ht_);
+    }
+    template <class H2, class E2>
+    void merge(unordered_map<Key, T, H2, E2>&& src) {
+        ht_.merge_unique(src.ht_);
+    }
+    template <class H2, class E2>
+    void merge(unordered_multimap<Key, T, H2, E2>& src) {
+        ht_.merge_unique(src.ht_);
+    }
+    template <class H2, class E2>
+    void merge(unordered_multimap<Key, T, H2, E2>&& src) {
+        ht_.merge_unique(src.ht_);
+    }
+
     void      swap(unordered_map& other) noexcept {
         ht_.swap(other.ht_);
     }
@@ -221,6 +267,50 @@ public:
         return ht_.equal_range_unique(key);
     }
 
+    // ң hashtable::find_batchout εõÿֵ find  / Ƿ
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) {
+        return ht_.find_batch(first, last, out);
+    }
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const {
+        return ht_.find_batch(first, last, out);
+    }
+    template <class ForwardIter, class OutputIter>
+    OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const {
+        return ht_.contains_batch(first, last, out);
+    }
+
+    // 칹ң hasher  key_equal  is_transparent ʱ
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    size_type      count(const K& key) const {
+        return ht_.count(key);
+    }
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    iterator       find(const K& key) {
+        return ht_.find(key);
+    }
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    const_iterator find(const K& key)  const {
+        return ht_.find(key);
+    }
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<iterator, iterator> equal_range(const K& key) {
+        return ht_.equal_range_unique(key);
+    }
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<const_iterator, const_iterator> equal_range(const K& key) const {
+        return ht_.equal_range_unique(key);
+    }
+
 // bucket interface
 
     local_iterator       begin(size_type n)        noexcept {
@@ -267,6 +357,10 @@ public:
     void      rehash(size_type count) { ht_.rehash(count); }
     void      reserve(size_type count) { ht_.reserve(count); }
 
+    // ʽ rehashʱԪǨƷ̯֮Ĳ
+    bool      incremental_rehash()     const noexcept { return ht_.incremental_rehash(); }
+    void      incremental_rehash(bool on) { ht_.incremental_rehash(on); }
+
     hasher    hash_fcn()               const { return ht_.hash_fcn(); }
     key_equal key_eq()                 const { return ht_.key_eq(); }
 
@@ -311,6 +405,10 @@ private:
     typedef hashtable<pair<const Key, T>, Hash, KeyEqual> base_type;
     base_type ht_;
 
+    // merge Ҫͬĵײ hashtable
+    template <class, class, class, class> friend class unordered_map;
+    template <class, class, class, class> friend class unordered_multimap;
+
 public:
   // ʹ hashtable ͱ
     typedef typename base_type::allocator_type       allocator_type;
@@ -332,6 +430,8 @@ public:
     typedef typename base_type::local_iterator       local_iterator;
     typedef typename base_type::const_local_iterator const_local_iterator;
 
+    typedef typename base_type::node_handle_type     node_type;
+
     allocator_type get_allocator() const { return ht_.get_allocator(); }
 
 public:
@@ -451,6 +551,14 @@ public:
         ht_.insert_multi(first, last);
     }
 
+    // ڵеĽڵ㣬ڵ
+    iterator insert(node_type&& nh) {
+        return ht_.insert_multi(MoperSTL::move(nh));
+    }
+    iterator insert(const_iterator hint, node_type&& nh) {
+        return ht_.insert_multi_use_hint(hint, MoperSTL::move(nh));
+    }
+
 // erase / clear
 
     void      erase(iterator it) {
@@ -468,6 +576,32 @@ public:
         ht_.clear();
     }
 
+    // ժԪڵĽڵ㽻ڵͷŽڵ
+    node_type extract(const_iterator position) {
+        return ht_.extract(position);
+    }
+    node_type extract(const key_type& key) {
+        return ht_.extract(key);
+    }
+
+    //  src Ľڵ뱾Ԫءڵ
+    template <class H2, class E2>
+    void merge(unordered_map<Key, T, H2, E2>& src) {
+        ht_.merge_multi(src.ht_);
+    }
+    template <class H2, class E2>
+    void merge(unordered_map<Key, T, H2, E2>&& src) {
+        ht_.merge_multi(src.ht_);
+    }
+    template <class H2, class E2>
+    void merge(unordered_multimap<Key, T, H2, E2>& src) {
+        ht_.merge_multi(src.ht_);
+    }
+    template <class H2, class E2>
+    void merge(unordered_multimap<Key, T, H2, E2>&& src) {
+        ht_.merge_multi(src.ht_);
+    }
+
     void      swap(unordered_multimap& other) noexcept {
         ht_.swap(other.ht_);
     }
@@ -492,6 +626,50 @@ public:
         return ht_.equal_range_multi(key);
     }
 
+    // ң hashtable::find_batchout εõÿֵ find  / Ƿ
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) {
+        return ht_.find_batch(first, last, out);
+    }
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const {
+        return ht_.find_batch(first, last, out);
+    }
+    template <class ForwardIter, class OutputIter>
+    OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const {
+        return ht_.contains_batch(first, last, out);
+    }
+
+    // 칹ң hasher  key_equal  is_transparent ʱ
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    size_type      count(const K& key) const {
+        return ht_.count(key);
+    }
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    iterator       find(const K& key) {
+        return ht_.find(key);
+    }
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    const_iterator find(const K& key)  const {
+        return ht_.find(key);
+    }
+
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<iterator, iterator> equal_range(const K& key) {
+        return ht_.equal_range_multi(key);
+    }
+    template <class K, class H = hasher, class E = key_equal, typename std::enable_if<
+        MoperSTL::is_transparent<H>::value && MoperSTL::is_transparent<E>::value, int>::type = 0>
+    pair<const_iterator, const_iterator> equal_range(const K& key) const {
+        return ht_.equal_range_multi(key);
+    }
+
 // bucket interface
 
     local_iterator       begin(size_type n)        noexcept {
@@ -538,6 +716,10 @@ public:
     void      rehash(size_type count) { ht_.rehash(count); }
     void      reserve(size_type count) { ht_.reserve(count); }
 
+    // ʽ rehashʱԪǨƷ̯֮Ĳ
+    bool      incremental_rehash()     const noexcept { return ht_.incremental_rehash(); }
+    void      incremental_rehash(bool on) { ht_.incremental_rehash(on); }
+
     hasher    hash_fcn()               const { return ht_.hash_fcn(); }
     key_equal key_eq()                 const { return ht_.key_eq(); }
 
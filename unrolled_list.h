@@ -0,0 +1,859 @@
+#ifndef MOPER_STL_UNROLLED_LIST_H
+#define MOPER_STL_UNROLLED_LIST_H
+
+// չÿڵ K Ԫأڵ֮˫
+// ʱÿ K Ԫزתһνڵ㣬˳ɨĻԶ list
+// ʱڵ԰ѣɾڽڵϼƲ K һʱϲ
+// ע⣺ɾƶͬһڵ㣨Լѡϲڽڵ㣩ڵԪأָЩԪصĵʧЧ
+
+#include <initializer_list>
+#include "iterator.h"
+#include "memory.h"
+#include "exceptdef.h"
+#include "algorithm.h"
+#include "functional.h"
+
+namespace MoperSTL {
+
+// ȱʡÿڵԪռֽ
+#ifndef UNROLLED_LIST_NODE_BYTES
+#define UNROLLED_LIST_NODE_BYTES 256
+#endif
+
+// ȱʡĽڵUNROLLED_LIST_NODE_BYTES / sizeof(T)Ϊ 8
+template <class T>
+struct unrolled_list_default_capacity {
+    static constexpr std::size_t value =
+        sizeof(T) * 8 >= UNROLLED_LIST_NODE_BYTES ? 8 : UNROLLED_LIST_NODE_BYTES / sizeof(T);
+};
+
+template <class T, std::size_t K> struct unrolled_list_node;
+
+// unrolled_list Ľڵṹ
+
+template <class T, std::size_t K>
+struct unrolled_list_node_base {
+    typedef unrolled_list_node_base<T, K>* base_ptr;
+    typedef unrolled_list_node<T, K>*      node_ptr;
+
+    base_ptr prev;  // ǰһڵ
+    base_ptr next;  // һڵ
+
+    node_ptr as_node() {
+        return static_cast<node_ptr>(this);
+    }
+};
+
+template <class T, std::size_t K>
+struct unrolled_list_node : public unrolled_list_node_base<T, K> {
+    std::size_t count;                              // ڵеԪظλ [0, count) ԪЧ
+    alignas(T) unsigned char storage[sizeof(T) * K];  // ԪصĴ洢ռ
+
+    T* data() {
+        return reinterpret_cast<T*>(storage);
+    }
+};
+
+// unrolled_list ĵƣԣڵ㣬ڵ±꣩ʾλãend() Ϊͷڵ㣬0
+template <class T, std::size_t K, class Ref, class Ptr>
+struct unrolled_list_iterator : public MoperSTL::iterator<MoperSTL::bidirectional_iterator_tag, T> {
+    typedef unrolled_list_iterator<T, K, T&, T*>             iterator;
+    typedef unrolled_list_iterator<T, K, const T&, const T*> const_iterator;
+    typedef unrolled_list_iterator                           self;
+
+    typedef T                                     value_type;
+    typedef Ptr                                   pointer;
+    typedef Ref                                   reference;
+    typedef std::size_t                           size_type;
+    typedef unrolled_list_node_base<T, K>*        base_ptr;
+
+    base_ptr  node_;   // ǰڵ
+    size_type index_;  // ڵڵ±
+
+    unrolled_list_iterator() noexcept :node_(nullptr), index_(0) {}
+    unrolled_list_iterator(base_ptr x, size_type i) noexcept :node_(x), index_(i) {}
+    unrolled_list_iterator(const iterator& rhs) noexcept :node_(rhs.node_), index_(rhs.index_) {}
+
+    reference operator*()  const { return node_->as_node()->data()[index_]; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        if (++index_ == node_->as_node()->count) {
+            node_ = node_->next;
+            index_ = 0;
+        }
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        MYSTL_DEBUG(node_ != nullptr);
+        if (index_ == 0) {
+            node_ = node_->prev;
+            index_ = node_->as_node()->count;
+        }
+        --index_;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_ && index_ == rhs.index_; }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+// ģ: unrolled_list
+// ģ T ͣK ÿڵŵԪظ
+template <class T, std::size_t K = unrolled_list_default_capacity<T>::value>
+class unrolled_list {
+    static_assert(K >= 2, "unrolled_list node capacity must be at least 2");
+
+public:
+    // unrolled_list Ƕͱ
+    typedef MoperSTL::allocator<T>                         allocator_type;
+    typedef MoperSTL::allocator<T>                         data_allocator;
+    typedef MoperSTL::allocator<unrolled_list_node<T, K>>  node_allocator;
+
+    typedef typename allocator_type::value_type      value_type;
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::size_type       size_type;
+    typedef typename allocator_type::difference_type difference_type;
+
+    typedef unrolled_list_iterator<T, K, T&, T*>             iterator;
+    typedef unrolled_list_iterator<T, K, const T&, const T*> const_iterator;
+    typedef MoperSTL::reverse_iterator<iterator>             reverse_iterator;
+    typedef MoperSTL::reverse_iterator<const_iterator>       const_reverse_iterator;
+
+    typedef unrolled_list_node_base<T, K>*           base_ptr;
+    typedef unrolled_list_node<T, K>*                node_ptr;
+
+    static constexpr size_type node_capacity = K;
+
+    allocator_type get_allocator() { return allocator_type(); }
+
+private:
+    unrolled_list_node_base<T, K> header_;  // ͷڵ㣬Ԫأвڿսڵ
+    size_type                     size_;    // Ԫظ
+
+public:
+    // 졢ơƶ
+    unrolled_list() noexcept :size_(0) {
+        header_.prev = header_.next = header();
+    }
+
+    explicit unrolled_list(size_type n) :unrolled_list() {
+        fill_append(n, value_type());
+    }
+
+    unrolled_list(size_type n, const T& value) :unrolled_list() {
+        fill_append(n, value);
+    }
+
+    template <class Iter, typename std::enable_if<
+        std::is_convertible_v<
+        typename MoperSTL::iterator_traits<Iter>::iterator_category, MoperSTL::input_iterator_tag>
+        , int>::type = 0>
+    unrolled_list(Iter first, Iter last) :unrolled_list() {
+        copy_append(first, last);
+    }
+
+    unrolled_list(std::initializer_list<T> ilist) :unrolled_list() {
+        copy_append(ilist.begin(), ilist.end());
+    }
+
+    unrolled_list(const unrolled_list& rhs) :unrolled_list() {
+        copy_append(rhs.cbegin(), rhs.cend());
+    }
+
+    unrolled_list(unrolled_list&& rhs) noexcept :unrolled_list() {
+        swap(rhs);
+    }
+
+    unrolled_list& operator=(const unrolled_list& rhs) {
+        if (this != &rhs) {
+            assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    unrolled_list& operator=(unrolled_list&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    unrolled_list& operator=(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~unrolled_list() {
+        clear();
+    }
+
+public:
+    // ز
+    iterator               begin()         noexcept {
+        return iterator(header_.next, 0);
+    }
+    const_iterator         begin()   const noexcept {
+        return const_iterator(header_.next, 0);
+    }
+    iterator               end()           noexcept {
+        return iterator(header(), 0);
+    }
+    const_iterator         end()     const noexcept {
+        return const_iterator(header(), 0);
+    }
+
+    reverse_iterator       rbegin()        noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin()  const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator       rend()          noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend()    const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator         cbegin()  const noexcept {
+        return begin();
+    }
+    const_iterator         cend()    const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend()   const noexcept {
+        return rend();
+    }
+
+    // ز
+    bool      empty()    const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size()     const noexcept {
+        return size_;
+    }
+
+    size_type max_size() const noexcept {
+        return static_cast<size_type>(-1);
+    }
+
+    // Ԫز
+    reference       front() {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    reference       back() {
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+
+    const_reference back()  const {
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+
+    // ز
+
+    // assign
+
+    void     assign(size_type n, const value_type& value) {
+        clear();
+        fill_append(n, value);
+    }
+
+    template <class Iter, typename std::enable_if<
+        std::is_convertible_v<
+        typename MoperSTL::iterator_traits<Iter>::iterator_category, MoperSTL::input_iterator_tag>
+        , int>::type = 0>
+    void     assign(Iter first, Iter last) {
+        clear();
+        copy_append(first, last);
+    }
+
+    void     assign(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    // emplace_front / emplace_back / emplace
+
+    template <class ...Args>
+    void     emplace_front(Args&& ...args) {
+        emplace(cbegin(), MoperSTL::forward<Args>(args)...);
+    }
+
+    template <class ...Args>
+    void     emplace_back(Args&& ...args) {
+        emplace(cend(), MoperSTL::forward<Args>(args)...);
+    }
+
+    template <class ...Args>
+    iterator emplace(const_iterator pos, Args&& ...args);
+
+    // insert
+
+    iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, MoperSTL::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value);
+
+    template <class Iter, typename std::enable_if<
+        std::is_convertible_v<typename MoperSTL::iterator_traits<Iter>::iterator_category, MoperSTL::input_iterator_tag>
+        , int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last);
+
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    // push_front / push_back
+
+    void     push_front(const value_type& value) {
+        emplace(cbegin(), value);
+    }
+
+    void     push_front(value_type&& value) {
+        emplace(cbegin(), MoperSTL::move(value));
+    }
+
+    void     push_back(const value_type& value) {
+        emplace(cend(), value);
+    }
+
+    void     push_back(value_type&& value) {
+        emplace(cend(), MoperSTL::move(value));
+    }
+
+    // pop_front / pop_back
+
+    void     pop_front() {
+        MYSTL_DEBUG(!empty());
+        erase(cbegin());
+    }
+
+    void     pop_back();
+
+    // erase / clear
+
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos != cend());
+        auto next = pos;
+        return erase(pos, ++next);
+    }
+    iterator erase(const_iterator first, const_iterator last);
+
+    void     clear() noexcept;
+
+    // resize
+
+    void     resize(size_type new_size) { resize(new_size, value_type()); }
+    void     resize(size_type new_size, const value_type& value);
+
+    void     swap(unrolled_list& rhs) noexcept;
+
+    // unrolled_list ز
+
+    void remove(const value_type& value) {
+        remove_if([&](const value_type& v) {return v == value; });
+    }
+    template <class UnaryPredicate>
+    void remove_if(UnaryPredicate pred);
+
+    void unique() {
+        unique(MoperSTL::equal_to<T>());
+    }
+    template <class BinaryPredicate>
+    void unique(BinaryPredicate pred);
+
+    void reverse();
+
+private:
+    // helper functions
+
+    base_ptr header() const noexcept {
+        return const_cast<base_ptr>(&header_);
+    }
+
+    // create / destroy node
+    node_ptr create_node_after(base_ptr pos);
+    void     destroy_node(base_ptr p) noexcept;
+
+    // split / merge
+    void     split_node(base_ptr p, size_type idx);
+    bool     try_merge(base_ptr p);
+    iterator balance(base_ptr p, size_type idx);
+
+    // insert
+    template <class ...Args>
+    void     construct_in_node(node_ptr node, size_type idx, Args&& ...args);
+    base_ptr prepare_bulk_insert(const_iterator pos);
+    void     fill_append(size_type n, const value_type& value);
+    template <class Iter>
+    void     copy_append(Iter first, Iter last);
+
+    // locate
+    iterator locate(size_type n) noexcept;
+};
+
+/*****************************************************************************************/
+
+//  pos ͵عԪ
+// pos ڽڵʱpos λڽڵײķǰһڵ½ڵ㣬򽫽ڵ԰
+template <class T, std::size_t K>
+template <class ...Args>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::emplace(const_iterator pos, Args&& ...args) {
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "unrolled_list<T>'s size too big");
+    base_ptr p = pos.node_;
+    size_type idx = pos.index_;
+    if (p == header()) {
+        p = header_.prev;
+        if (p != header() && p->as_node()->count < K) {
+            idx = p->as_node()->count;
+        } else {
+            p = create_node_after(p);
+            idx = 0;
+        }
+    } else if (p->as_node()->count == K) {
+        if (idx == 0) {
+            auto prev = p->prev;
+            if (prev != header() && prev->as_node()->count < K) {
+                p = prev;
+                idx = p->as_node()->count;
+            } else {
+                p = create_node_after(prev);
+            }
+        } else {
+            // ñڵнߵԪأȹʱٷ
+            value_type tmp(MoperSTL::forward<Args>(args)...);
+            split_node(p, K / 2);
+            if (idx > K / 2) {
+                p = p->next;
+                idx -= K / 2;
+            }
+            construct_in_node(p->as_node(), idx, MoperSTL::move(tmp));
+            return iterator(p, idx);
+        }
+    }
+    try {
+        construct_in_node(p->as_node(), idx, MoperSTL::forward<Args>(args)...);
+    } catch (...) {
+        if (p->as_node()->count == 0)
+            destroy_node(p);
+        throw;
+    }
+    return iterator(p, idx);
+}
+
+//  pos  n Ԫ
+template <class T, std::size_t K>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::insert(const_iterator pos, size_type n, const value_type& value) {
+    if (n == 0)
+        return iterator(pos.node_, pos.index_);
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "unrolled_list<T>'s size too big");
+    const value_type copy(value);  // value  pos ڽڵнߵԪ
+    auto p = prepare_bulk_insert(pos);
+    base_ptr first_node = nullptr;
+    size_type first_index = 0;
+    try {
+        for (; n > 0; --n) {
+            if (p == header() || p->as_node()->count == K)
+                p = create_node_after(p);
+            auto node = p->as_node();
+            data_allocator().construct(node->data() + node->count, copy);
+            if (first_node == nullptr) {
+                first_node = p;
+                first_index = node->count;
+            }
+            ++node->count;
+            ++size_;
+        }
+    } catch (...) {
+        if (p != header() && p->as_node()->count == 0)
+            destroy_node(p);
+        throw;
+    }
+    try_merge(p);
+    return iterator(first_node, first_index);
+}
+
+//  pos  [first, last) Ԫ
+template <class T, std::size_t K>
+template <class Iter, typename std::enable_if<
+    std::is_convertible_v<typename MoperSTL::iterator_traits<Iter>::iterator_category, MoperSTL::input_iterator_tag>
+    , int>::type>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::insert(const_iterator pos, Iter first, Iter last) {
+    if (first == last)
+        return iterator(pos.node_, pos.index_);
+    auto p = prepare_bulk_insert(pos);
+    base_ptr first_node = nullptr;
+    size_type first_index = 0;
+    try {
+        for (; first != last; ++first) {
+            if (p == header() || p->as_node()->count == K)
+                p = create_node_after(p);
+            auto node = p->as_node();
+            data_allocator().construct(node->data() + node->count, *first);
+            if (first_node == nullptr) {
+                first_node = p;
+                first_index = node->count;
+            }
+            ++node->count;
+            ++size_;
+        }
+    } catch (...) {
+        if (p != header() && p->as_node()->count == 0)
+            destroy_node(p);
+        throw;
+    }
+    try_merge(p);
+    return iterator(first_node, first_index);
+}
+
+// ɾβԪأڵϲ
+template <class T, std::size_t K>
+void unrolled_list<T, K>::pop_back() {
+    MYSTL_DEBUG(!empty());
+    auto p = header_.prev;
+    auto node = p->as_node();
+    data_allocator().destroy(node->data() + --node->count);
+    --size_;
+    if (node->count == 0)
+        destroy_node(p);
+}
+
+// ɾ [first, last) ڵԪأÿڵֻƶһʣԪ
+template <class T, std::size_t K>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::erase(const_iterator first, const_iterator last) {
+    if (first == last)
+        return iterator(last.node_, last.index_);
+    size_type n = MoperSTL::distance(first, last);
+    base_ptr p = first.node_;
+    size_type idx = first.index_;
+    size_ -= n;
+    while (n > 0) {
+        auto node = p->as_node();
+        auto d = node->data();
+        const size_type k = MoperSTL::min(n, node->count - idx);
+        MoperSTL::move(d + idx + k, d + node->count, d + idx);
+        MoperSTL::destory(d + node->count - k, d + node->count);
+        node->count -= k;
+        n -= k;
+        if (node->count == 0) {
+            auto next = p->next;
+            destroy_node(p);
+            p = next;
+            idx = 0;
+        } else if (idx == node->count) {
+            p = p->next;
+            idx = 0;
+        }
+    }
+    return balance(p, idx);
+}
+
+//  unrolled_list
+template <class T, std::size_t K>
+void unrolled_list<T, K>::clear() noexcept {
+    auto p = header_.next;
+    while (p != header()) {
+        auto next = p->next;
+        auto node = p->as_node();
+        MoperSTL::destory(node->data(), node->data() + node->count);
+        node_allocator().deallocate(node, 1);
+        p = next;
+    }
+    header_.prev = header_.next = header();
+    size_ = 0;
+}
+
+// С
+template <class T, std::size_t K>
+void unrolled_list<T, K>::resize(size_type new_size, const value_type& value) {
+    if (new_size < size_) {
+        erase(locate(new_size), end());
+    } else {
+        fill_append(new_size - size_, value);
+    }
+}
+
+// ͷڵǶβڵָͷڵָ
+template <class T, std::size_t K>
+void unrolled_list<T, K>::swap(unrolled_list& rhs) noexcept {
+    MoperSTL::swap(header_.prev, rhs.header_.prev);
+    MoperSTL::swap(header_.next, rhs.header_.next);
+    MoperSTL::swap(size_, rhs.size_);
+    for (auto l : { this, &rhs }) {
+        if (l->size_ == 0) {
+            l->header_.prev = l->header_.next = l->header();
+        } else {
+            l->header_.next->prev = l->header();
+            l->header_.prev->next = l->header();
+        }
+    }
+}
+
+// һԪ pred Ϊ true ԪƳԪǰƣһɾβ
+template <class T, std::size_t K>
+template <class UnaryPredicate>
+void unrolled_list<T, K>::remove_if(UnaryPredicate pred) {
+    auto w = begin();
+    auto e = end();
+    for (; w != e && !pred(*w); ++w)
+        ;
+    if (w == e)
+        return;
+    auto r = w;
+    for (++r; r != e; ++r) {
+        if (!pred(*r)) {
+            *w = MoperSTL::move(*r);
+            ++w;
+        }
+    }
+    erase(w, e);
+}
+
+// Ƴ unrolled_list  pred Ϊ true ظԪ
+template <class T, std::size_t K>
+template <class BinaryPredicate>
+void unrolled_list<T, K>::unique(BinaryPredicate pred) {
+    auto w = begin();
+    auto e = end();
+    if (w == e)
+        return;
+    auto r = w;
+    for (++r; r != e; ++r) {
+        if (!pred(*w, *r)) {
+            ++w;
+            if (w != r)
+                *w = MoperSTL::move(*r);
+        }
+    }
+    erase(++w, e);
+}
+
+//  unrolled_list תڵṹ䣬ֻԪ
+template <class T, std::size_t K>
+void unrolled_list<T, K>::reverse() {
+    if (size_ <= 1)
+        return;
+    auto f = begin();
+    auto l = end();
+    for (size_type n = size_ / 2; n > 0; --n) {
+        --l;
+        MoperSTL::swap(*f, *l);
+        ++f;
+    }
+}
+
+/*****************************************************************************************/
+// helper function
+
+//  pos ֮󴴽һսڵ
+template <class T, std::size_t K>
+typename unrolled_list<T, K>::node_ptr
+unrolled_list<T, K>::create_node_after(base_ptr pos) {
+    node_ptr node = node_allocator().allocate(1);
+    node->count = 0;
+    base_ptr p = node;
+    p->prev = pos;
+    p->next = pos->next;
+    pos->next->prev = p;
+    pos->next = p;
+    return node;
+}
+
+// ϿͷһԪصĽڵ
+template <class T, std::size_t K>
+void unrolled_list<T, K>::destroy_node(base_ptr p) noexcept {
+    MYSTL_DEBUG(p->as_node()->count == 0);
+    p->prev->next = p->next;
+    p->next->prev = p->prev;
+    node_allocator().deallocate(p->as_node(), 1);
+}
+
+//  p ڵ±겻С idx Ԫ½Ľڵ
+template <class T, std::size_t K>
+void unrolled_list<T, K>::split_node(base_ptr p, size_type idx) {
+    auto node = p->as_node();
+    auto q = create_node_after(p);
+    try {
+        MoperSTL::uninitialized_move(node->data() + idx, node->data() + node->count, q->data());
+    } catch (...) {
+        destroy_node(q);
+        throw;
+    }
+    MoperSTL::destory(node->data() + idx, node->data() + node->count);
+    q->count = node->count - idx;
+    node->count = idx;
+}
+
+//  p һڵԪغϼƲ K֮һѺһڵ㲢 p
+template <class T, std::size_t K>
+bool unrolled_list<T, K>::try_merge(base_ptr p) {
+    if (p == header() || p->next == header())
+        return false;
+    auto a = p->as_node();
+    auto b = p->next->as_node();
+    if (a->count + b->count > K || (a->count >= K / 2 && b->count >= K / 2))
+        return false;
+    MoperSTL::uninitialized_move(b->data(), b->data() + b->count, a->data() + a->count);
+    MoperSTL::destory(b->data(), b->data() + b->count);
+    a->count += b->count;
+    b->count = 0;
+    destroy_node(b);
+    return true;
+}
+
+// ɾ֮λãp, idxϲڵ㣬غϲλöӦĵ
+template <class T, std::size_t K>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::balance(base_ptr p, size_type idx) {
+    if (p == header()) {
+        try_merge(header_.prev->prev);
+        return end();
+    }
+    auto prev = p->prev;
+    if (prev != header()) {
+        const auto c = prev->as_node()->count;
+        if (try_merge(prev)) {
+            p = prev;
+            idx += c;
+        }
+    }
+    try_merge(p);
+    return iterator(p, idx);
+}
+
+// ڽڵ idx Ԫأڵпλ
+template <class T, std::size_t K>
+template <class ...Args>
+void unrolled_list<T, K>::construct_in_node(node_ptr node, size_type idx, Args&& ...args) {
+    auto d = node->data();
+    const auto c = node->count;
+    if (idx == c) {
+        data_allocator().construct(d + c, MoperSTL::forward<Args>(args)...);
+    } else {
+        // ȹʱ󣬱õƶԪ
+        value_type tmp(MoperSTL::forward<Args>(args)...);
+        data_allocator().construct(d + c, MoperSTL::move(d[c - 1]));
+        MoperSTL::move_backward(d + idx, d + c - 1, d + c);
+        d[idx] = MoperSTL::move(tmp);
+    }
+    ++node->count;
+    ++size_;
+}
+
+// Ϊ pos Ԫ׼Ҫʱ pos ѽڵ㣬
+// һڵ㣬ԪӦ׷ڸýڵβΪͷڵ㣬ʱ½ڵ㣩
+template <class T, std::size_t K>
+typename unrolled_list<T, K>::base_ptr
+unrolled_list<T, K>::prepare_bulk_insert(const_iterator pos) {
+    if (pos.node_ == header())
+        return header_.prev;
+    if (pos.index_ == 0)
+        return pos.node_->prev;
+    split_node(pos.node_, pos.index_);
+    return pos.node_;
+}
+
+// β׷ n Ԫأڵ
+template <class T, std::size_t K>
+void unrolled_list<T, K>::fill_append(size_type n, const value_type& value) {
+    insert(cend(), n, value);
+}
+
+// β׷ [first, last) Ԫ
+template <class T, std::size_t K>
+template <class Iter>
+void unrolled_list<T, K>::copy_append(Iter first, Iter last) {
+    insert(cend(), first, last);
+}
+
+// ص n ԪصλãڵԾ
+template <class T, std::size_t K>
+typename unrolled_list<T, K>::iterator
+unrolled_list<T, K>::locate(size_type n) noexcept {
+    if (n >= size_)
+        return end();
+    auto p = header_.next;
+    while (n >= p->as_node()->count) {
+        n -= p->as_node()->count;
+        p = p->next;
+    }
+    return iterator(p, n);
+}
+
+// رȽϲ
+template <class T, std::size_t K>
+bool operator==(const unrolled_list<T, K>& lhs, const unrolled_list<T, K>& rhs) {
+    return lhs.size() == rhs.size() && MoperSTL::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template <class T, std::size_t K>
+bool operator<(const unrolled_list<T, K>& lhs, const unrolled_list<T, K>& rhs) {
+    return MoperSTL::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <class T, std::size_t K>
+bool operator!=(const unrolled_list<T, K>& lhs, const unrolled_list<T, K>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, std::size_t K>
+bool operator>(const unrolled_list<T, K>& lhs, const unrolled_list<T, K>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, std::size_t K>
+bool operator<=(const unrolled_list<T, K>& lhs, const unrolled_list<T, K>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, std::size_t K>
+bool operator>=(const unrolled_list<T, K>& lhs, const unrolled_list<T, K>& rhs) {
+    return !(lhs < rhs);
+}
+
+//  MoperSTL  swap
+template <class T, std::size_t K>
+void swap(unrolled_list<T, K>& lhs, unrolled_list<T, K>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}; /* MoperSTL */
+
+#endif /* MOPER_STL_UNROLLED_LIST_H */
@@ -168,6 +168,12 @@ private:
 	iterator __cap;    // ʾĿǰռβ
 	Allocator __allocator;
 private: // ڲ
+	// ʱ new_size Ԫأ 1.5 
+	size_type __recommend(size_type new_size) const {
+		const size_type cap = capacity();
+		return MoperSTL::max(new_size, cap + cap / 2);
+	}
+
 	template<class InputIterator>
 	void __assign(InputIterator first, InputIterator last, MoperSTL::input_iterator_tag) {
 		iterator cur = __begin;
@@ -208,7 +214,7 @@ public: // 
 	vector(size_type count, const T& value, const Allocator& alloc = Allocator()) 
 		: __begin(nullptr), __end(nullptr), __cap(nullptr), __allocator(alloc) 
 	{
-		__begin = __allocator.allocate(count * sizeof(T));
+		__begin = __allocator.allocate(count);
 		MoperSTL::uninitialized_fill_n(__begin, count, value);
 		__end = __begin + count;
 		__cap = __end;
@@ -217,7 +223,7 @@ public: // 
 	explicit vector(size_type count, const Allocator& alloc = Allocator())
 		: __begin(nullptr), __end(nullptr), __cap(nullptr), __allocator(alloc) 
 	{
-		__begin = __allocator.allocate(count * sizeof(T));
+		__begin = __allocator.allocate(count);
 		__end = MoperSTL::uninitialized_value_construct_n(__begin, count);
 		__cap = __end;
 	}
@@ -231,7 +237,7 @@ public: // 
 		: __begin(nullptr), __end(nullptr), __cap(nullptr), __allocator(alloc) 
 	{
 		const size_type count = static_cast<size_type>(MoperSTL::distance(first, last));
-		__begin = __allocator.allocate(count * sizeof(T));
+		__begin = __allocator.allocate(count);
 		__end = MoperSTL::uninitialized_copy(first, last, __begin);
 		__cap = __end;
 	}
@@ -278,7 +284,7 @@ public: // 
 		: __begin(nullptr), __end(nullptr), __cap(nullptr), __allocator(alloc)
 	{
 		const size_type count = init.size();
-		__begin = __allocator.allocate(count * sizeof(T));
+		__begin = __allocator.allocate(count);
 		__end = MoperSTL::uninitialized_copy(init.begin(), init.end(), __begin);
 		__cap = __end;
 	}
@@ -351,6 +357,7 @@ public: // 
 			const auto old_size = size();
 			pointer __new_begin = __allocator.allocate(new_cap);
 			MoperSTL::uninitialized_move(__begin, __end, __new_begin);
+			MoperSTL::destory(__begin, __end);
 			__allocator.deallocate(__begin, capacity());
 			__begin = __new_begin;
 			__end = __new_begin + old_size;
@@ -363,6 +370,7 @@ public: // 
 			const auto __size = size();
 			pointer __new_begin = __allocator.allocate(__size);
 			MoperSTL::uninitialized_move(__begin, __end, __new_begin);
+			MoperSTL::destory(__begin, __end);
 			__allocator.deallocate(__begin, capacity());
 			__begin = __new_begin;
 			__end = __new_begin + __size;
@@ -399,11 +407,11 @@ public: // Ԫ
 	}
 	reference back() {
 		MYSTL_DEBUG(!empty());
-		return *(__begin + __end - 1);
+		return *(__end - 1);
 	}
 	const_reference back() const {
 		MYSTL_DEBUG(!empty());
-		return *(__begin + __end - 1);
+		return *(__end - 1);
 	}
 	T* data() noexcept {
 		return __begin;
@@ -425,12 +433,19 @@ public: // 
 	iterator emplace(const_iterator pos, Args&&... args) {
 		MYSTL_DEBUG(pos >= cbegin() && pos <= cend());
 
-		iterator __first = begin() + (pos - cbegin());
-		if (__cap == __end) reserve(1.5 * capacity());
-
-		MoperSTL::uninitialized_move_backward(__first, __end, __end + 1);
-		__allocator.construct(MoperSTL::addressof(*__first), MoperSTL::forward<Args>(args)...);
-		++end;
+		const size_type n = static_cast<size_type>(pos - cbegin());
+		if (__cap == __end) reserve(__recommend(size() + 1));
+
+		iterator __first = __begin + n;
+		if (__first == __end) {
+			__allocator.construct(MoperSTL::addressof(*__end), MoperSTL::forward<Args>(args)...);
+		} else { // ȹԪأٰĩβԪδʼλãԪκ
+			value_type tmp(MoperSTL::forward<Args>(args)...);
+			__allocator.construct(MoperSTL::addressof(*__end), MoperSTL::move(*(__end - 1)));
+			MoperSTL::move_backward(__first, __end - 1, __end);
+			*__first = MoperSTL::move(tmp);
+		}
+		++__end;
 		return __first;
 	} 
 
@@ -446,7 +461,7 @@ public: // 
 	}
 
 	iterator erase(const_iterator pos) {
-		erase(pos, pos + 1);
+		return erase(pos, pos + 1);
 	}
 
 	void clear() noexcept {
@@ -480,14 +495,16 @@ public: // 
 
 	iterator insert(const_iterator pos, size_type count, const T& value) {
 		MYSTL_DEBUG(pos >= cbegin() && pos <= cend());
-		iterator __first = begin() + (pos - cbegin());
-		if (count == 0) return __first;
-		if (count > __cap - __end) reserve(count + size());
+		const size_type n = static_cast<size_type>(pos - cbegin());
+		if (count == 0) return __begin + n;
+		if (count > static_cast<size_type>(__cap - __end)) reserve(__recommend(size() + count));
 
-		MoperSTL::uninitialized_move_backward(__first, __end, __end + count);
-		MoperSTL::uninitialized_fill_n(__first, count, value);
+		// Ԫعĩβת pos ѹĶظ
+		iterator __old_end = __end;
+		MoperSTL::uninitialized_fill_n(__end, count, value);
 		__end += count;
-		return __first;
+		MoperSTL::rotate(__begin + n, __old_end, __end);
+		return __begin + n;
 	}
 
 	iterator insert(const_iterator pos, const T& value) {
@@ -501,30 +518,30 @@ public: // 
 	template< class InputIt >
 	iterator insert(const_iterator pos, InputIt first, InputIt last) {
 		MYSTL_DEBUG(pos >= cbegin() && pos <= cend() && first <= last);
-		iterator __first = begin() + (pos - cbegin());
-		if (first == last) return __first;
+		const size_type n = static_cast<size_type>(pos - cbegin());
+		if (first == last) return __begin + n;
 		const size_type count = static_cast<size_type>(MoperSTL::distance(first, last));
-		if (count > __cap - __end) reserve(count + size());
+		if (count > static_cast<size_type>(__cap - __end)) reserve(__recommend(size() + count));
 
-		MoperSTL::uninitialized_move_backward(__first, __end, __end + count);
-		MoperSTL::uninitialized_copy(first, last, __first);
-		__end += count;
-		return __first;
+		iterator __old_end = __end;
+		__end = MoperSTL::uninitialized_copy(first, last, __end);
+		MoperSTL::rotate(__begin + n, __old_end, __end);
+		return __begin + n;
 	}
 
 	iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
-		insert(pos, ilist.begin(), ilist.end());
+		return insert(pos, ilist.begin(), ilist.end());
 	}
 
 	template< class... Args >
 	void emplace_back(Args&&... args) {
-		if (__end == __cap) reserve(1.5 * capacity());
+		if (__end == __cap) reserve(__recommend(size() + 1));
 		__allocator.construct(MoperSTL::addressof(*__end), MoperSTL::forward<Args>(args)...);
 		++__end;
 	}
 
 	void push_back(const T& value) {
-		if (__end == __cap) reserve(1.5 * capacity());
+		if (__end == __cap) reserve(__recommend(size() + 1));
 		
 		__allocator.construct(MoperSTL::addressof(*__end), value);
 		++__end;
@@ -536,8 +553,8 @@ public: // 
 
 	void pop_back() {
 		MYSTL_DEBUG(!empty());
-		__end;
-		__allocator.destory(__end);
+		--__end;
+		MoperSTL::destory_at(__end);
 	}
 
 	void resize(size_type count, const value_type& value) {